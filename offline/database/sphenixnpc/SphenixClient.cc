@@ -5,9 +5,76 @@
 
 #include <nlohmann/json.hpp>
 
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
 #include <fstream>
 #include <iostream>
 #include <stdexcept>
+#include <system_error>
+
+namespace
+{
+  //! exclusive lock on a file, held until destruction (no lock if the file cannot be opened)
+  class CacheLock
+  {
+   public:
+    explicit CacheLock(const std::string& lockfile)
+      : m_fd(open(lockfile.c_str(), O_CREAT | O_RDWR, 0664))
+    {
+      if (m_fd >= 0)
+      {
+        flock(m_fd, LOCK_EX);
+      }
+    }
+    ~CacheLock()
+    {
+      if (m_fd >= 0)
+      {
+        flock(m_fd, LOCK_UN);
+        close(m_fd);
+      }
+    }
+    CacheLock(const CacheLock&) = delete;
+    CacheLock& operator=(const CacheLock&) = delete;
+
+   private:
+    int m_fd{-1};
+  };
+
+  bool readCacheFile(const std::filesystem::path& file, nlohmann::json& payload_iovs)
+  {
+    std::ifstream cachefile(file);
+    if (!cachefile.is_open())
+    {
+      return false;
+    }
+    payload_iovs = nlohmann::json::parse(cachefile, nullptr, false);
+    return !payload_iovs.is_discarded();
+  }
+
+  //! written to a temporary file and renamed, readers never see a partial file
+  void writeCacheFile(const std::filesystem::path& file, const nlohmann::json& payload_iovs)
+  {
+    std::filesystem::path tmpfile = file;
+    tmpfile += "." + std::to_string(getpid()) + ".tmp";
+    {
+      std::ofstream cachefile(tmpfile);
+      if (!cachefile.is_open())
+      {
+        return;
+      }
+      cachefile << payload_iovs;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpfile, file, ec);
+    if (ec)
+    {
+      std::filesystem::remove(tmpfile, ec);
+    }
+  }
+}  // namespace
 
 SphenixClient::SphenixClient(const std::string& gt_name)
   : nopayloadclient::NoPayloadClient(gt_name)
@@ -17,7 +84,89 @@ SphenixClient::SphenixClient(const std::string& gt_name)
 
 nlohmann::json SphenixClient::getPayloadIOVs(long long iov)
 {
-  return nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
+  if (m_CacheIOVs)
+  {
+    auto iter = m_PayloadIOVCache.find(iov);
+    if (iter != m_PayloadIOVCache.end())
+    {
+      return {{"code", 0}, {"msg", iter->second}};
+    }
+  }
+  nlohmann::json resp;
+  if (!m_CacheDirectory.empty() && !m_CachedGlobalTag.empty())
+  {
+    resp = getCachedPayloadIOVs(iov);
+  }
+  else if (m_OfflineMode)
+  {
+    return nopayloadclient::DataBaseException("offline mode needs a cache directory and a global tag").jsonify();
+  }
+  else
+  {
+    resp = nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
+  }
+  if (m_CacheIOVs && resp["code"] == 0)
+  {
+    m_PayloadIOVCache[iov] = resp["msg"];
+  }
+  return resp;
+}
+
+void SphenixClient::CacheIOVs(bool b)
+{
+  m_CacheIOVs = b;
+  m_PayloadIOVCache.clear();
+}
+
+void SphenixClient::CacheDirectory(const std::string& dir)
+{
+  m_CacheDirectory = dir;
+  m_PayloadIOVCache.clear();
+}
+
+std::filesystem::path SphenixClient::cacheFile(long long iov) const
+{
+  std::string gt_dir = m_CachedGlobalTag;
+  for (auto& c : gt_dir)
+  {
+    if (c == '/')
+    {
+      c = '_';
+    }
+  }
+  return std::filesystem::path(m_CacheDirectory) / gt_dir / (std::to_string(iov) + ".json");
+}
+
+nlohmann::json SphenixClient::getCachedPayloadIOVs(long long iov)
+{
+  std::filesystem::path file = cacheFile(iov);
+  nlohmann::json payload_iovs;
+  if (readCacheFile(file, payload_iovs))
+  {
+    return {{"code", 0}, {"msg", payload_iovs}};
+  }
+  if (m_OfflineMode)
+  {
+    return nopayloadclient::DataBaseException("no cached payloads for global tag " + m_CachedGlobalTag + ", iov " + std::to_string(iov) + " in " + m_CacheDirectory).jsonify();
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(file.parent_path(), ec);
+  // only one job asks the database, the others wait and read its result
+  CacheLock lock(file.string() + ".lock");
+  if (readCacheFile(file, payload_iovs))
+  {
+    return {{"code", 0}, {"msg", payload_iovs}};
+  }
+  nlohmann::json resp = nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
+  if (resp["code"] == 0)
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << "SphenixClient: caching payloads for iov " << iov << " in " << file << std::endl;
+    }
+    writeCacheFile(file, resp["msg"]);
+  }
+  return resp;
 }
 
 nlohmann::json SphenixClient::getUrl(const std::string& pl_type, long long iov)
@@ -124,11 +273,13 @@ void SphenixClient::DumpCalibrations(long long iov, const std::string& filename)
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start, long long iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start, 0, iov_end);
 }
 
@@ -169,12 +320,14 @@ nlohmann::json SphenixClient::lockGlobalTag(const std::string& gt_name)
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start, long long iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start, 0, iov_end);
 }
 
@@ -182,6 +335,7 @@ nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const st
                                             long long major_iov_start, long long minor_iov_start,
                                             long long major_iov_end, long long minor_iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, major_iov_start, minor_iov_start, major_iov_end, minor_iov_end);
 }
 
@@ -196,6 +350,7 @@ nlohmann::json SphenixClient::setGlobalTag(const std::string& gt_name)
   if (existGlobalTag(gt_name))
   {
     m_CachedGlobalTag = gt_name;
+    m_PayloadIOVCache.clear();
     return nopayloadclient::NoPayloadClient::setGlobalTag(gt_name);
   }
 
@@ -211,6 +366,7 @@ int SphenixClient::cache_set_GlobalTag(const std::string& tagname)
     return iret;
   }
   m_CachedGlobalTag = tagname;
+  m_PayloadIOVCache.clear();
   nopayloadclient::NoPayloadClient::setGlobalTag(tagname);
   bool found_gt = false;
   nlohmann::json resp = nopayloadclient::NoPayloadClient::getGlobalTags();
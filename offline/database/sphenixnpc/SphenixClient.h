@@ -5,6 +5,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <filesystem>
+#include <map>
 #include <set>
 #include <string>
 
@@ -43,11 +45,30 @@ class SphenixClient : public nopayloadclient::NoPayloadClient
   int Verbosity() const { return m_Verbosity; }
   void DumpCalibrations(long long iov, const std::string& filename);
 
+  //! keep the payload IOVs of the global tag per iov in memory, the database is asked once per iov
+  /*! for reading jobs, the cache is cleared when payloads are inserted or deleted through this client */
+  void CacheIOVs(bool b = true);
+
+  //! read through cache of the payload IOVs on disk, shared by all jobs using the same directory
+  /*! one file per global tag and iov, only one job asks the database while the others wait for
+   *  its result. Meant for locked global tags, the files are never updated */
+  void CacheDirectory(const std::string& dir);
+
+  //! serve the payload IOVs from the cache directory only, without database access
+  void OfflineMode(bool b = true) { m_OfflineMode = b; }
+
  private:
+  nlohmann::json getCachedPayloadIOVs(long long iov);
+  std::filesystem::path cacheFile(long long iov) const;
+
   int m_Verbosity{0};
+  bool m_CacheIOVs{false};
+  bool m_OfflineMode{false};
+  std::string m_CacheDirectory;
   std::string m_CachedGlobalTag;
   std::set<std::string> m_DomainCache;
   std::set<std::string> m_GlobalTagCache;
+  std::map<long long, nlohmann::json> m_PayloadIOVCache;
 };
 
 #endif  // SPHENIXNPC_SPHENIXCLIENT_H
@@ -155,7 +155,7 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
   }
   if (cdbclient == nullptr)
   {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+    MakeClient();
   }
   uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
   if (Verbosity() > 0)
@@ -210,6 +210,28 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
   return return_url;
 }
 
+void CDBInterface::MakeClient()
+{
+  recoConsts *rc = recoConsts::instance();
+  cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+  // all domains are resolved from the same payload IOVs, the database is asked once per timestamp
+  cdbclient->CacheIOVs();
+  if (rc->FlagExist("CDB_CACHE_DIR"))
+  {
+    cdbclient->CacheDirectory(rc->get_StringFlag("CDB_CACHE_DIR"));
+  }
+  if (rc->FlagExist("CDB_OFFLINE") && rc->get_IntFlag("CDB_OFFLINE") != 0)
+  {
+    if (!rc->FlagExist("CDB_CACHE_DIR"))
+    {
+      std::cout << PHWHERE << "CDB_OFFLINE needs the cache directory set via" << std::endl;
+      std::cout << "rc->set_StringFlag(\"CDB_CACHE_DIR\",<directory>)" << std::endl;
+      gSystem->Exit(1);
+    }
+    cdbclient->OfflineMode();
+  }
+}
+
 void CDBInterface::DumpCalibrations(const std::string &filename)
 {
   recoConsts *rc = recoConsts::instance();
@@ -227,7 +249,7 @@ void CDBInterface::DumpCalibrations(const std::string &filename)
   }
   if (cdbclient == nullptr)
   {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+    MakeClient();
   }
   uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
   cdbclient->DumpCalibrations(timestamp, filename);
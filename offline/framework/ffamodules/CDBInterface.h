@@ -41,6 +41,10 @@ class CDBInterface : public SubsysReco
  private:
   CDBInterface(const std::string &name = "CDBInterface");
 
+  // the payload IOVs are cached on disk in the CDB_CACHE_DIR flag directory if set,
+  // CDB_OFFLINE (int flag) serves them from there without database access
+  void MakeClient();
+
   static CDBInterface *__instance;
   SphenixClient *cdbclient{nullptr};
   bool disable{false};
@@ -1,7 +1,10 @@
 #include "Fun4AllMemoryTracker.h"
 
+#include <phool/PHEventPool.h>
+
 #include <TSystem.h>
 
+#include <algorithm>
 #include <iostream>
 #include <utility>  // for pair, make_pair
 
@@ -154,3 +157,36 @@ std::vector<int> Fun4AllMemoryTracker::GetMemoryVector(const std::string &name)
   }
   return memvec;
 }
+
+void Fun4AllMemoryTracker::SnapshotEventPools()
+{
+  for (auto *pool : PHEventPoolBase::pools())
+  {
+    auto &counts = mEventPoolCounts[pool->Name()];
+    counts.events++;
+    counts.created += pool->created();
+    counts.reused += pool->reused();
+    counts.max_reused = std::max(counts.max_reused, pool->reused());
+    counts.capacity = std::max<uint64_t>(counts.capacity, pool->capacity());
+    if (Verbosity() > 0)
+    {
+      std::cout << "Event pool " << pool->Name() << ": allocated " << pool->created()
+                << ", allocations avoided " << pool->reused() << std::endl;
+    }
+    pool->clear_counters();
+  }
+  return;
+}
+
+void Fun4AllMemoryTracker::PrintEventPools() const
+{
+  for (const auto &[name, counts] : mEventPoolCounts)
+  {
+    std::cout << "Event pool " << name << ": " << counts.events << " events, "
+              << counts.created << " allocations, "
+              << counts.reused << " allocations avoided ("
+              << (counts.events ? counts.reused / counts.events : 0) << " per event, max "
+              << counts.max_reused << "), capacity " << counts.capacity << std::endl;
+  }
+  return;
+}
@@ -5,6 +5,7 @@
 
 #include "Fun4AllBase.h"
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -27,12 +28,26 @@ class Fun4AllMemoryTracker : public Fun4AllBase
   void PrintMemoryTracker(const std::string &name = "") const;
   std::vector<int> GetMemoryVector(const std::string &name) const;
 
+  //! collect the per event counters of the phool event pools (PHEventPool), called at the end of each event
+  void SnapshotEventPools();
+  void PrintEventPools() const;
+
  private:
   Fun4AllMemoryTracker();
   static std::string CreateFullTrackerName(const std::string &trackername, const std::string &group = "");
   static Fun4AllMemoryTracker *mInstance;
   std::map<std::string, std::vector<int>> mMemoryTrackerMap;
   std::map<std::string, int> mStartMem;
+
+  struct EventPoolCounts
+  {
+    uint64_t events{0};
+    uint64_t created{0};
+    uint64_t reused{0};
+    uint64_t max_reused{0};
+    uint64_t capacity{0};
+  };
+  std::map<std::string, EventPoolCounts> mEventPoolCounts;
 };
 
 #endif
@@ -0,0 +1,193 @@
+#include "Fun4AllModuleProfile.h"
+
+#include "Fun4AllMemoryTracker.h"
+
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+int Fun4AllModuleProfile::AddSlot(const std::string &name, const std::string &type)
+{
+  for (unsigned int i = 0; i < m_slots.size(); ++i)
+  {
+    if (m_slots[i].name == name && m_slots[i].type == type)
+    {
+      return i;
+    }
+  }
+  Slot s;
+  s.name = name;
+  s.type = type;
+  m_slots.push_back(s);
+  return m_slots.size() - 1;
+}
+
+void Fun4AllModuleProfile::Enable(const std::string &filename)
+{
+  m_enabled = true;
+  m_filename = filename;
+}
+
+long Fun4AllModuleProfile::GetRSS()
+{
+  return Fun4AllMemoryTracker::GetRSSMemory();
+}
+
+void Fun4AllModuleProfile::Fill(Slot &s, const std::chrono::steady_clock::time_point &stop)
+{
+  const double ms = std::chrono::duration<double, std::milli>(stop - s.start).count();
+  s.ncalls++;
+  s.sum_ms += ms;
+  s.max_ms = std::max(s.max_ms, ms);
+  int bin = 0;
+  if (ms >= kMinTime)
+  {
+    bin = std::min(kNBins - 1, static_cast<int>(std::log10(ms / kMinTime) * kBinsPerDecade) + 1);
+  }
+  s.hist[bin]++;
+  if (m_track_rss)
+  {
+    const long delta = GetRSS() - s.rss_start;
+    s.rss_delta_sum += delta;
+    s.rss_delta_max = std::max(s.rss_delta_max, delta);
+  }
+}
+
+double Fun4AllModuleProfile::BinLowEdge(const int bin)
+{
+  if (bin <= 0)
+  {
+    return 0;
+  }
+  return kMinTime * std::pow(10., static_cast<double>(bin - 1) / kBinsPerDecade);
+}
+
+double Fun4AllModuleProfile::Percentile(const int slot, const double fraction) const
+{
+  const Slot &s = m_slots.at(slot);
+  if (s.ncalls == 0)
+  {
+    return 0;
+  }
+  const double target = std::clamp(fraction, 0., 1.) * s.ncalls;
+  uint64_t cumulative = 0;
+  for (int bin = 0; bin < kNBins; ++bin)
+  {
+    if (s.hist[bin] == 0 || cumulative + s.hist[bin] < target)
+    {
+      cumulative += s.hist[bin];
+      continue;
+    }
+    if (bin == kNBins - 1)
+    {
+      return s.max_ms;
+    }
+    // interpolate inside the bin, linear for the underflow, logarithmic otherwise
+    const double frac = (target - cumulative) / s.hist[bin];
+    const double low = BinLowEdge(bin);
+    const double high = BinLowEdge(bin + 1);
+    const double value = (bin == 0) ? frac * high : low * std::pow(high / low, frac);
+    return std::min(value, s.max_ms);
+  }
+  return s.max_ms;
+}
+
+void Fun4AllModuleProfile::Print(std::ostream &os) const
+{
+  os << "Fun4AllModuleProfile: latencies in ms, rss in kB" << std::endl;
+  os << std::left << std::setw(40) << "module" << std::right
+     << std::setw(14) << "type"
+     << std::setw(10) << "calls"
+     << std::setw(12) << "mean"
+     << std::setw(12) << "p50"
+     << std::setw(12) << "p99"
+     << std::setw(12) << "max"
+     << std::setw(12) << "rss sum"
+     << std::setw(12) << "rss max" << std::endl;
+  for (unsigned int i = 0; i < m_slots.size(); ++i)
+  {
+    const Slot &s = m_slots[i];
+    os << std::left << std::setw(40) << s.name << std::right
+       << std::setw(14) << s.type
+       << std::setw(10) << s.ncalls
+       << std::setw(12) << (s.ncalls ? s.sum_ms / s.ncalls : 0.)
+       << std::setw(12) << Percentile(i, 0.5)
+       << std::setw(12) << Percentile(i, 0.99)
+       << std::setw(12) << s.max_ms
+       << std::setw(12) << s.rss_delta_sum
+       << std::setw(12) << s.rss_delta_max << std::endl;
+  }
+}
+
+int Fun4AllModuleProfile::WriteReport() const
+{
+  if (!m_enabled || m_filename.empty())
+  {
+    return 0;
+  }
+  std::ofstream outfile(m_filename, std::ios_base::trunc);
+  if (!outfile.is_open())
+  {
+    std::cout << PHWHERE << " could not open " << m_filename << " for writing" << std::endl;
+    return -1;
+  }
+  if (m_filename.size() >= 5 && m_filename.compare(m_filename.size() - 5, 5, ".json") == 0)
+  {
+    WriteJson(outfile);
+  }
+  else
+  {
+    WriteCsv(outfile);
+  }
+  return 0;
+}
+
+void Fun4AllModuleProfile::WriteJson(std::ostream &os) const
+{
+  os << "{" << std::endl;
+  os << "  \"time_unit\": \"ms\"," << std::endl;
+  os << "  \"memory_unit\": \"kB\"," << std::endl;
+  os << "  \"modules\": [";
+  for (unsigned int i = 0; i < m_slots.size(); ++i)
+  {
+    const Slot &s = m_slots[i];
+    os << (i ? "," : "") << std::endl;
+    os << "    {\"name\": \"" << s.name << "\""
+       << ", \"type\": \"" << s.type << "\""
+       << ", \"calls\": " << s.ncalls
+       << ", \"total\": " << s.sum_ms
+       << ", \"mean\": " << (s.ncalls ? s.sum_ms / s.ncalls : 0.)
+       << ", \"p50\": " << Percentile(i, 0.5)
+       << ", \"p90\": " << Percentile(i, 0.9)
+       << ", \"p99\": " << Percentile(i, 0.99)
+       << ", \"max\": " << s.max_ms
+       << ", \"rss_delta_sum\": " << s.rss_delta_sum
+       << ", \"rss_delta_max\": " << s.rss_delta_max << "}";
+  }
+  os << std::endl
+     << "  ]" << std::endl;
+  os << "}" << std::endl;
+}
+
+void Fun4AllModuleProfile::WriteCsv(std::ostream &os) const
+{
+  os << "name,type,calls,total_ms,mean_ms,p50_ms,p90_ms,p99_ms,max_ms,rss_delta_sum_kB,rss_delta_max_kB" << std::endl;
+  for (unsigned int i = 0; i < m_slots.size(); ++i)
+  {
+    const Slot &s = m_slots[i];
+    os << s.name << ","
+       << s.type << ","
+       << s.ncalls << ","
+       << s.sum_ms << ","
+       << (s.ncalls ? s.sum_ms / s.ncalls : 0.) << ","
+       << Percentile(i, 0.5) << ","
+       << Percentile(i, 0.9) << ","
+       << Percentile(i, 0.99) << ","
+       << s.max_ms << ","
+       << s.rss_delta_sum << ","
+       << s.rss_delta_max << std::endl;
+  }
+}
@@ -0,0 +1,103 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLMODULEPROFILE_H
+#define FUN4ALL_FUN4ALLMODULEPROFILE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+//! per module latency and memory profile of the event loop
+/*!
+ * Each SubsysReco and output manager gets a slot when it is registered,
+ * the event loop then only passes the slot index to Start()/Stop().
+ * Latencies are filled into a logarithmic histogram (20 bins per decade
+ * from 1 us to 1e5 s), so the memory use does not grow with the number
+ * of events and the percentiles are good to about 6%.
+ * The mean and maximum are exact.
+ */
+class Fun4AllModuleProfile
+{
+ public:
+  Fun4AllModuleProfile() = default;
+  ~Fun4AllModuleProfile() = default;
+
+  //! returns the slot for name/type, creating it if it does not exist yet
+  int AddSlot(const std::string &name, const std::string &type);
+
+  void Start(const int slot)
+  {
+    if (!m_enabled || slot < 0)
+    {
+      return;
+    }
+    Slot &s = m_slots[slot];
+    if (m_track_rss)
+    {
+      s.rss_start = GetRSS();
+    }
+    s.start = std::chrono::steady_clock::now();
+  }
+
+  void Stop(const int slot)
+  {
+    if (!m_enabled || slot < 0)
+    {
+      return;
+    }
+    Fill(m_slots[slot], std::chrono::steady_clock::now());
+  }
+
+  //! enable the profile, the report is written to filename by End()
+  /*! files ending in .json get json, everything else csv. An empty name only prints the summary */
+  void Enable(const std::string &filename);
+  bool Enabled() const { return m_enabled; }
+
+  //! switch off the rss measurement (it reads /proc at every Start/Stop)
+  void TrackRSS(const bool yesno) { m_track_rss = yesno; }
+
+  //! write the report (if a file name was given)
+  int WriteReport() const;
+  void Print(std::ostream &os = std::cout) const;
+
+  //! percentile (0-1) of the latencies in ms
+  double Percentile(const int slot, const double fraction) const;
+
+ private:
+  static constexpr int kBinsPerDecade = 20;
+  static constexpr int kDecades = 11;
+  static constexpr int kNBins = kBinsPerDecade * kDecades + 2;  // underflow and overflow
+  static constexpr double kMinTime = 1e-3;                     // ms
+
+  struct Slot
+  {
+    std::string name;
+    std::string type;
+    std::chrono::steady_clock::time_point start;
+    long rss_start{0};
+
+    uint64_t ncalls{0};
+    double sum_ms{0};
+    double max_ms{0};
+    long rss_delta_sum{0};
+    long rss_delta_max{0};
+    std::array<uint64_t, kNBins> hist{};
+  };
+
+  static long GetRSS();
+  void Fill(Slot &s, const std::chrono::steady_clock::time_point &stop);
+  static double BinLowEdge(const int bin);
+
+  void WriteJson(std::ostream &os) const;
+  void WriteCsv(std::ostream &os) const;
+
+  bool m_enabled{false};
+  bool m_track_rss{true};
+  std::string m_filename;
+  std::vector<Slot> m_slots;
+};
+
+#endif
@@ -74,6 +74,7 @@ Fun4AllServer::~Fun4AllServer()
     }
     delete Subsystems.back().first;
     Subsystems.pop_back();
+    m_subsystem_slots.pop_back();
   }
   while (HistoManager.begin() != HistoManager.end())
   {
@@ -92,6 +93,7 @@ Fun4AllServer::~Fun4AllServer()
     }
     delete OutputManager.back();
     OutputManager.pop_back();
+    m_outputmanager_slots.pop_back();
   }
   while (SyncManagers.begin() != SyncManagers.end())
   {
@@ -269,10 +271,18 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
   std::string timer_name;
   timer_name = subsystem->Name() + "_" + topnodename;
   PHTimer timer(timer_name);
-  if (!timer_map.contains(timer_name))
-  {
-    timer_map.insert(make_pair(timer_name, timer));
-  }
+  auto titer = timer_map.find(timer_name);
+  if (titer == timer_map.end())
+  {
+    titer = timer_map.insert(make_pair(timer_name, timer)).first;
+  }
+  // map nodes do not move, the event loop can keep the timer pointer
+  SubsystemSlot slot;
+  slot.timer = &titer->second;
+  slot.tracker_name = timer_name;
+  slot.dirname = topnodename + "/" + subsystem->Name();
+  slot.profile_slot = m_module_profile.AddSlot(timer_name, "SubsysReco");
+  m_subsystem_slots.push_back(slot);
   RetCodes.push_back(iret);  // vector with return codes
   return 0;
 }
@@ -318,6 +328,7 @@ int Fun4AllServer::unregisterSubsystemsNow()
                 << " at index " << index << std::endl;
     }
     Subsystems.erase(Subsystems.begin() + index);
+    m_subsystem_slots.erase(m_subsystem_slots.begin() + index);
     delete (*removeiter).first;
     // also update the vector with return codes
     RetCodes.erase(RetCodes.begin() + index);
@@ -385,6 +396,7 @@ int Fun4AllServer::registerOutputManager(Fun4AllOutputManager *manager)
   }
   UpdateEventSelector(manager);
   OutputManager.push_back(manager);
+  m_outputmanager_slots.push_back(m_module_profile.AddSlot(manager->Name(), "OutputManager"));
   return 0;
 }
 
@@ -538,8 +550,8 @@ int Fun4AllServer::process_event()
     {
       std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
     }
-    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
-    if (!gROOT->cd(newdirname.c_str()))
+    const SubsystemSlot &slot = m_subsystem_slots[icnt];
+    if (!gROOT->cd(slot.dirname.c_str()))
     {
       std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
                 << Subsystem.second->getName()
@@ -550,7 +562,7 @@ int Fun4AllServer::process_event()
     {
       if (Verbosity() >= VERBOSITY_EVEN_MORE)
       {
-        std::cout << "process_event: cded to " << newdirname << std::endl;
+        std::cout << "process_event: cded to " << slot.dirname << std::endl;
       }
     }
 
@@ -559,24 +571,14 @@ int Fun4AllServer::process_event()
 
     try
     {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
-      {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
-      {
-        std::cout << "could not find timer for " << timer_name << std::endl;
-      }
+      slot.timer->restart();
 #ifdef FFAMEMTRACKER
-      ffamemtracker->Start(timer_name, "SubsysReco");
+      ffamemtracker->Start(slot.tracker_name, "SubsysReco");
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
+      m_module_profile.Start(slot.profile_slot);
       int retcode = Subsystem.first->process_event(Subsystem.second);
+      m_module_profile.Stop(slot.profile_slot);
       std::cout.copyfmt(m_saved_cout_state); // restore cout to default formatting
 #ifdef FFAMEMTRACKER
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
@@ -596,12 +598,9 @@ int Fun4AllServer::process_event()
         std::cout << "error: " << e.what() << std::endl;
         gSystem->Exit(1);
       }
-      if (timer_found)
-      {
-        titer->second.stop();
-      }
+      slot.timer->stop();
 #ifdef FFAMEMTRACKER
-      ffamemtracker->Stop(timer_name, "SubsysReco");
+      ffamemtracker->Stop(slot.tracker_name, "SubsysReco");
 #endif
     }
     catch (const std::exception &e)
@@ -703,10 +702,12 @@ int Fun4AllServer::process_event()
         std::cout << PHWHERE << " FATAL: Someone changed the number of Output Nodes on the fly, from " << OutNodeCount << " to " << newcount << std::endl;
         exit(1);
       }
-      for (auto *iterOutMan : OutputManager)
+      for (unsigned int iout = 0; iout < OutputManager.size(); ++iout)
       {
+        Fun4AllOutputManager *iterOutMan = OutputManager[iout];
         if (!iterOutMan->DoNotWriteEvent(&RetCodes))
         {
+          m_module_profile.Start(m_outputmanager_slots[iout]);
           if (Verbosity() >= VERBOSITY_MORE)
           {
             std::cout << "Writing Event for " << iterOutMan->Name() << std::endl;
@@ -733,6 +734,7 @@ int Fun4AllServer::process_event()
           }
           // save runnode, open new file, write
           iterOutMan->WriteGeneric(dstNode);
+          m_module_profile.Stop(m_outputmanager_slots[iout]);
 #ifdef FFAMEMTRACKER
           ffamemtracker->Stop(iterOutMan->Name(), "OutputManager");
           ffamemtracker->Snapshot("Fun4AllServerOutputManager");
@@ -804,6 +806,8 @@ int Fun4AllServer::process_event()
   }
   Fun4AllMonitoring::instance()->Snapshot("Event");
   ResetNodeTree();
+  // containers drawing from phool event pools have been reset, record what the pools saved
+  Fun4AllMemoryTracker::instance()->SnapshotEventPools();
   return 0;
 }
 
@@ -1179,6 +1183,12 @@ int Fun4AllServer::End()
   // close output files (check for existing output managers is
   // done inside outfileclose())
   outfileclose();
+  if (m_module_profile.Enabled())
+  {
+    m_module_profile.Print();
+    m_module_profile.WriteReport();
+  }
+  Fun4AllMemoryTracker::instance()->PrintEventPools();
   for (auto &histit : HistoManager)
   {
     if (histit->ApplyFileRule())
@@ -1328,6 +1338,7 @@ int Fun4AllServer::outfileclose()
     }
     delete *(OutputManager.begin());
     OutputManager.erase(OutputManager.begin());
+    m_outputmanager_slots.erase(m_outputmanager_slots.begin());
   }
   return 0;
 }
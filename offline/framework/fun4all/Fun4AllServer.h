@@ -6,6 +6,7 @@
 #include "Fun4AllBase.h"
 
 #include "Fun4AllHistoManager.h"  // for Fun4AllHistoManager
+#include "Fun4AllModuleProfile.h"
 
 #include <phool/PHTimer.h>
 
@@ -117,6 +118,10 @@ class Fun4AllServer : public Fun4AllBase
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
   int UpdateRunNode();
+  //! per module latency (p50/p99/max) and rss profile, written at End() (json if the name ends in .json, csv otherwise)
+  void ModuleProfile(const std::string &filename = "") { m_module_profile.Enable(filename); }
+  void ModuleProfileTrackRSS(const bool yesno) { m_module_profile.TrackRSS(yesno); }
+  const Fun4AllModuleProfile &GetModuleProfile() const { return m_module_profile; }
   void AddResetNodeName(const std::string &name) {ResetNodeList.emplace_back(name);}
 
  protected:
@@ -159,6 +164,18 @@ class Fun4AllServer : public Fun4AllBase
   std::vector<Fun4AllSyncManager *> SyncManagers;
   std::map<int, int> retcodesmap;
   std::map<const std::string, PHTimer> timer_map;
+
+  //! everything the event loop needs per SubsysReco, resolved at registration
+  struct SubsystemSlot
+  {
+    PHTimer *timer{nullptr};
+    std::string tracker_name;
+    std::string dirname;
+    int profile_slot{-1};
+  };
+  std::vector<SubsystemSlot> m_subsystem_slots;  // same order as Subsystems
+  std::vector<int> m_outputmanager_slots;        // same order as OutputManager
+  Fun4AllModuleProfile m_module_profile;
 };
 
 #endif
@@ -37,6 +37,7 @@
 
 #include <TH1.h>
 #include <TH2.h>
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <algorithm>  // for max
@@ -44,7 +45,9 @@
 #include <cstdint>  // for uint64_t, uint16_t
 #include <cstdlib>
 #include <format>
+#include <future>
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <mutex>
 #include <sstream>
 #include <utility>   // for pair
 
@@ -152,6 +155,13 @@ int Fun4AllStreamingInputManager::run(const int /*nevents*/)
   {
     iret += FillGl1();
   }
+  // once the reference bco is known the detectors do not depend on each other,
+  // without it the first detector sets the reference and they run in order
+  if (m_ConcurrentFill && m_RefBCO != 0)
+  {
+    iret += FillConcurrently();
+    return iret;
+  }
   if (m_intt_registered_flag)
   {
     iret += FillIntt();
@@ -251,6 +261,79 @@ int Fun4AllStreamingInputManager::run(const int /*nevents*/)
   //  return 0;
 }
 
+int Fun4AllStreamingInputManager::FillConcurrently()
+{
+  // every detector fill decodes its own inputs into its own raw hit map
+  // and copies it to its own node, they only share the run number check
+  std::vector<int (Fun4AllStreamingInputManager::*)()> fills;
+  if (m_intt_registered_flag)
+  {
+    fills.push_back(&Fun4AllStreamingInputManager::FillIntt);
+  }
+  if (m_mvtx_registered_flag)
+  {
+    fills.push_back(&Fun4AllStreamingInputManager::FillMvtx);
+  }
+  if (m_tpc_registered_flag)
+  {
+    fills.push_back(&Fun4AllStreamingInputManager::FillTpc);
+  }
+  if (m_micromegas_registered_flag)
+  {
+    fills.push_back(&Fun4AllStreamingInputManager::FillMicromegas);
+  }
+  if (fills.empty())
+  {
+    return 0;
+  }
+
+  // the last detector is filled in this thread
+  std::vector<std::future<int>> results;
+  for (auto fill = fills.begin(); fill != fills.end() - 1; ++fill)
+  {
+    results.push_back(std::async(std::launch::async, *fill, this));
+  }
+  int iret = (this->*fills.back())();
+  for (auto &result : results)
+  {
+    iret += result.get();
+  }
+  return iret;
+}
+
+void Fun4AllStreamingInputManager::CheckRunNumber(SingleStreamingInput *iter)
+{
+  std::lock_guard<std::mutex> lock(m_RunNumberMutex);
+  if (m_RunNumber == 0)
+  {
+    m_RunNumber = iter->RunNumber();
+    SetRunNumber(m_RunNumber);
+  }
+  else
+  {
+    if (m_RunNumber != iter->RunNumber())
+    {
+      std::cout << PHWHERE << " Run Number mismatch, run is "
+                << m_RunNumber << ", " << iter->Name() << " reads "
+                << iter->RunNumber() << std::endl;
+      std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
+      Print("INPUTFILES");
+      gSystem->Exit(1);
+      exit(1);
+    }
+  }
+}
+
+void Fun4AllStreamingInputManager::ConcurrentFill(bool b)
+{
+  m_ConcurrentFill = b;
+  if (m_ConcurrentFill)
+  {
+    // the tpc inputs create their histograms when they see a new packet
+    ROOT::EnableThreadSafety();
+  }
+}
+
 int Fun4AllStreamingInputManager::fileclose()
 {
   return 0;
@@ -568,24 +651,7 @@ int Fun4AllStreamingInputManager::FillGl1()
       std::cout << "Fun4AllStreamingInputManager::FillGl1 - fill pool for " << iter->Name() << std::endl;
     }
     iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   if (m_Gl1RawHitMap.empty())
   {
@@ -1135,12 +1201,9 @@ int Fun4AllStreamingInputManager::FillMvtx()
   uint64_t lower_limit = m_mvtx_is_triggered ? select_crossings : select_crossings - m_mvtx_bco_range - m_mvtx_negative_bco;
   uint64_t upper_limit = m_mvtx_is_triggered ? select_crossings + m_mvtx_bco_range : select_crossings;
 
-  for (auto& [bco, hitinfo] : m_MvtxRawHitMap)
+  for (auto iter = m_MvtxRawHitMap.lower_bound(lower_limit); iter != m_MvtxRawHitMap.end(); ++iter)
   {
-    if (bco < lower_limit)
-    {
-      continue;
-    }
+    auto &[bco, hitinfo] = *iter;
     if (bco > upper_limit)
     {
       break;
@@ -1418,24 +1481,7 @@ int Fun4AllStreamingInputManager::FillInttPool()
     }
     iter->FillPool(ref_bco_minus_range);
     // iter->FillPool();
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   if (m_InttRawHitMap.empty())
   {
@@ -1465,24 +1511,7 @@ int Fun4AllStreamingInputManager::FillTpcPool()
     {
       return fill_pool_status;
     }
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   // if (m_TpcRawHitMap.empty())
   // {
@@ -1508,24 +1537,7 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
       std::cout << "Fun4AllStreamingInputManager::FillMicromegasPool - fill pool for " << iter->Name() << std::endl;
     }
     iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   if (m_MicromegasRawHitMap.empty())
   {
@@ -1545,24 +1557,7 @@ int Fun4AllStreamingInputManager::FillMvtxPool()
       std::cout << "Fun4AllStreamingInputManager::FillMvtxPool - fill pool for " << iter->Name() << std::endl;
     }
     iter->FillPool(ref_bco_minus_range);
-    if (m_RunNumber == 0)
-    {
-      m_RunNumber = iter->RunNumber();
-      SetRunNumber(m_RunNumber);
-    }
-    else
-    {
-      if (m_RunNumber != iter->RunNumber())
-      {
-        std::cout << PHWHERE << " Run Number mismatch, run is "
-                  << m_RunNumber << ", " << iter->Name() << " reads "
-                  << iter->RunNumber() << std::endl;
-        std::cout << "You are likely reading files from different runs, do not do that" << std::endl;
-        Print("INPUTFILES");
-        gSystem->Exit(1);
-        exit(1);
-      }
-    }
+    CheckRunNumber(iter);
   }
   if (m_MvtxRawHitMap.empty())
   {
@@ -4,10 +4,12 @@
 #define FUN4ALLRAW_FUN4ALLSTREAMINGINPUTMANAGER_H
 
 #include "InputManagerType.h"
+#include "StreamingBcoIndex.h"
 
 #include <fun4all/Fun4AllInputManager.h>
 
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -69,6 +71,9 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int FillTpcPool();
   void Streaming(bool b = true) { m_StreamingFlag = b; }
 
+  // fill the detectors in parallel threads once the gl1 reference bco is known
+  void ConcurrentFill(bool b = true);
+
   void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
 
   // configuration for INTT hit carry-over issue mitigation (hit duplication)
@@ -89,33 +94,62 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
     std::vector<MvtxFeeIdInfo *> MvtxFeeIdInfoVector;
     std::vector<MvtxRawHit *> MvtxRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      MvtxL1TrgBco.clear();
+      MvtxFeeIdInfoVector.clear();
+      MvtxRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct Gl1RawHitInfo
   {
     std::vector<Gl1Packet *> Gl1RawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      Gl1RawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct InttRawHitInfo
   {
     std::vector<InttRawHit *> InttRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      InttRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct MicromegasRawHitInfo
   {
     std::vector<MicromegasRawHit *> MicromegasRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      MicromegasRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct TpcRawHitInfo
   {
     std::vector<TpcRawHit *> TpcRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      TpcRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   void createQAHistos();
+  int FillConcurrently();
+  void CheckRunNumber(SingleStreamingInput *iter);
 
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
@@ -139,17 +173,22 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   bool m_StreamingFlag{false};
   bool m_tpc_registered_flag{false};
   bool m_mvtx_is_triggered{false};
+  bool m_ConcurrentFill{false};
+
+  // run number is set by the first input, which can be read by any detector thread
+  std::mutex m_RunNumberMutex;
 
   std::vector<SingleStreamingInput *> m_Gl1InputVector;
   std::vector<SingleStreamingInput *> m_InttInputVector;
   std::vector<SingleStreamingInput *> m_MicromegasInputVector;
   std::vector<SingleStreamingInput *> m_MvtxInputVector;
   std::vector<SingleStreamingInput *> m_TpcInputVector;
-  std::map<uint64_t, Gl1RawHitInfo> m_Gl1RawHitMap;
-  std::map<uint64_t, InttRawHitInfo> m_InttRawHitMap;
-  std::map<uint64_t, MicromegasRawHitInfo> m_MicromegasRawHitMap;
-  std::map<uint64_t, MvtxRawHitInfo> m_MvtxRawHitMap;
-  std::map<uint64_t, TpcRawHitInfo> m_TpcRawHitMap;
+  // hits waiting per BCO, ordered by BCO
+  StreamingBcoIndex<Gl1RawHitInfo> m_Gl1RawHitMap;
+  StreamingBcoIndex<InttRawHitInfo> m_InttRawHitMap;
+  StreamingBcoIndex<MicromegasRawHitInfo> m_MicromegasRawHitMap;
+  StreamingBcoIndex<MvtxRawHitInfo> m_MvtxRawHitMap;
+  StreamingBcoIndex<TpcRawHitInfo> m_TpcRawHitMap;
   std::map<int, std::map<int, uint64_t>> m_InttPacketFeeBcoMap;
 
   // QA histos
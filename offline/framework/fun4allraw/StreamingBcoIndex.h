@@ -0,0 +1,263 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_STREAMINGBCOINDEX_H
+#define FUN4ALLRAW_STREAMINGBCOINDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! BCO ordered index of the hits waiting in the streaming input manager
+/*!
+ * Drop-in replacement for the std::map<uint64_t, T> used per detector. The
+ * entries are kept sorted in a ring buffer: the pools deliver BCOs almost in
+ * order, so a new BCO is appended at the back in O(1), the oldest one is
+ * evicted from the front in O(1) and lookups and range queries are binary
+ * searches on contiguous memory. A BCO arriving out of order is inserted by
+ * moving the entries behind it, usually only a few.
+ *
+ * Evicted slots are not destroyed but cleared (with T::clear() if it exists)
+ * and reused for the next BCOs, which keeps the capacity of their vectors and
+ * avoids the node allocation per BCO of the map.
+ *
+ * As for std::vector, inserting invalidates references and iterators.
+ */
+template <class T>
+class StreamingBcoIndex
+{
+ public:
+  using key_type = uint64_t;
+  using mapped_type = T;
+  using value_type = std::pair<uint64_t, T>;
+  using size_type = std::size_t;
+
+  template <bool Const>
+  class Iterator
+  {
+   public:
+    using index_type = std::conditional_t<Const, const StreamingBcoIndex, StreamingBcoIndex>;
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = StreamingBcoIndex::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const value_type *, value_type *>;
+    using reference = std::conditional_t<Const, const value_type &, value_type &>;
+
+    Iterator() = default;
+    Iterator(index_type *index, size_type position)
+      : m_index(index)
+      , m_position(position)
+    {
+    }
+
+    //! conversion from iterator to const_iterator
+    template <bool OtherConst>
+      requires(Const && !OtherConst)
+    Iterator(const Iterator<OtherConst> &other)
+      : m_index(other.m_index)
+      , m_position(other.m_position)
+    {
+    }
+
+    reference operator*() const { return m_index->at_position(m_position); }
+    pointer operator->() const { return &m_index->at_position(m_position); }
+
+    Iterator &operator++()
+    {
+      ++m_position;
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      Iterator old = *this;
+      ++m_position;
+      return old;
+    }
+    Iterator &operator--()
+    {
+      --m_position;
+      return *this;
+    }
+    Iterator operator--(int)
+    {
+      Iterator old = *this;
+      --m_position;
+      return old;
+    }
+
+    bool operator==(const Iterator &other) const { return m_position == other.m_position && m_index == other.m_index; }
+
+   private:
+    friend class StreamingBcoIndex;
+    template <bool>
+    friend class Iterator;
+
+    index_type *m_index{nullptr};
+    size_type m_position{0};
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  iterator begin() { return {this, 0}; }
+  iterator end() { return {this, m_size}; }
+  const_iterator begin() const { return {this, 0}; }
+  const_iterator end() const { return {this, m_size}; }
+
+  bool empty() const { return m_size == 0; }
+  size_type size() const { return m_size; }
+
+  //! number of slots allocated, the entries plus the cleared slots kept for reuse
+  size_type capacity() const { return m_slots.size(); }
+
+  //! entry for bco, created if needed
+  T &operator[](uint64_t bco)
+  {
+    // new BCOs come in order most of the time
+    if (m_size == 0 || at_position(m_size - 1).first < bco)
+    {
+      return insert_at(m_size, bco).second;
+    }
+    const size_type position = lower_position(bco);
+    if (at_position(position).first == bco)
+    {
+      return at_position(position).second;
+    }
+    return insert_at(position, bco).second;
+  }
+
+  //! first entry with a BCO not less than bco
+  iterator lower_bound(uint64_t bco) { return {this, lower_position(bco)}; }
+  const_iterator lower_bound(uint64_t bco) const { return {this, lower_position(bco)}; }
+
+  //! first entry with a BCO greater than bco
+  iterator upper_bound(uint64_t bco) { return {this, upper_position(bco)}; }
+  const_iterator upper_bound(uint64_t bco) const { return {this, upper_position(bco)}; }
+
+  iterator find(uint64_t bco)
+  {
+    const size_type position = lower_position(bco);
+    return (position < m_size && at_position(position).first == bco) ? iterator(this, position) : end();
+  }
+  const_iterator find(uint64_t bco) const
+  {
+    const size_type position = lower_position(bco);
+    return (position < m_size && at_position(position).first == bco) ? const_iterator(this, position) : end();
+  }
+
+  bool contains(uint64_t bco) const { return find(bco) != end(); }
+
+  //! remove an entry, O(1) for the first one, returns the iterator to the next entry
+  iterator erase(const_iterator pos)
+  {
+    const size_type position = pos.m_position;
+    if (position == 0)
+    {
+      reset(m_slots[m_head]);
+      m_head = (m_head + 1) & (m_slots.size() - 1);
+      --m_size;
+      return begin();
+    }
+    // move the cleared slot behind the last entry
+    reset(at_position(position));
+    for (size_type i = position; i + 1 < m_size; ++i)
+    {
+      std::swap(at_position(i), at_position(i + 1));
+    }
+    --m_size;
+    return {this, position};
+  }
+
+  //! remove all entries, the slots are kept
+  void clear()
+  {
+    for (size_type i = 0; i < m_size; ++i)
+    {
+      reset(at_position(i));
+    }
+    m_head = 0;
+    m_size = 0;
+  }
+
+ private:
+  value_type &at_position(size_type position) { return m_slots[(m_head + position) & (m_slots.size() - 1)]; }
+  const value_type &at_position(size_type position) const { return m_slots[(m_head + position) & (m_slots.size() - 1)]; }
+
+  size_type lower_position(uint64_t bco) const
+  {
+    size_type low = 0;
+    size_type high = m_size;
+    while (low < high)
+    {
+      const size_type middle = low + (high - low) / 2;
+      if (at_position(middle).first < bco)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  size_type upper_position(uint64_t bco) const
+  {
+    const size_type position = lower_position(bco);
+    return (position < m_size && at_position(position).first == bco) ? position + 1 : position;
+  }
+
+  //! new entry for bco at position, the entries from position on move back by one
+  value_type &insert_at(size_type position, uint64_t bco)
+  {
+    if (m_size == m_slots.size())
+    {
+      grow();
+    }
+    // the free slot behind the last entry is moved to position
+    for (size_type i = m_size; i > position; --i)
+    {
+      std::swap(at_position(i), at_position(i - 1));
+    }
+    ++m_size;
+    value_type &entry = at_position(position);
+    entry.first = bco;
+    return entry;
+  }
+
+  //! double the number of slots (always a power of 2), the entries are moved to the front
+  void grow()
+  {
+    std::vector<value_type> slots(std::max<size_type>(16, 2 * m_slots.size()));
+    for (size_type i = 0; i < m_slots.size(); ++i)
+    {
+      slots[i] = std::move(at_position(i));
+    }
+    m_slots = std::move(slots);
+    m_head = 0;
+  }
+
+  //! clear an evicted entry, keeping its memory when T knows how
+  static void reset(value_type &entry)
+  {
+    entry.first = 0;
+    if constexpr (requires(T &t) { t.clear(); })
+    {
+      entry.second.clear();
+    }
+    else
+    {
+      entry.second = T{};
+    }
+  }
+
+  std::vector<value_type> m_slots;
+  size_type m_head{0};
+  size_type m_size{0};
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "PHEventPool.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace
+{
+  std::vector<PHEventPoolBase *> &registered_pools()
+  {
+    static std::vector<PHEventPoolBase *> pools;
+    return pools;
+  }
+
+  // pools may be created and destroyed by containers living in different threads
+  std::mutex &registry_mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+}  // namespace
+
+PHEventPoolBase::PHEventPoolBase(const std::string &name)
+  : m_name(name)
+{
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  registered_pools().push_back(this);
+}
+
+PHEventPoolBase::~PHEventPoolBase()
+{
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  auto &pools = registered_pools();
+  pools.erase(std::remove(pools.begin(), pools.end(), this), pools.end());
+}
+
+std::vector<PHEventPoolBase *> PHEventPoolBase::pools()
+{
+  std::lock_guard<std::mutex> lock(registry_mutex());
+  return registered_pools();
+}
@@ -0,0 +1,123 @@
+#ifndef PHOOL_PHEVENTPOOL_H
+#define PHOOL_PHEVENTPOOL_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+//! bookkeeping common to all event pools
+/*!
+ * Every pool registers itself in a global list, so that the framework
+ * (Fun4AllMemoryTracker) can report the allocations saved per event
+ * without knowing about the pooled types.
+ */
+class PHEventPoolBase
+{
+ public:
+  explicit PHEventPoolBase(const std::string &name);
+  virtual ~PHEventPoolBase();
+
+  PHEventPoolBase(const PHEventPoolBase &) = delete;
+  PHEventPoolBase &operator=(const PHEventPoolBase &) = delete;
+
+  const std::string &Name() const { return m_name; }
+
+  //! hand all objects back to the pool
+  virtual void rewind() = 0;
+
+  //! number of objects owned by the pool
+  virtual std::size_t capacity() const = 0;
+
+  //! objects constructed since the last call
+  uint64_t created() const { return m_created; }
+
+  //! objects handed out again instead of being allocated since the last call
+  uint64_t reused() const { return m_reused; }
+
+  //! reset the created/reused counters (done by the memory tracker once per event)
+  void clear_counters()
+  {
+    m_created = 0;
+    m_reused = 0;
+  }
+
+  //! copy of the list of existing pools
+  /*!
+   * The list itself is protected by a lock. The counters of a pool are not,
+   * they must be read from the thread which runs the event loop.
+   */
+  static std::vector<PHEventPoolBase *> pools();
+
+ protected:
+  uint64_t m_created{0};
+  uint64_t m_reused{0};
+
+ private:
+  std::string m_name;
+};
+
+//! per event pool of objects
+/*!
+ * Objects are handed out with get() and stay owned by the pool.
+ * rewind() makes all of them available again without destroying them,
+ * so it costs O(1) and the next event does not allocate as long as it
+ * does not need more objects than the previous ones. Objects are
+ * returned in the state they were left in, the owner is expected to
+ * reset them before rewinding (usually in its own Reset()).
+ * The pool is not thread safe, it belongs to a single container.
+ */
+template <class T>
+class PHEventPool : public PHEventPoolBase
+{
+ public:
+  explicit PHEventPool(const std::string &name)
+    : PHEventPoolBase(name)
+  {
+  }
+
+  ~PHEventPool() override
+  {
+    for (auto *object : m_objects)
+    {
+      delete object;
+    }
+  }
+
+  T *get()
+  {
+    if (m_used < m_objects.size())
+    {
+      ++m_reused;
+      return m_objects[m_used++];
+    }
+    T *object = new T;
+    m_objects.push_back(object);
+    m_owned.insert(object);
+    ++m_used;
+    ++m_created;
+    return object;
+  }
+
+  //! true if the object comes from this pool (and must not be deleted)
+  /*! object can be a base class pointer, it is compared through its most derived address */
+  template <class U>
+  bool owns(const U *object) const
+  {
+    return object && m_owned.contains(dynamic_cast<const void *>(object));
+  }
+
+  void rewind() override { m_used = 0; }
+
+  std::size_t capacity() const override { return m_objects.size(); }
+
+  //! number of objects handed out since the last rewind
+  std::size_t used() const { return m_used; }
+
+ private:
+  std::vector<T *> m_objects;
+  std::unordered_set<const void *> m_owned;
+  std::size_t m_used{0};
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "TowerInfoContainerv6.h"
+
+#include <algorithm>
+
+TowerInfoContainerv6::TowerInfoContainerv6(DETECTOR detec)
+  : m_detector(detec)
+{
+  // as tower numbers are fixed the arrays are sized once per run
+  const std::size_t nchannels = get_channels(detec);
+  m_energy.resize(nchannels, 0);
+  m_time.resize(nchannels, 0);
+  m_chi2.resize(nchannels, 0);
+  m_pedestal.resize(nchannels, 0);
+  m_status.resize(nchannels, 0);
+}
+
+TowerInfoContainerv6::TowerInfoContainerv6(const TowerInfoContainerv6& source)
+  : TowerInfoContainer(source)
+  , m_detector(source.m_detector)
+  , m_energy(source.m_energy)
+  , m_time(source.m_time)
+  , m_chi2(source.m_chi2)
+  , m_pedestal(source.m_pedestal)
+  , m_status(source.m_status)
+{
+  // the views of the source point to the source, new ones are made on first access
+}
+
+void TowerInfoContainerv6::identify(std::ostream& os) const
+{
+  os << "TowerInfoContainerv6 of size " << size() << std::endl;
+}
+
+void TowerInfoContainerv6::Reset()
+{
+  // clear content of towers in the container for the next event
+  std::fill(m_energy.begin(), m_energy.end(), 0);
+  std::fill(m_time.begin(), m_time.end(), 0);
+  std::fill(m_chi2.begin(), m_chi2.end(), 0);
+  std::fill(m_pedestal.begin(), m_pedestal.end(), 0);
+  std::fill(m_status.begin(), m_status.end(), 0);
+}
+
+void TowerInfoContainerv6::make_views()
+{
+  m_views.clear();
+  m_views.reserve(size());
+  for (std::size_t channel = 0; channel < size(); ++channel)
+  {
+    m_views.emplace_back(this, channel);
+  }
+}
+
+TowerInfo* TowerInfoContainerv6::get_tower_at_channel(int pos)
+{
+  if (pos < 0 || static_cast<std::size_t>(pos) >= size())
+  {
+    return nullptr;
+  }
+  if (m_views.size() != size())
+  {
+    make_views();
+  }
+  return &m_views[pos];
+}
+
+TowerInfo* TowerInfoContainerv6::get_tower_at_key(int pos)
+{
+  int index = decode_key(pos);
+  return get_tower_at_channel(index);
+}
+
+void TowerInfoContainerv6::TowerView::Reset()
+{
+  m_container->m_energy[m_channel] = 0;
+  m_container->m_time[m_channel] = 0;
+  m_container->m_chi2[m_channel] = 0;
+  m_container->m_pedestal[m_channel] = 0;
+  m_container->m_status[m_channel] = 0;
+}
+
+void TowerInfoContainerv6::TowerView::copy_tower(TowerInfo* tower)
+{
+  set_time(tower->get_time());
+  set_energy(tower->get_energy());
+  set_chi2(tower->get_chi2());
+  set_pedestal(tower->get_pedestal());
+  set_status(tower->get_status());
+}
@@ -0,0 +1,143 @@
+#ifndef TOWERINFOCONTAINERV6_H
+#define TOWERINFOCONTAINERV6_H
+
+#include "TowerInfo.h"
+#include "TowerInfoContainer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <vector>
+
+class PHObject;
+
+// towers stored as structure of arrays: one contiguous array per quantity
+// instead of a TClonesArray of TowerInfo objects. Calibration modules can
+// work on whole arrays through the span accessors, get_tower_at_channel()
+// returns a view which reads and writes the arrays for the tower by tower code
+class TowerInfoContainerv6 : public TowerInfoContainer
+{
+ public:
+  // status bits, same layout as TowerInfov2 and TowerInfov4
+  enum StatusBit : uint8_t
+  {
+    kHot = 1U << 0U,
+    kFitStatus = 1U << 1U,
+    kBadChi2 = 1U << 2U,
+    kNotInstr = 1U << 3U,
+    kNoCalib = 1U << 4U,
+    kZS = 1U << 5U,
+    kRecovered = 1U << 6U,
+    kSaturated = 1U << 7U
+  };
+
+  // tower view on one channel, it is not persistent and never owned by the user
+  class TowerView : public TowerInfo
+  {
+   public:
+    TowerView(TowerInfoContainerv6 *container, std::size_t channel)
+      : m_container(container)
+      , m_channel(channel)
+    {
+    }
+    ~TowerView() override = default;
+
+    void Reset() override;
+
+    void set_time(float t) override { m_container->m_time[m_channel] = t; }
+    float get_time() override { return m_container->m_time[m_channel]; }
+    void set_time_short(short t) override { m_container->m_time[m_channel] = t; }
+    short get_time_short() override { return short(m_container->m_time[m_channel]); }
+    void set_energy(float energy) override { m_container->m_energy[m_channel] = energy; }
+    float get_energy() override { return m_container->m_energy[m_channel]; }
+    void set_chi2(float chi2) override { m_container->m_chi2[m_channel] = chi2; }
+    float get_chi2() override { return m_container->m_chi2[m_channel]; }
+    void set_pedestal(float pedestal) override { m_container->m_pedestal[m_channel] = pedestal; }
+    float get_pedestal() override { return m_container->m_pedestal[m_channel]; }
+
+    void set_isHot(bool isHot) override { set_status_bit(kHot, isHot); }
+    bool get_isHot() const override { return get_status_bit(kHot); }
+    void set_FitStatus(bool fitstatus) override { set_status_bit(kFitStatus, fitstatus); }
+    bool get_FitStatus() const override { return get_status_bit(kFitStatus); }
+    void set_isBadChi2(bool isBadChi2) override { set_status_bit(kBadChi2, isBadChi2); }
+    bool get_isBadChi2() const override { return get_status_bit(kBadChi2); }
+    void set_isNotInstr(bool isNotInstr) override { set_status_bit(kNotInstr, isNotInstr); }
+    bool get_isNotInstr() const override { return get_status_bit(kNotInstr); }
+    void set_isNoCalib(bool isNoCalib) override { set_status_bit(kNoCalib, isNoCalib); }
+    bool get_isNoCalib() const override { return get_status_bit(kNoCalib); }
+    void set_isZS(bool isZS) override { set_status_bit(kZS, isZS); }
+    bool get_isZS() const override { return get_status_bit(kZS); }
+    void set_isRecovered(bool isRecovered) override { set_status_bit(kRecovered, isRecovered); }
+    bool get_isRecovered() const override { return get_status_bit(kRecovered); }
+    void set_isSaturated(bool isSaturated) override { set_status_bit(kSaturated, isSaturated); }
+    bool get_isSaturated() const override { return get_status_bit(kSaturated); }
+
+    bool get_isGood() const override { return !get_status_bit(kHot | kBadChi2 | kNoCalib | kNotInstr); }
+
+    uint8_t get_status() const override { return m_container->m_status[m_channel]; }
+    void set_status(uint8_t status) override { m_container->m_status[m_channel] = status; }
+
+    void copy_tower(TowerInfo *tower) override;
+
+   private:
+    void set_status_bit(uint8_t mask, bool value)
+    {
+      uint8_t &status = m_container->m_status[m_channel];
+      status = value ? (status | mask) : (status & ~mask);
+    }
+
+    bool get_status_bit(uint8_t mask) const { return (m_container->m_status[m_channel] & mask) != 0; }
+
+    TowerInfoContainerv6 *m_container{nullptr};
+    std::size_t m_channel{0};
+  };
+
+  TowerInfoContainerv6(DETECTOR detec);
+
+  // default constructor for ROOT IO
+  TowerInfoContainerv6() = default;
+  PHObject *CloneMe() const override { return new TowerInfoContainerv6(*this); }
+  TowerInfoContainerv6(const TowerInfoContainerv6 &);
+  TowerInfoContainerv6 &operator=(const TowerInfoContainerv6 &) = delete;
+
+  ~TowerInfoContainerv6() override = default;
+
+  void identify(std::ostream &os = std::cout) const override;
+
+  void Reset() override;
+  TowerInfo *get_tower_at_channel(int pos) override;
+  TowerInfo *get_tower_at_key(int pos) override;
+
+  size_t size() const override { return m_energy.size(); }
+  DETECTOR get_detectorid() const override { return m_detector; }
+
+  // whole detector arrays, indexed by channel
+  std::span<float> get_energy_span() { return m_energy; }
+  std::span<const float> get_energy_span() const { return m_energy; }
+  std::span<float> get_time_span() { return m_time; }
+  std::span<const float> get_time_span() const { return m_time; }
+  std::span<float> get_chi2_span() { return m_chi2; }
+  std::span<const float> get_chi2_span() const { return m_chi2; }
+  std::span<float> get_pedestal_span() { return m_pedestal; }
+  std::span<const float> get_pedestal_span() const { return m_pedestal; }
+  std::span<uint8_t> get_status_span() { return m_status; }
+  std::span<const uint8_t> get_status_span() const { return m_status; }
+
+ private:
+  // create the tower views, done on first access since the arrays are resized by ROOT IO
+  void make_views();
+
+  DETECTOR m_detector{DETECTOR_INVALID};
+  std::vector<float> m_energy;
+  std::vector<float> m_time;
+  std::vector<float> m_chi2;
+  std::vector<float> m_pedestal;
+  std::vector<uint8_t> m_status;
+
+  std::vector<TowerView> m_views;  //! transient
+
+  ClassDefOverride(TowerInfoContainerv6, 1);
+};
+
+#endif
@@ -9,6 +9,7 @@
 #include <calobase/TowerInfoContainerv2.h>
 #include <calobase/TowerInfoContainerv3.h>
 #include <calobase/TowerInfoContainerv4.h>
+#include <calobase/TowerInfoContainerv6.h>
 
 #include <ffarawobjects/CaloPacket.h>
 #include <ffarawobjects/CaloPacketContainer.h>
@@ -67,6 +68,10 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
 {
   WaveformProcessing->set_processing_type(_processingtype);
   WaveformProcessing->set_softwarezerosuppression(m_bdosoftwarezerosuppression, m_nsoftwarezerosuppression);
+  if (m_nthreads > 0)
+  {
+    WaveformProcessing->set_nthreads(m_nthreads);
+  }
   if (m_setTimeLim)
   {
     WaveformProcessing->set_timeFitLim(m_timeLim_low, m_timeLim_high);
@@ -669,6 +674,10 @@ void CaloTowerBuilder::CreateNodeTree(PHCompositeNode *topNode)
   {
     m_CaloInfoContainer = new TowerInfoContainerSimv1(DetectorEnum);
   }
+  else if (m_buildertype == CaloTowerDefs::kPRDFTowerv6)
+  {
+    m_CaloInfoContainer = new TowerInfoContainerv6(DetectorEnum);
+  }
   else
   {
     std::cout << PHWHERE << "invalid builder type " << m_buildertype << std::endl;
@@ -94,6 +94,12 @@ public:
     m_dobitfliprecovery = dobitfliprecovery;
   }
 
+  // number of threads used for the waveform processing
+  void set_nthreads(int nthreads)
+  {
+    m_nthreads = nthreads;
+  }
+
   // Functional fit options: 0 = PowerLawExp, 1 = PowerLawDoubleExp
   void set_funcfit_type(int type)
   {
@@ -162,6 +168,7 @@ private:
   float m_timeLim_low{-3.0};
   float m_timeLim_high{4.0};
   bool m_dobitfliprecovery{false};
+  int m_nthreads{0};  // 0: keep the CaloWaveformProcessing setting
 
   int m_saturation{16383};
   std::string calibdir;
@@ -9,12 +9,15 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
 class TowerInfoContainer;
+class TowerInfoContainerv6;
 
 class CaloTowerCalib : public SubsysReco
 {
@@ -161,6 +164,9 @@ class CaloTowerCalib : public SubsysReco
 
   void LoadCalib(PHCompositeNode *topNode);
 
+  // calibrate all towers of a structure of arrays container in one pass
+  void process_batch(const TowerInfoContainerv6 *raw_towers, TowerInfoContainerv6 *calib_towers) const;
+
   struct CDBInfo
   {
     float calibconst{0};
@@ -169,6 +175,14 @@ class CaloTowerCalib : public SubsysReco
   };
 
   std::vector<CDBInfo> m_cdbInfo_vec;
+
+  // the same constants as flat arrays for process_batch,
+  // with the ZS cross calibration and the time calibration flags folded in.
+  // The cross calibration is 1 when not applied
+  std::vector<float> m_gain_vec;
+  std::vector<float> m_crosscalib_ZS_vec;
+  std::vector<float> m_meantime_vec;
+  std::vector<uint8_t> m_status_vec;
 };
 
 #endif  // CALOTOWERBUILDER_H
@@ -3,6 +3,7 @@
 
 #include <calobase/TowerInfo.h>  // for TowerInfo
 #include <calobase/TowerInfoContainer.h>
+#include <calobase/TowerInfoContainerv6.h>
 
 #include <cdbobjects/CDBTTree.h>  // for CDBTTree
 
@@ -173,65 +174,86 @@ void CaloTowerStatus::LoadCalib(CDBTTree *cdbttree_chi2, CDBTTree *cdbttree_hotM
       }
     }
   }
-}
 
-//____________________________________________________________________________..
-int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
-{
-  unsigned int ntowers = m_raw_towers->size();
-  float fraction_badChi2 = 0;
-  int hotMap_val = 0;
-  float z_score = 0;
+  m_hot_status_vec.resize(ntowers);
   for (unsigned int channel = 0; channel < ntowers; channel++)
   {
-    // only reset what we will set
-    m_raw_towers->get_tower_at_channel(channel)->set_isHot(false);
-    m_raw_towers->get_tower_at_channel(channel)->set_isBadChi2(false);
+    m_hot_status_vec[channel] = is_hot(channel) ? TowerInfoContainerv6::kHot : 0;
+  }
+}
 
-    if (m_doHotChi2)
-    {
-      fraction_badChi2 = m_cdbInfo_vec[channel].fraction_badChi2;
-    }
-    if (m_doHotMap)
+bool CaloTowerStatus::is_hot(unsigned int channel) const
+{
+  const CDBInfo &info = m_cdbInfo_vec[channel];
+  if (m_doHotChi2 && info.fraction_badChi2 > fraction_badChi2_threshold)
+  {
+    return true;
+  }
+  if (m_doHotMap)
+  {
+    // 1. Default behavior: rely on valid positive hotMap status codes only
+    if (z_score_threshold == z_score_threshold_default)
     {
-      hotMap_val = m_cdbInfo_vec[channel].hotMap_val;
-      z_score = m_cdbInfo_vec[channel].z_score;
+      return info.hotMap_val > 0;
     }
-    float chi2 = m_raw_towers->get_tower_at_channel(channel)->get_chi2();
-    float adc = m_raw_towers->get_tower_at_channel(channel)->get_energy();
+    // 2. Custom behavior: evaluate based on the custom z_score threshold
+    bool is_dead = (info.hotMap_val == 1);
+    bool exceeds_zscore_limit = (std::abs(info.z_score) > z_score_threshold);                           // Captures both hot and cold by sigma
+    bool is_low_yield_cold = (info.hotMap_val == 3 && info.z_score >= -1 * z_score_threshold_default);  // Captures the mean-based cold towers
 
-    if (fraction_badChi2 > fraction_badChi2_threshold && m_doHotChi2)
-    {
-      m_raw_towers->get_tower_at_channel(channel)->set_isHot(true);
-    }
-    if (m_doHotMap)
-    {
-      bool is_hot_tower = false;
+    return is_dead || exceeds_zscore_limit || is_low_yield_cold;
+  }
+  return false;
+}
 
-      // 1. Default behavior: rely on valid positive hotMap status codes only
-      if (z_score_threshold == z_score_threshold_default)
-      {
-        is_hot_tower = (hotMap_val > 0);
-      }
-      // 2. Custom behavior: evaluate based on the custom z_score threshold
-      else
-      {
-        bool is_dead = (hotMap_val == 1);
-        bool exceeds_zscore_limit = (std::abs(z_score) > z_score_threshold);                      // Captures both hot and cold by sigma
-        bool is_low_yield_cold = (hotMap_val == 3 && z_score >= -1 * z_score_threshold_default);  // Captures the mean-based cold towers
+void CaloTowerStatus::process_batch(TowerInfoContainerv6 *towers) const
+{
+  const std::size_t ntowers = towers->size();
+  const float *energy = towers->get_energy_span().data();
+  const float *chi2 = towers->get_chi2_span().data();
+  uint8_t *status = towers->get_status_span().data();
+  const uint8_t *hot_status = m_hot_status_vec.data();
+
+  const uint8_t reset_mask = static_cast<uint8_t>(~(TowerInfoContainerv6::kHot | TowerInfoContainerv6::kBadChi2));
+
+  // same result as the tower by tower loop in process_event, the hot towers
+  // come from the CDB and only the chi2 cut depends on the event.
+  // Written without branches so that it gets vectorized
+#pragma omp simd
+  for (std::size_t channel = 0; channel < ntowers; ++channel)
+  {
+    const float adc = energy[channel];
+    const float threshold = std::min(std::max(badChi2_treshold_const, adc * adc * badChi2_treshold_quadratic), badChi2_treshold_max);
+    const uint8_t badChi2 = (chi2[channel] > threshold) ? TowerInfoContainerv6::kBadChi2 : 0;
+    status[channel] = (status[channel] & reset_mask) | hot_status[channel] | badChi2;
+  }
+}
 
-        is_hot_tower = (is_dead || exceeds_zscore_limit || is_low_yield_cold);
-      }
+//____________________________________________________________________________..
+int CaloTowerStatus::process_event(PHCompositeNode * /*topNode*/)
+{
+  unsigned int ntowers = m_raw_towers->size();
 
-      // Apply the result
-      if (is_hot_tower)
-      {
-        m_raw_towers->get_tower_at_channel(channel)->set_isHot(true);
-      }
-    }
+  auto *soa_towers = dynamic_cast<TowerInfoContainerv6 *>(m_raw_towers);
+  if (soa_towers)
+  {
+    process_batch(soa_towers);
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    TowerInfo *tower = m_raw_towers->get_tower_at_channel(channel);
+
+    // only reset what we will set
+    tower->set_isHot(m_hot_status_vec[channel] != 0);
+    tower->set_isBadChi2(false);
+
+    float chi2 = tower->get_chi2();
+    float adc = tower->get_energy();
     if (chi2 > std::min(std::max(badChi2_treshold_const, adc * adc * badChi2_treshold_quadratic), badChi2_treshold_max))
     {
-      m_raw_towers->get_tower_at_channel(channel)->set_isBadChi2(true);
+      tower->set_isBadChi2(true);
     }
   }
   return Fun4AllReturnCodes::EVENT_OK;
@@ -7,12 +7,14 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 class CDBTTree;
 class PHCompositeNode;
 class TowerInfoContainer;
+class TowerInfoContainerv6;
 
 class CaloTowerStatus : public SubsysReco
 {
@@ -123,6 +125,12 @@ class CaloTowerStatus : public SubsysReco
 
   void LoadCalib(CDBTTree *cdbttree_chi2, CDBTTree *cdbttree_hotMap);
 
+  // isHot from the CDB information of one channel
+  bool is_hot(unsigned int channel) const;
+
+  // set the status of all towers of a structure of arrays container in one pass
+  void process_batch(TowerInfoContainerv6 *towers) const;
+
   struct CDBInfo
   {
     float fraction_badChi2{0};
@@ -131,6 +139,9 @@ class CaloTowerStatus : public SubsysReco
   };
 
   std::vector<CDBInfo> m_cdbInfo_vec;
+
+  // isHot bit from the CDB per channel, it does not change during the run
+  std::vector<uint8_t> m_hot_status_vec;
 };
 
 #endif  // CALOTOWERBUILDER_H
@@ -1,4 +1,5 @@
 #include "CaloWaveformFitting.h"
+#include "CaloWaveformTemplateFitter.h"
 
 #include <TF1.h>
 #include <TFile.h>
@@ -21,9 +22,9 @@
 #include <algorithm>
 #include <iostream>
 #include <limits>
+#include <numeric>
 #include <string>
 
-static ROOT::TThreadExecutor *t = new ROOT::TThreadExecutor(1);  // NOLINT(misc-use-anonymous-namespace)
 double CaloWaveformFitting::template_function(double *x, double *par)
 {
   Double_t v1 = (par[0] * h_template->Interpolate(x[0] - par[1])) + par[2];
@@ -32,9 +33,32 @@ double CaloWaveformFitting::template_function(double *x, double *par)
 
 CaloWaveformFitting::~CaloWaveformFitting()
 {
+  delete m_threadExecutor;
+  delete m_templateFitter;
   delete h_template;
 }
 
+void CaloWaveformFitting::for_each_channel(const std::function<void(unsigned int)> &func, unsigned int nchannels)
+{
+  if (_nthreads <= 1)
+  {
+    for (unsigned int i = 0; i < nchannels; ++i)
+    {
+      func(i);
+    }
+    return;
+  }
+  if (!m_threadExecutor || m_threadExecutor_nthreads != _nthreads)
+  {
+    delete m_threadExecutor;
+    m_threadExecutor = new ROOT::TThreadExecutor(_nthreads);
+    m_threadExecutor_nthreads = _nthreads;
+  }
+  std::vector<unsigned int> channels(nchannels);
+  std::iota(channels.begin(), channels.end(), 0);
+  m_threadExecutor->Foreach(func, channels);
+}
+
 void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
 {
   TFile *fin = TFile::Open(templatefile.c_str());
@@ -45,7 +69,7 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   fin->Close();
   delete fin;
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
-  t = new ROOT::TThreadExecutor(_nthreads);
+  m_templateFitter = new CaloWaveformTemplateFitter(h_template);
 }
 
 std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vector<std::vector<float>> waveformvector)
@@ -295,7 +319,9 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
     }
   };
 
-  t->Foreach(func, chnlvector);
+  for_each_channel([&](unsigned int ich)
+                   { func(chnlvector[ich]); },
+                   chnlvector.size());
   int size3 = chnlvector.size();
   std::vector<std::vector<float>> fit_params;
   std::vector<float> fit_params_tmp;
@@ -314,6 +340,113 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
   return fit_params;
 }
 
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit_fast(const std::vector<std::vector<float>> &chnlvector)
+{
+  // results are written by channel index, the output order does not depend on the threads
+  std::vector<std::vector<float>> fit_values(chnlvector.size());
+  for_each_channel([&](unsigned int ich)
+                   { fit_values[ich] = templatefit_fast(chnlvector[ich]); },
+                   chnlvector.size());
+  return fit_values;
+}
+
+std::vector<float> CaloWaveformFitting::templatefit_fast(const std::vector<float> &v) const
+{
+  int size1 = v.size();
+  if (size1 == _nzerosuppresssamples)
+  {
+    // returns peak sample - pedestal sample, time is qnan for ZS
+    // check if post-sample is 0, if so set high chi2
+    float chi2 = (v.at(0) != 0 && v.at(1) == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+    return {v.at(1) - v.at(0), std::numeric_limits<float>::quiet_NaN(), v.at(0), chi2, 0, 0};
+  }
+
+  float maxheight = 0;
+  int maxbin = 0;
+  for (int i = 0; i < size1; i++)
+  {
+    if (v.at(i) > maxheight)
+    {
+      maxheight = v.at(i);
+      maxbin = i;
+    }
+  }
+  float pedestal = 1500;
+  if (maxbin > 4)
+  {
+    pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
+  }
+  else if (maxbin > 3)
+  {
+    pedestal = (v.at(maxbin - 4));
+  }
+  else
+  {
+    pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
+  }
+
+  if ((_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression))
+  {
+    float chi2 = (v.at(0) != 0 && v.at(1) == 0) ? 1000000 : std::numeric_limits<float>::quiet_NaN();
+    return {v.at(6) - v.at(0), std::numeric_limits<float>::quiet_NaN(), v.at(0), chi2, 0, 0};
+  }
+
+  // drop saturated samples from the fit
+  std::vector<unsigned char> use(size1, 1);
+  int ndata = 0;
+  for (int i = 0; i < size1; ++i)
+  {
+    if ((v.at(i) == 16383) && _handleSaturation)
+    {
+      use[i] = 0;
+      continue;
+    }
+    ndata++;
+  }
+  // if too many are saturated don't do the saturation recovery need enough ndf
+  if (ndata < (size1 - 4))
+  {
+    ndata = size1;
+    std::fill(use.begin(), use.end(), 1);
+  }
+
+  double tmin = -1 * m_peakTimeTemp;
+  double tmax = size1 - m_peakTimeTemp;
+  if (m_setTimeLim)
+  {
+    tmin = m_timeLim_low;
+    tmax = m_timeLim_high;
+  }
+  CaloWaveformTemplateFitter::Result fitres = m_templateFitter->fit(v.data(), use.data(), size1, tmin, tmax);
+  double chi2min = fitres.chi2 / (ndata - 3);  // divide by the number of dof
+
+  if (chi2min > _chi2threshold && (fitres.pedestal < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (fitres.pedestal > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery)
+  {
+    std::vector<float> rv(v);  // temporary recovered waveform
+    unsigned int bits[3] = {8192, 4096, 2048};
+    for (auto bit : bits)
+    {
+      for (int i = 0; i < size1; i++)
+      {
+        if (((unsigned int) rv.at(i) & bit) && ((unsigned int) rv.at(i) % bit > _bfr_lowpedestalthreshold))
+        {
+          rv.at(i) = rv.at(i) - bit;
+        }
+      }
+    }
+    CaloWaveformTemplateFitter::Result recover_fitres = m_templateFitter->fit(rv.data(), nullptr, size1, -1 * m_peakTimeTemp, size1 - m_peakTimeTemp);
+    double recover_chi2min = recover_fitres.chi2 / (size1 - 3);  // divide by the number of dof
+    if (recover_chi2min < _chi2lowthreshold && recover_fitres.pedestal < _bfr_highpedestalthreshold && recover_fitres.pedestal > _bfr_lowpedestalthreshold)
+    {
+      return {static_cast<float>(recover_fitres.amplitude), static_cast<float>(recover_fitres.time), static_cast<float>(recover_fitres.pedestal),
+              static_cast<float>(recover_chi2min), 1, static_cast<float>(recover_fitres.status)};
+    }
+  }
+
+  return {static_cast<float>(fitres.amplitude), static_cast<float>(fitres.time), static_cast<float>(fitres.pedestal),
+          static_cast<float>(chi2min), 0, static_cast<float>(fitres.status)};
+}
+
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
 {
   int n = 3;
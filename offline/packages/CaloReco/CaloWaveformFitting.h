@@ -1,11 +1,18 @@
 #ifndef CALORECO_CALOWAVEFORMFITTING_H
 #define CALORECO_CALOWAVEFORMFITTING_H
 
+#include <functional>
 #include <string>
 #include <vector>
 
+class CaloWaveformTemplateFitter;
 class TProfile;
 
+namespace ROOT
+{
+  class TThreadExecutor;
+}
+
 class CaloWaveformFitting
 {
  public:
@@ -25,6 +32,7 @@ class CaloWaveformFitting
     return;
   }
 
+  //! number of threads used to fit the channels of one call to calo_processing_templatefit(_fast)
   void set_nthreads(int nthreads)
   {
     _nthreads = nthreads;
@@ -66,6 +74,9 @@ class CaloWaveformFitting
 
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
   std::vector<std::vector<float>> calo_processing_templatefit(std::vector<std::vector<float>> chnlvector);
+  // same as calo_processing_templatefit using CaloWaveformTemplateFitter instead of TF1 fits
+  // the input waveforms do not carry the channel index
+  std::vector<std::vector<float>> calo_processing_templatefit_fast(const std::vector<std::vector<float>> &chnlvector);
   static std::vector<std::vector<float>> calo_processing_fast(const std::vector<std::vector<float>> &chnlvector);
   std::vector<std::vector<float>> calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector);
   std::vector<std::vector<float>> calo_processing_funcfit(const std::vector<std::vector<float>> &chnlvector);
@@ -107,8 +118,15 @@ class CaloWaveformFitting
 
   static float psinc(float t, std::vector<float> &vec_signal_samples);
   double template_function(double *x, double *par);
+  std::vector<float> templatefit_fast(const std::vector<float> &v) const;
+  // run func for channels 0..nchannels-1, on _nthreads threads
+  void for_each_channel(const std::function<void(unsigned int)> &func, unsigned int nchannels);
+
+  ROOT::TThreadExecutor *m_threadExecutor{nullptr};
+  int m_threadExecutor_nthreads{0};
 
   TProfile *h_template{nullptr};
+  CaloWaveformTemplateFitter *m_templateFitter{nullptr};
   double m_peakTimeTemp{0};
   int _nthreads{1};
   int _nzerosuppresssamples{2};
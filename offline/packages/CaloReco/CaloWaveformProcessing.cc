@@ -5,12 +5,16 @@
 
 #include <phool/onnxlib.h>
 
+#include <ROOT/TThreadExecutor.hxx>
+#include <TROOT.h>
+
 #include <algorithm>  // for max
 #include <cassert>
 #include <cstdlib>  // for getenv
 #include <iostream>
 #include <limits>
 #include <memory>  // for allocator_traits<>::value_type
+#include <numeric>
 #include <string>
 
 namespace
@@ -20,6 +24,7 @@ namespace
 
 CaloWaveformProcessing::~CaloWaveformProcessing()
 {
+  delete m_threadExecutor;
   delete m_Fitter;
 }
 
@@ -27,7 +32,7 @@ void CaloWaveformProcessing::initialize_processing()
 {
   char *calibrationsroot = getenv("CALIBRATIONROOT");
   assert(calibrationsroot);
-  if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT || m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST)
   {
     std::string calibrations_repo_template = std::string(calibrationsroot) + "/WaveformProcessing/templates/" + m_template_input_file;
     url_template = CDBInterface::instance()->getUrl(m_template_name, calibrations_repo_template);
@@ -37,7 +42,8 @@ void CaloWaveformProcessing::initialize_processing()
     {
       m_Fitter->set_handleSaturation(false);
     }
-    m_Fitter->set_nthreads(get_nthreads());
+    // the waveforms are distributed over threads here, each block is fitted serially
+    m_Fitter->set_nthreads(1);
     if (m_setTimeLim)
     {
       m_Fitter->set_timeFitLim(m_timeLim_low, m_timeLim_high);
@@ -78,19 +84,85 @@ void CaloWaveformProcessing::initialize_processing()
     }
     m_Fitter->set_handleSaturation(true);
   }
+  // the TF1 based fits (TEMPLATE, TEMPLATE_NOSAT and FUNCFIT) register named histograms
+  // and functions and go through the shared ROOT fitter, they stay serial like ONNX
+  const bool threadsafe = m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST ||
+                          m_processingtype == CaloWaveformProcessing::FAST ||
+                          m_processingtype == CaloWaveformProcessing::NYQUIST;
+  if (_nthreads > 1 && threadsafe)
+  {
+    ROOT::EnableThreadSafety();
+    delete m_threadExecutor;
+    m_threadExecutor = new ROOT::TThreadExecutor(_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "CaloWaveformProcessing::initialize_processing - using " << _nthreads << " threads" << std::endl;
+    }
+  }
 }
 
 std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
 {
   unsigned int size1 = waveformvector.size();
-  std::vector<std::vector<float>> fitresults;
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
   {
+    // the channel index is appended before splitting, it stays unique across blocks
     for (unsigned int i = 0; i < size1; i++)
     {
       waveformvector.at(i).push_back((float) i);
     }
-    fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
+  }
+
+  unsigned int nblocks = m_threadExecutor ? std::min<unsigned int>(_nthreads, size1) : 1;
+  if (nblocks <= 1)
+  {
+    return process_block(waveformvector);
+  }
+
+  // split into contiguous blocks, one per thread. Each block has its own
+  // input and output buffers, the results are concatenated in block order
+  // so the output ordering does not depend on the thread scheduling
+  std::vector<std::vector<std::vector<float>>> blocks(nblocks);
+  std::vector<std::vector<std::vector<float>>> blockresults(nblocks);
+  unsigned int first = 0;
+  for (unsigned int ib = 0; ib < nblocks; ib++)
+  {
+    unsigned int last = first + (size1 - first) / (nblocks - ib);
+    blocks[ib].reserve(last - first);
+    for (unsigned int i = first; i < last; i++)
+    {
+      blocks[ib].push_back(std::move(waveformvector[i]));
+    }
+    first = last;
+  }
+  std::vector<unsigned int> blockindex(nblocks);
+  std::iota(blockindex.begin(), blockindex.end(), 0);
+  m_threadExecutor->Foreach([&](unsigned int ib)
+                            { blockresults[ib] = process_block(blocks[ib]); },
+                            blockindex);
+
+  std::vector<std::vector<float>> fitresults;
+  fitresults.reserve(size1);
+  for (auto &blockresult : blockresults)
+  {
+    for (auto &result : blockresult)
+    {
+      fitresults.push_back(std::move(result));
+    }
+  }
+  return fitresults;
+}
+
+std::vector<std::vector<float>> CaloWaveformProcessing::process_block(std::vector<std::vector<float>> &waveformvector)
+{
+  std::vector<std::vector<float>> fitresults;
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE || m_processingtype == CaloWaveformProcessing::TEMPLATE_NOSAT)
+  {
+    fitresults = m_Fitter->calo_processing_templatefit(std::move(waveformvector));
+  }
+  if (m_processingtype == CaloWaveformProcessing::TEMPLATE_FAST)
+  {
+    fitresults = m_Fitter->calo_processing_templatefit_fast(waveformvector);
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
@@ -214,18 +286,10 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(con
 
 int CaloWaveformProcessing::get_nthreads()
 {
-  if (m_Fitter)
-  {
-    return m_Fitter->get_nthreads();
-  }
   return _nthreads;
 }
 void CaloWaveformProcessing::set_nthreads(int nthreads)
 {
   _nthreads = nthreads;
-  if (m_Fitter)
-  {
-    m_Fitter->set_nthreads(nthreads);
-  }
   return;
 }
@@ -9,6 +9,11 @@
 
 class CaloWaveformFitting;
 
+namespace ROOT
+{
+  class TThreadExecutor;
+}
+
 class CaloWaveformProcessing : public SubsysReco
 {
  public:
@@ -21,6 +26,7 @@ class CaloWaveformProcessing : public SubsysReco
     NYQUIST = 4,
     TEMPLATE_NOSAT = 5,
     FUNCFIT = 6,
+    TEMPLATE_FAST = 7,
   };
 
   CaloWaveformProcessing() = default;
@@ -54,6 +60,9 @@ class CaloWaveformProcessing : public SubsysReco
     return;
   }
 
+  //! number of threads the waveforms of an event are distributed over
+  //! (TEMPLATE_FAST, FAST and NYQUIST, the other methods are serial).
+  //! Has to be set before initialize_processing()
   void set_nthreads(int nthreads);
 
   int get_nthreads();
@@ -106,7 +115,11 @@ class CaloWaveformProcessing : public SubsysReco
   void set_onnx_offset(const int i, const double val) { m_Onnx_offset.at(i) = val; }
 
  private:
+  // process a contiguous block of waveforms with the selected method
+  std::vector<std::vector<float>> process_block(std::vector<std::vector<float>> &waveformvector);
+
   CaloWaveformFitting *m_Fitter{nullptr};
+  ROOT::TThreadExecutor *m_threadExecutor{nullptr};
 
   CaloWaveformProcessing::process m_processingtype{CaloWaveformProcessing::TEMPLATE};
   int _nthreads{1};
@@ -0,0 +1,136 @@
+#include "CaloWaveformTemplateFitter.h"
+
+#include <TProfile.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+CaloWaveformTemplateFitter::CaloWaveformTemplateFitter(const TProfile *h_template)
+{
+  assert(h_template);
+  const int nbins = h_template->GetNbinsX();
+  assert(nbins > 1);
+  m_table.reserve(nbins);
+  for (int i = 1; i <= nbins; ++i)
+  {
+    m_table.push_back(h_template->GetBinContent(i));
+  }
+  m_xfirst = h_template->GetBinCenter(1);
+  m_xlast = h_template->GetBinCenter(nbins);
+  m_invstep = (nbins - 1) / (m_xlast - m_xfirst);
+  m_peaktime = h_template->GetBinCenter(h_template->GetMaximumBin());
+}
+
+double CaloWaveformTemplateFitter::profile_chi2(const float *samples, const unsigned char *use, int nsamples, double time, double &amplitude, double &pedestal) const
+{
+  // linear least squares for y = amplitude * T + pedestal
+  double sw = 0;
+  double st = 0;
+  double stt = 0;
+  double sy = 0;
+  double sty = 0;
+  double syy = 0;
+  for (int i = 0; i < nsamples; ++i)
+  {
+    if (use && !use[i])
+    {
+      continue;
+    }
+    const double tval = eval(i - time);
+    const double y = samples[i];
+    sw += 1;
+    st += tval;
+    stt += tval * tval;
+    sy += y;
+    sty += tval * y;
+    syy += y * y;
+  }
+  const double det = sw * stt - st * st;
+  if (std::abs(det) > std::numeric_limits<double>::epsilon() * sw * stt)
+  {
+    amplitude = (sw * sty - st * sy) / det;
+    pedestal = (stt * sy - st * sty) / det;
+  }
+  else
+  {
+    // flat template in the fit window, only the pedestal is defined
+    amplitude = 0;
+    pedestal = sw > 0 ? sy / sw : 0;
+  }
+
+  // residual sum of squares at the least squares solution
+  return std::max(0., syy - amplitude * sty - pedestal * sy);
+}
+
+CaloWaveformTemplateFitter::Result CaloWaveformTemplateFitter::fit(const float *samples, const unsigned char *use, int nsamples, double tmin, double tmax) const
+{
+  Result result;
+  if (tmax < tmin)
+  {
+    std::swap(tmin, tmax);
+  }
+
+  double amplitude = 0;
+  double pedestal = 0;
+
+  // scan the allowed time range
+  const int nsteps = std::max(1, static_cast<int>(std::ceil((tmax - tmin) / m_scanstep)));
+  const double step = (tmax - tmin) / nsteps;
+  int best = 0;
+  double bestchi2 = std::numeric_limits<double>::max();
+  for (int i = 0; i <= nsteps; ++i)
+  {
+    const double chi2 = profile_chi2(samples, use, nsamples, tmin + i * step, amplitude, pedestal);
+    if (chi2 < bestchi2)
+    {
+      bestchi2 = chi2;
+      best = i;
+    }
+  }
+
+  // golden section search around the best scan point
+  static const double invphi = (std::sqrt(5.) - 1) / 2;
+  double a = std::max(tmin, tmin + (best - 1) * step);
+  double b = std::min(tmax, tmin + (best + 1) * step);
+  double c = b - invphi * (b - a);
+  double d = a + invphi * (b - a);
+  double fc = profile_chi2(samples, use, nsamples, c, amplitude, pedestal);
+  double fd = profile_chi2(samples, use, nsamples, d, amplitude, pedestal);
+  while (b - a > m_tolerance)
+  {
+    if (fc < fd)
+    {
+      b = d;
+      d = c;
+      fd = fc;
+      c = b - invphi * (b - a);
+      fc = profile_chi2(samples, use, nsamples, c, amplitude, pedestal);
+    }
+    else
+    {
+      a = c;
+      c = d;
+      fc = fd;
+      d = a + invphi * (b - a);
+      fd = profile_chi2(samples, use, nsamples, d, amplitude, pedestal);
+    }
+  }
+
+  // keep the scan point if the refinement did not improve on it
+  double time = 0.5 * (a + b);
+  double chi2 = profile_chi2(samples, use, nsamples, time, amplitude, pedestal);
+  if (chi2 > bestchi2)
+  {
+    time = tmin + best * step;
+    chi2 = profile_chi2(samples, use, nsamples, time, amplitude, pedestal);
+  }
+
+  result.amplitude = amplitude;
+  result.time = time;
+  result.pedestal = pedestal;
+  result.chi2 = chi2;
+  result.status = std::isfinite(chi2) ? 0 : 1;
+  return result;
+}
@@ -0,0 +1,85 @@
+#ifndef CALORECO_CALOWAVEFORMTEMPLATEFITTER_H
+#define CALORECO_CALOWAVEFORMTEMPLATEFITTER_H
+
+#include <vector>
+
+class TProfile;
+
+//! template fit of a waveform without ROOT fitting machinery
+/*!
+ * The model is amplitude * template(t - time) + pedestal, with the
+ * template tabulated once from the TProfile bin contents and evaluated
+ * with the same linear interpolation as TProfile::Interpolate.
+ *
+ * For a fixed time the amplitude and pedestal follow from a linear least
+ * squares solution, so only the time is minimized numerically: a scan
+ * over the allowed range followed by a golden section refinement.
+ * The fitter has no mutable state, fit() can be called from many threads.
+ */
+class CaloWaveformTemplateFitter
+{
+ public:
+  struct Result
+  {
+    double amplitude{0};
+    double time{0};
+    double pedestal{0};
+    //! chi2 (not divided by the number of degrees of freedom)
+    double chi2{0};
+    //! 0 for a successful fit
+    int status{0};
+  };
+
+  explicit CaloWaveformTemplateFitter(const TProfile *h_template);
+
+  //! template value at t, same as TProfile::Interpolate
+  double eval(double t) const
+  {
+    if (t <= m_xfirst)
+    {
+      return m_table.front();
+    }
+    if (t >= m_xlast)
+    {
+      return m_table.back();
+    }
+    const double u = (t - m_xfirst) * m_invstep;
+    const unsigned int k = static_cast<unsigned int>(u);
+    const double frac = u - k;
+    return m_table[k] + (m_table[k + 1] - m_table[k]) * frac;
+  }
+
+  //! peak position of the template
+  double peak_time() const { return m_peaktime; }
+
+  //! fit samples, sample i is at time i
+  /*!
+   * @param samples    adc values
+   * @param use        if not null, only samples with use[i] != 0 enter the fit
+   * @param nsamples   number of samples
+   * @param tmin,tmax  allowed range of the time parameter
+   */
+  Result fit(const float *samples, const unsigned char *use, int nsamples, double tmin, double tmax) const;
+
+  //! step of the initial time scan, in samples
+  void set_scan_step(double step) { m_scanstep = step; }
+
+  //! time tolerance of the refinement, in samples
+  void set_tolerance(double tol) { m_tolerance = tol; }
+
+ private:
+  //! best amplitude and pedestal for a fixed time, returns chi2
+  double profile_chi2(const float *samples, const unsigned char *use, int nsamples, double time, double &amplitude, double &pedestal) const;
+
+  //! template contents at the bin centers
+  std::vector<double> m_table;
+  double m_xfirst{0};
+  double m_xlast{0};
+  double m_invstep{1};
+  double m_peaktime{0};
+
+  double m_scanstep{0.1};
+  double m_tolerance{1e-4};
+};
+
+#endif
@@ -0,0 +1,164 @@
+// compares the TEMPLATE_FAST fit (CaloWaveformTemplateFitter) with the TF1 based TEMPLATE fit
+// on synthetic waveforms: regular pulses, saturated pulses, bit flips and zero suppressed channels
+
+#include "CaloWaveformFitting.h"
+
+#include <TFile.h>
+#include <TProfile.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr int nsamples = 12;
+  constexpr float saturation = 16383;
+
+  // tolerances on the fit results, TEMPLATE_FAST minus TEMPLATE
+  constexpr double amplitude_tolerance = 1e-3;  // relative, plus one adc count
+  constexpr double time_tolerance = 0.01;       // samples
+  constexpr double pedestal_tolerance = 1;      // adc counts
+  constexpr double chi2_tolerance = 1e-2;       // relative, the fast fit must not be worse
+
+  // pulse shape with its maximum, 1, at t = 4
+  double shape(const double t)
+  {
+    if (t <= 0)
+    {
+      return 0;
+    }
+    constexpr double power = 4;
+    constexpr double decay = 1;
+    return std::pow(t / (power * decay), power) * std::exp(power - t / decay);
+  }
+
+  void write_template(const std::string &filename)
+  {
+    TFile f(filename.c_str(), "RECREATE");
+    TProfile h("waveform_template", "", 3100, -0.5, 30.5);
+    for (int i = 1; i <= h.GetNbinsX(); ++i)
+    {
+      const double t = h.GetBinCenter(i);
+      h.Fill(t, shape(t - 1));
+    }
+    h.Write();
+    f.Close();
+  }
+
+  struct Waveform
+  {
+    std::string type;
+    std::vector<float> samples;
+  };
+
+  std::vector<Waveform> make_waveforms()
+  {
+    std::mt19937 rng(4321);
+    std::uniform_real_distribution<double> amplitude(100, 8000);
+    std::uniform_real_distribution<double> pedestal(1300, 1700);
+    std::uniform_real_distribution<double> time(1, 4);
+    std::normal_distribution<double> noise(0, 3);
+
+    const auto pulse = [&](double a, double p, double t0)
+    {
+      std::vector<float> v(nsamples);
+      for (int i = 0; i < nsamples; ++i)
+      {
+        v[i] = std::min<float>(saturation, std::round(p + a * shape(i - t0) + noise(rng)));
+      }
+      return v;
+    };
+
+    std::vector<Waveform> waveforms;
+    for (int i = 0; i < 200; ++i)
+    {
+      waveforms.push_back({"pulse", pulse(amplitude(rng), pedestal(rng), time(rng))});
+    }
+
+    // one to three samples above the saturation
+    for (int i = 0; i < 50; ++i)
+    {
+      waveforms.push_back({"saturated", pulse(16000 + 100 * i, pedestal(rng), time(rng))});
+    }
+
+    // bit 8192 set on a pedestal sample, small enough pulses that no other sample is modified by the recovery
+    for (int i = 0; i < 50; ++i)
+    {
+      auto v = pulse(100 + 5 * i, 1500, time(rng));
+      v[i % 2] += 8192;
+      waveforms.push_back({"bitflip", v});
+    }
+
+    // zero suppressed: pre and post sample only
+    for (int i = 0; i < 20; ++i)
+    {
+      const float p = std::round(pedestal(rng));
+      waveforms.push_back({"zs", {p, i % 5 ? p + 10 * i : 0}});
+    }
+    return waveforms;
+  }
+
+  bool same(const float a, const float b, const double tolerance)
+  {
+    if (std::isnan(a) || std::isnan(b))
+    {
+      return std::isnan(a) && std::isnan(b);
+    }
+    return std::abs(a - b) <= tolerance;
+  }
+}  // namespace
+
+int main()
+{
+  const std::string filename = "testtemplatefit.root";
+  write_template(filename);
+
+  CaloWaveformFitting fitter;
+  fitter.initialize_processing(filename);
+  fitter.set_handleSaturation(true);
+  fitter.set_bitFlipRecovery(true);
+
+  const auto waveforms = make_waveforms();
+
+  // TEMPLATE expects the channel index as last entry
+  std::vector<std::vector<float>> input;
+  std::vector<std::vector<float>> input_fast;
+  for (std::size_t i = 0; i < waveforms.size(); ++i)
+  {
+    input_fast.push_back(waveforms[i].samples);
+    input.push_back(waveforms[i].samples);
+    input.back().push_back(i);
+  }
+
+  const auto results = fitter.calo_processing_templatefit(input);
+  const auto results_fast = fitter.calo_processing_templatefit_fast(input_fast);
+
+  int failures = 0;
+  for (std::size_t i = 0; i < waveforms.size(); ++i)
+  {
+    // amplitude, time, pedestal, chi2/ndf, bit flip recovered, fit status
+    const auto &r = results[i];
+    const auto &f = results_fast[i];
+    const bool ok = same(f[0], r[0], amplitude_tolerance * std::abs(r[0]) + 1) &&
+                    same(f[1], r[1], time_tolerance) &&
+                    same(f[2], r[2], pedestal_tolerance) &&
+                    (std::isnan(r[3]) ? std::isnan(f[3]) : f[3] <= r[3] * (1 + chi2_tolerance) + chi2_tolerance) &&
+                    f[4] == r[4];
+    if (!ok)
+    {
+      std::cout << "testtemplatefit - " << waveforms[i].type << " waveform " << i << " differs:"
+                << " TEMPLATE " << r[0] << " " << r[1] << " " << r[2] << " " << r[3] << " " << r[4]
+                << " TEMPLATE_FAST " << f[0] << " " << f[1] << " " << f[2] << " " << f[3] << " " << f[4] << std::endl;
+      ++failures;
+    }
+  }
+
+  std::remove(filename.c_str());
+  std::cout << "testtemplatefit - " << waveforms.size() << " waveforms, " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
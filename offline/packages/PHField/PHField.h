@@ -3,6 +3,10 @@
 
 // units of this class. To convert internal value to Geant4/CLHEP units for fast access
 
+#include <cstddef>
+
+struct PHFieldCell;
+
 //! \brief transient object for field storage and access
 class PHField
 {
@@ -30,6 +34,32 @@ class PHField
       double *Bfield) const
   { return GetFieldValue( Point, Bfield ); }
 
+  //! batch access
+  /* same thread safety as GetFieldValue. By default, GetFieldValue is called for each point */
+  //! @param[in]  n       number of points
+  //! @param[in]  Points  n space time coordinates, packed as x, y, z, t
+  //! @param[out] Bfields n field values, packed as Bx, By, Bz
+  virtual void GetFieldValues(
+      std::size_t n,
+      const double *Points,
+      double *Bfields) const
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      GetFieldValue(Points + 4 * i, Bfields + 3 * i);
+    }
+  }
+
+  //! interpolation cell containing a point, for the field caches of the Geant4 and Acts adapters
+  /* only provided by maps interpolated on a regular grid, must be thread safe.
+     By default, and for points outside of the map, returns false */
+  //! @param[in]  Point   space time coordinate. x, y, z, t in Geant4/CLHEP units
+  //! @param[out] cell    the cell, valid if true is returned
+  virtual bool GetFieldCell(
+      const double /*Point*/[4],
+      PHFieldCell & /*cell*/) const
+  { return false; }
+
   //! verbosity
   void Verbosity(const int i) { m_Verbosity = i; }
 
@@ -18,10 +18,6 @@
 
 PHField2D::PHField2D(const std::string &filename, const int verb, const float magfield_rescale)
   : PHField(verb)
-  , r_index0_cache(0)
-  , r_index1_cache(0)
-  , z_index0_cache(0)
-  , z_index1_cache(0)
 {
   if (Verbosity() > 0)
   {
@@ -146,17 +142,11 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
   maxz_ = *ziter;
 
   // initialize maps
-  nz = z_set.size();
-  nr = r_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
+  z_map_.set(z_set.begin(), z_set.end());
+  r_map_.set(r_set.begin(), r_set.end());
 
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<float>(nr, 0));
-  BFieldZ_.resize(nz, std::vector<float>(nr, 0));
+  // initialize the field map to the correct size
+  m_field.assign(z_map_.size() * r_map_.size() * kNComponents, 0);
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0;
@@ -190,8 +180,8 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
       std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
     }
 
-    BFieldR_[iz][ir] = Br * magfield_rescale;
-    BFieldZ_[iz][ir] = Bz * magfield_rescale;
+    m_field[index(iz, ir, kBr)] = Br * magfield_rescale;
+    m_field[index(iz, ir, kBz)] = Bz * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -203,8 +193,8 @@ PHField2D::PHField2D(const std::string &filename, const int verb, const float ma
       std::cout << " B("
                 << r_map_[ir] << ", "
                 << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir] << ", "
-                << BFieldZ_[iz][ir] << ")" << std::endl;
+                << m_field[index(iz, ir, kBr)] << ", "
+                << m_field[index(iz, ir, kBz)] << ")" << std::endl;
     }
 
   }  // end loop over root field map file
@@ -284,64 +274,14 @@ void PHField2D::GetFieldValue(const double point[4], double *Bfield) const
 
 void PHField2D::GetFieldValue_nocache(const double point[4], double *Bfield) const
 {
-  if (Verbosity() > 2)
-  {
-    std::cout << "\nPHField2D::GetFieldValue" << std::endl;
-  }
-  double x = point[0];
-  double y = point[1];
-  double z = point[2];
-  double r = sqrt(x * x + y * y);
-  double phi;
-  phi = atan2(y, x);
-  if (phi < 0)
-  {
-    phi += 2 * M_PI;  // normalize phi to be over the range [0,2*pi]
-  }
-
-  // Check that the point is within the defined z region (check r in a second)
-  if ((z >= minz_) && (z <= maxz_))
-  {
-    double BFieldCyl[3];
-    double cylpoint[4] = {z, r, phi, 0};
-
-    // take <z,r,phi> location and return a vector of <Bz, Br, Bphi>
-    GetFieldCyl_nocache(cylpoint, BFieldCyl);
-
-    // X direction of B-field ( Bx = Br*cos(phi) - Bphi*sin(phi)
-    Bfield[0] = cos(phi) * BFieldCyl[1] - sin(phi) * BFieldCyl[2];  // unit vector transformations
-
-    // Y direction of B-field ( By = Br*sin(phi) + Bphi*cos(phi)
-    Bfield[1] = sin(phi) * BFieldCyl[1] + cos(phi) * BFieldCyl[2];
-
-    // Z direction of B-field
-    Bfield[2] = BFieldCyl[0];
-  }
-  else  // x,y,z is outside of z range of the field map
-  {
-    Bfield[0] = 0.0;
-    Bfield[1] = 0.0;
-    Bfield[2] = 0.0;
-    if (Verbosity() > 2)
-    {
-      std::cout << "!!!!!!!!!! Field point not in defined region (outside of z bounds)" << std::endl;
-    }
-  }
-
-  if (Verbosity() > 2)
-  {
-    std::cout << "END PHField2D::GetFieldValue\n"
-              << "  --->  {Bx, By, Bz} : "
-              << "< " << Bfield[0] << ", " << Bfield[1] << ", " << Bfield[2] << " >" << std::endl;
-  }
-
-  return;
+  // there is no cache, the lookup is thread safe
+  GetFieldValue(point, Bfield);
 }
 
 void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
 {
-  float z = CylPoint[0];
-  float r = CylPoint[1];
+  const double z = CylPoint[0];
+  const double r = CylPoint[1];
 
   BfieldCyl[0] = 0.0;
   BfieldCyl[1] = 0.0;
@@ -352,7 +292,7 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     std::cout << "GetFieldCyl@ <z,r>: {" << z << "," << r << "}" << std::endl;
   }
 
-  if (z < z_map_[0] || z > z_map_[z_map_.size() - 1])
+  if (z < z_map_.front() || z > z_map_.back())
   {
     if (Verbosity() > 2)
     {
@@ -361,151 +301,9 @@ void PHField2D::GetFieldCyl(const double CylPoint[4], double *BfieldCyl) const
     return;
   }
 
-  // since GEANT4 looks up the field ~95% of the time in the same voxel
-  // between subsequent calls, we can save on the expense of the upper_bound
-  // lookup (~10-15% of central event run time) with some caching between calls
-  unsigned int r_index0 = r_index0_cache;
-  unsigned int r_index1 = r_index1_cache;
-
-  if (!((r > r_map_[r_index0]) && (r < r_map_[r_index1])))
-  {
-    // if miss cached r values, search through the lookup table
-    std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-    r_index0 = distance(r_map_.begin(), riter) - 1;
-    if (r_index0 >= r_map_.size())
-    {
-      if (Verbosity() > 2)
-      {
-        std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-      }
-      return;
-    }
-
-    r_index1 = r_index0 + 1;
-    if (r_index1 >= r_map_.size())
-    {
-      if (Verbosity() > 2)
-      {
-        std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-      }
-      return;
-    }
-
-    // update cache
-    r_index0_cache = r_index0;
-    r_index1_cache = r_index1;
-  }
-
-  unsigned int z_index0 = z_index0_cache;
-  unsigned int z_index1 = z_index1_cache;
-
-  if (!((z > z_map_[z_index0]) && (z < z_map_[z_index1])))
-  {
-    // if miss cached z values, search through the lookup table
-    std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-    z_index0 = distance(z_map_.begin(), ziter) - 1;
-    z_index1 = z_index0 + 1;
-    if (z_index1 >= z_map_.size())
-    {
-      if (Verbosity() > 2)
-      {
-        std::cout << "!!!! Point not in defined region (z too large in specific r-plane)" << std::endl;
-      }
-      return;
-    }
-
-    // update cache
-    z_index0_cache = z_index0;
-    z_index1_cache = z_index1;
-  }
-
-  double Br000 = BFieldR_[z_index0][r_index0];
-  double Br010 = BFieldR_[z_index0][r_index1];
-  double Br100 = BFieldR_[z_index1][r_index0];
-  double Br110 = BFieldR_[z_index1][r_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0];
-  double Bz100 = BFieldZ_[z_index1][r_index0];
-  double Bz010 = BFieldZ_[z_index0][r_index1];
-  double Bz110 = BFieldZ_[z_index1][r_index1];
-
-  double zweight = z - z_map_[z_index0];
-  double zspacing = z_map_[z_index1] - z_map_[z_index0];
-  zweight /= zspacing;
-
-  double rweight = r - r_map_[r_index0];
-  double rspacing = r_map_[r_index1] - r_map_[r_index0];
-  rweight /= rspacing;
-
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * Bz000 +
-                       rweight * Bz010) +
-      zweight * ((1 - rweight) * Bz100 +
-                 rweight * Bz110);
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * Br000 +
-                       rweight * Br010) +
-      zweight * ((1 - rweight) * Br100 +
-                 rweight * Br110);
-
-  // PHI Direction of B-field
-  BfieldCyl[2] = 0;
-
-  if (Verbosity() > 2)
-  {
-    std::cout << "End GFCyl Call: <bz,br,bphi> : {"
-              << BfieldCyl[0] / gauss << "," << BfieldCyl[1] / gauss << "," << BfieldCyl[2] / gauss << "}"
-              << std::endl;
-  }
-
-  return;
-}
-
-
-void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl) const
-{
-  float z = CylPoint[0];
-  float r = CylPoint[1];
-
-  BfieldCyl[0] = 0.0;
-  BfieldCyl[1] = 0.0;
-  BfieldCyl[2] = 0.0;
-
-  if (Verbosity() > 2)
-  {
-    std::cout << "GetFieldCyl@ <z,r>: {" << z << "," << r << "}" << std::endl;
-  }
-
-  if (z < z_map_[0] || z > z_map_[z_map_.size() - 1])
-  {
-    if (Verbosity() > 2)
-    {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-    }
-    return;
-  }
-
-  // since GEANT4 looks up the field ~95% of the time in the same voxel
-  // between subsequent calls, we can save on the expense of the upper_bound
-  // lookup (~10-15% of central event run time) with some caching between calls
-
-  // if miss cached r values, search through the lookup table
-  std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  const unsigned int r_index0 = distance(r_map_.begin(), riter) - 1;
-  if (r_index0 >= r_map_.size())
-  {
-    if (Verbosity() > 2)
-    {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-    }
-    return;
-  }
-
-  const unsigned int r_index1 = r_index0 + 1;
-  if (r_index1 >= r_map_.size())
+  // r must be in [r_0, r_N[
+  const long r_index0 = r_map_.find(r);
+  if (r_index0 < 0 || r_index0 + 1 >= static_cast<long>(r_map_.size()))
   {
     if (Verbosity() > 2)
     {
@@ -514,11 +312,9 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
     return;
   }
 
-  // if miss cached z values, search through the lookup table
-  std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  const unsigned int z_index0 = distance(z_map_.begin(), ziter) - 1;
-  const unsigned int z_index1 = z_index0 + 1;
-  if (z_index1 >= z_map_.size())
+  // z must be in [z_0, z_N[
+  const long z_index0 = z_map_.find(z);
+  if (z_index0 < 0 || z_index0 + 1 >= static_cast<long>(z_map_.size()))
   {
     if (Verbosity() > 2)
     {
@@ -527,37 +323,26 @@ void PHField2D::GetFieldCyl_nocache(const double CylPoint[4], double *BfieldCyl)
     return;
   }
 
-  double Br000 = BFieldR_[z_index0][r_index0];
-  double Br010 = BFieldR_[z_index0][r_index1];
-  double Br100 = BFieldR_[z_index1][r_index0];
-  double Br110 = BFieldR_[z_index1][r_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0];
-  double Bz100 = BFieldZ_[z_index1][r_index0];
-  double Bz010 = BFieldZ_[z_index0][r_index1];
-  double Bz110 = BFieldZ_[z_index1][r_index1];
-
-  double zweight = z - z_map_[z_index0];
-  double zspacing = z_map_[z_index1] - z_map_[z_index0];
-  zweight /= zspacing;
+  // the two r nodes of a z plane are neighbors in memory
+  const float *b0 = &m_field[index(z_index0, r_index0, 0)];
+  const float *b1 = &m_field[index(z_index0 + 1, r_index0, 0)];
 
-  double rweight = r - r_map_[r_index0];
-  double rspacing = r_map_[r_index1] - r_map_[r_index0];
-  rweight /= rspacing;
+  const double zweight = z_map_.weight(z, z_index0);
+  const double rweight = r_map_.weight(r, r_index0);
 
   // Z direction of B-field
   BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * Bz000 +
-                       rweight * Bz010) +
-      zweight * ((1 - rweight) * Bz100 +
-                 rweight * Bz110);
+      (1 - zweight) * ((1 - rweight) * b0[kBz] +
+                       rweight * b0[kNComponents + kBz]) +
+      zweight * ((1 - rweight) * b1[kBz] +
+                 rweight * b1[kNComponents + kBz]);
 
   // R direction of B-field
   BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * Br000 +
-                       rweight * Br010) +
-      zweight * ((1 - rweight) * Br100 +
-                 rweight * Br110);
+      (1 - zweight) * ((1 - rweight) * b0[kBr] +
+                       rweight * b0[kNComponents + kBr]) +
+      zweight * ((1 - rweight) * b1[kBr] +
+                 rweight * b1[kNComponents + kBr]);
 
   // PHI Direction of B-field
   BfieldCyl[2] = 0;
@@ -3,7 +3,9 @@
 #define PHFIELD_PHFIELD2D_H
 
 #include "PHField.h"
+#include "PHFieldGridAxis.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <tuple>
@@ -27,35 +29,37 @@ class PHField2D : public PHField
 
   void GetFieldCyl(const double CylPoint[4], double *Bfield) const;
 
-  void GetFieldCyl_nocache(const double CylPoint[4], double *Bfield) const;
+  //! same as GetFieldCyl, there is no cache anymore
+  void GetFieldCyl_nocache(const double CylPoint[4], double *Bfield) const
+  { GetFieldCyl(CylPoint, Bfield); }
 
   protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<float> > BFieldZ_;
-  std::vector<std::vector<float> > BFieldR_;
-  std::vector<std::vector<float> > BFieldPHI_;
+  //! field components stored per node
+  enum
+  {
+    kBz = 0,
+    kBr = 1,
+    kNComponents = 2
+  };
 
-  // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float> z_map_;    // < i >
-  std::vector<float> r_map_;    // < j >
-  std::vector<float> phi_map_;  // < k >
+  //! flat index of field component for node <iz, ir>
+  std::size_t index(std::size_t iz, std::size_t ir, std::size_t comp) const
+  {
+    return (iz * r_map_.size() + ir) * kNComponents + comp;
+  }
+
+  //! field values, one contiguous array with the components of a node next to each other
+  std::vector<float> m_field;
+
+  // grid axes z_map[i] = z_value that corresponds to ith index
+  PHFieldGridAxis z_map_;    // < i >
+  PHFieldGridAxis r_map_;    // < j >
 
   float maxz_, minz_;  // boundaries of magnetic field map cyl
   double magfield_unit;
 
  private:
   void print_map(std::map<trio, trio>::iterator &it) const;
-  // mutable allows to change internal data even in const methods
-  // I don't like this too much but these are cached values to speed up
-  // the field lookup by a lot
-  // I want them to be data members so we can run 2 fieldmaps in parallel
-  // and still have caching. Putting those as static variables into
-  // the implementation will prevent this
-
-  mutable unsigned int r_index0_cache;
-  mutable unsigned int r_index1_cache;
-  mutable unsigned int z_index0_cache;
-  mutable unsigned int z_index1_cache;
 };
 
 #endif
@@ -0,0 +1,311 @@
+#include "PHField3DCartesianGrid.h"
+#include "PHFieldCell.h"
+
+#include <phool/phool.h>
+
+#include <TFile.h>
+#include <TNtuple.h>
+#include <TSystem.h>
+
+#include <Geant4/G4SystemOfUnits.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+
+namespace
+{
+  //! check that a sorted set of axis values is equidistant
+  bool is_regular(const std::set<float> &vals, const double step)
+  {
+    const double vmin = *vals.begin();
+    std::size_t i = 0;
+    for (const auto &val : vals)
+    {
+      if (std::abs(val - (vmin + i * step)) > 1e-3 * step)
+      {
+        return false;
+      }
+      ++i;
+    }
+    return true;
+  }
+
+  //! cell below a fractional node index in [0, nodes-1], clamped to the last cell
+  inline std::size_t cell_index(const double f, const std::size_t nodes)
+  {
+    const std::size_t i = f > 0. ? static_cast<std::size_t>(std::ceil(f)) - 1 : 0;
+    return std::min<std::size_t>(i, nodes - 2);
+  }
+}  // namespace
+
+PHField3DCartesianGrid::PHField3DCartesianGrid(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+  : filename(fname)
+{
+  std::cout << "PHField3DCartesianGrid::PHField3DCartesianGrid" << std::endl;
+  std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
+  std::cout << "\n-----------------------------------------------------------"
+            << "\n      Magnetic field Module - Verbosity:"
+            << "\n-----------------------------------------------------------";
+
+  // open file
+  TFile *rootinput = TFile::Open(filename.c_str());
+  if (!rootinput)
+  {
+    std::cout << "\n could not open " << filename << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+  std::cout << "\n ---> "
+               "Reading the field grid from "
+            << filename << " ... " << std::endl;
+
+  //  get root NTuple objects
+  TNtuple *field_map = nullptr;
+  rootinput->GetObject("fieldmap", field_map);
+  if (field_map == nullptr)
+  {
+    std::cout << PHWHERE << " Could not load fieldmap ntuple from "
+              << filename << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+  Float_t ROOT_X;
+  Float_t ROOT_Y;
+  Float_t ROOT_Z;
+  Float_t ROOT_BX;
+  Float_t ROOT_BY;
+  Float_t ROOT_BZ;
+  field_map->SetBranchAddress("x", &ROOT_X);
+  field_map->SetBranchAddress("y", &ROOT_Y);
+  field_map->SetBranchAddress("z", &ROOT_Z);
+  field_map->SetBranchAddress("bx", &ROOT_BX);
+  field_map->SetBranchAddress("by", &ROOT_BY);
+  field_map->SetBranchAddress("bz", &ROOT_BZ);
+
+  // first pass: find the axes
+  std::set<float> xvals;
+  std::set<float> yvals;
+  std::set<float> zvals;
+  const Long64_t nentries = field_map->GetEntries();
+  for (Long64_t i = 0; i < nentries; i++)
+  {
+    field_map->GetEntry(i);
+    xvals.insert(ROOT_X * cm);
+    yvals.insert(ROOT_Y * cm);
+    zvals.insert(ROOT_Z * cm);
+  }
+
+  if (xvals.size() < 2 || yvals.size() < 2 || zvals.size() < 2)
+  {
+    std::cout << PHWHERE << " need at least 2 grid points per axis in "
+              << filename << " exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+
+  m_nx = xvals.size();
+  m_ny = yvals.size();
+  m_nz = zvals.size();
+
+  m_xmin = *xvals.begin();
+  m_xmax = *xvals.rbegin();
+  m_ymin = *yvals.begin();
+  m_ymax = *yvals.rbegin();
+  m_zmin = *zvals.begin();
+  m_zmax = *zvals.rbegin();
+
+  const double xstepsize = (m_xmax - m_xmin) / (m_nx - 1);
+  const double ystepsize = (m_ymax - m_ymin) / (m_ny - 1);
+  const double zstepsize = (m_zmax - m_zmin) / (m_nz - 1);
+  if (!is_regular(xvals, xstepsize) || !is_regular(yvals, ystepsize) || !is_regular(zvals, zstepsize))
+  {
+    std::cout << PHWHERE << " field map " << filename
+              << " is not on a regular grid, use PHFieldConfig::Field3DCartesian instead. exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+  m_xinvstep = 1. / xstepsize;
+  m_yinvstep = 1. / ystepsize;
+  m_zinvstep = 1. / zstepsize;
+
+  // second pass: fill the grid
+  const std::size_t nnodes = m_nx * m_ny * m_nz;
+  m_bx.assign(nnodes, 0);
+  m_by.assign(nnodes, 0);
+  m_bz.assign(nnodes, 0);
+  std::vector<uint8_t> present(nnodes, 0);
+  for (Long64_t i = 0; i < nentries; i++)
+  {
+    field_map->GetEntry(i);
+    const double x = ROOT_X * cm;
+    const double y = ROOT_Y * cm;
+    const double z = ROOT_Z * cm;
+    const double r = std::sqrt(x * x + y * y);
+    if ((r >= innerradius && r <= outerradius) || std::abs(z) > size_z)
+    {
+      const std::size_t ix = std::lround((x - m_xmin) * m_xinvstep);
+      const std::size_t iy = std::lround((y - m_ymin) * m_yinvstep);
+      const std::size_t iz = std::lround((z - m_zmin) * m_zinvstep);
+      const std::size_t idx = index(ix, iy, iz);
+      m_bx[idx] = ROOT_BX * tesla * magfield_rescale;
+      m_by[idx] = ROOT_BY * tesla * magfield_rescale;
+      m_bz[idx] = ROOT_BZ * tesla * magfield_rescale;
+      present[idx] = 1;
+    }
+  }
+
+  // flag cells with all 8 corners present
+  m_cell_valid.assign(nnodes, 0);
+  std::size_t invalid_cells = 0;
+  const std::size_t sx = m_ny * m_nz;
+  const std::size_t sy = m_nz;
+  for (std::size_t ix = 0; ix + 1 < m_nx; ++ix)
+  {
+    for (std::size_t iy = 0; iy + 1 < m_ny; ++iy)
+    {
+      for (std::size_t iz = 0; iz + 1 < m_nz; ++iz)
+      {
+        const std::size_t idx = index(ix, iy, iz);
+        const bool valid = present[idx] && present[idx + 1] &&
+                           present[idx + sy] && present[idx + sy + 1] &&
+                           present[idx + sx] && present[idx + sx + 1] &&
+                           present[idx + sx + sy] && present[idx + sx + sy + 1];
+        m_cell_valid[idx] = valid;
+        if (!valid)
+        {
+          ++invalid_cells;
+        }
+      }
+    }
+  }
+
+  std::cout << " ---> grid " << m_nx << " x " << m_ny << " x " << m_nz
+            << " nodes, " << invalid_cells << " cells outside the selected volume" << std::endl;
+
+  delete field_map;
+  delete rootinput;
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+//_____________________________________________________________
+void PHField3DCartesianGrid::GetFieldValue(const double point[4], double *Bfield) const
+{
+  GetFieldValues(1, point, Bfield);
+}
+
+//_____________________________________________________________
+void PHField3DCartesianGrid::GetFieldValue_nocache(const double point[4], double *Bfield) const
+{
+  GetFieldValues(1, point, Bfield);
+}
+
+//_____________________________________________________________
+void PHField3DCartesianGrid::GetFieldValues(std::size_t n, const double *Points, double *Bfields) const
+{
+  const float *bx = m_bx.data();
+  const float *by = m_by.data();
+  const float *bz = m_bz.data();
+  const uint8_t *cell_valid = m_cell_valid.data();
+
+  const std::size_t sx = m_ny * m_nz;
+  const std::size_t sy = m_nz;
+
+  // the loop body is branch free so that it can be vectorized.
+  // points outside the map, non finite points and points in cells with
+  // missing nodes get a zero weight
+#pragma omp simd
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double x = Points[4 * i];
+    const double y = Points[4 * i + 1];
+    const double z = Points[4 * i + 2];
+
+    // false for NaN
+    const bool inside = x >= m_xmin && x <= m_xmax &&
+                        y >= m_ymin && y <= m_ymax &&
+                        z >= m_zmin && z <= m_zmax;
+
+    const double fx = inside ? (x - m_xmin) * m_xinvstep : 0.;
+    const double fy = inside ? (y - m_ymin) * m_yinvstep : 0.;
+    const double fz = inside ? (z - m_zmin) * m_zinvstep : 0.;
+
+    // a point on a grid plane belongs to the cell below it,
+    // like in the map based PHField3DCartesian. Points on the upper edge
+    // can round past the last node, they belong to the last cell
+    const std::size_t ix = cell_index(fx, m_nx);
+    const std::size_t iy = cell_index(fy, m_ny);
+    const std::size_t iz = cell_index(fz, m_nz);
+
+    const double tx = fx - ix;
+    const double ty = fy - iy;
+    const double tz = fz - iz;
+
+    const std::size_t i000 = (ix * m_ny + iy) * m_nz + iz;
+    const double weight = (inside && cell_valid[i000]) ? 1. : 0.;
+
+    const auto interpolate = [&](const float *b)
+    {
+      const double c00 = b[i000] * (1. - tx) + b[i000 + sx] * tx;
+      const double c10 = b[i000 + sy] * (1. - tx) + b[i000 + sx + sy] * tx;
+      const double c01 = b[i000 + 1] * (1. - tx) + b[i000 + sx + 1] * tx;
+      const double c11 = b[i000 + sy + 1] * (1. - tx) + b[i000 + sx + sy + 1] * tx;
+      const double c0 = c00 * (1. - ty) + c10 * ty;
+      const double c1 = c01 * (1. - ty) + c11 * ty;
+      return weight * (c0 * (1. - tz) + c1 * tz);
+    };
+
+    Bfields[3 * i] = interpolate(bx);
+    Bfields[3 * i + 1] = interpolate(by);
+    Bfields[3 * i + 2] = interpolate(bz);
+  }
+}
+
+//_____________________________________________________________
+bool PHField3DCartesianGrid::GetFieldCell(const double Point[4], PHFieldCell &cell) const
+{
+  const double x = Point[0];
+  const double y = Point[1];
+  const double z = Point[2];
+
+  // false for NaN
+  if (!(x >= m_xmin && x <= m_xmax &&
+        y >= m_ymin && y <= m_ymax &&
+        z >= m_zmin && z <= m_zmax))
+  {
+    return false;
+  }
+
+  // same cell as in GetFieldValues
+  const double fx = (x - m_xmin) * m_xinvstep;
+  const double fy = (y - m_ymin) * m_yinvstep;
+  const double fz = (z - m_zmin) * m_zinvstep;
+  const std::size_t ix = cell_index(fx, m_nx);
+  const std::size_t iy = cell_index(fy, m_ny);
+  const std::size_t iz = cell_index(fz, m_nz);
+
+  cell.origin[0] = m_xmin;
+  cell.origin[1] = m_ymin;
+  cell.origin[2] = m_zmin;
+  cell.invstep[0] = m_xinvstep;
+  cell.invstep[1] = m_yinvstep;
+  cell.invstep[2] = m_zinvstep;
+  cell.index[0] = static_cast<int>(ix);
+  cell.index[1] = static_cast<int>(iy);
+  cell.index[2] = static_cast<int>(iz);
+
+  // cells with missing nodes have a zero field
+  const std::size_t i000 = index(ix, iy, iz);
+  const bool valid = m_cell_valid[i000];
+  for (std::size_t corner = 0; corner < 8; ++corner)
+  {
+    const std::size_t idx = i000 + (corner >> 2U) * m_ny * m_nz + ((corner >> 1U) & 1U) * m_nz + (corner & 1U);
+    cell.field[corner][0] = valid ? m_bx[idx] : 0.;
+    cell.field[corner][1] = valid ? m_by[idx] : 0.;
+    cell.field[corner][2] = valid ? m_bz[idx] : 0.;
+  }
+  return true;
+}
@@ -0,0 +1,87 @@
+#ifndef PHFIELD_PHFIELD3DCARTESIANGRID_H
+#define PHFIELD_PHFIELD3DCARTESIANGRID_H
+
+#include "PHField.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//! 3D Cartesian field map stored on a dense regular grid
+/*!
+ * Reads the same ntuple as PHField3DCartesian, but stores the field
+ * components in three contiguous arrays (structure of arrays) indexed by
+ * (ix*ny + iy)*nz + iz. Cell lookup is pure index arithmetic, there is no
+ * mutable state, so all accessors are thread safe.
+ *
+ * Grid nodes which were removed by the inner/outer radius selection are
+ * flagged as missing, and any point whose interpolation cell touches such a
+ * node returns a zero field, matching the map based implementation.
+ */
+class PHField3DCartesianGrid : public PHField
+{
+ public:
+  //! constructor
+  explicit PHField3DCartesianGrid(const std::string &fname, const float magfield_rescale = 1.0, const float innerradius = 0, const float outerradius = 1.e10, const float size_z = 1.e10);
+
+  //! destructor
+  ~PHField3DCartesianGrid() override = default;
+
+  //! access field value
+  //! Follow the convention of G4ElectroMagneticField
+  //! @param[in]  Point   space time coordinate. x, y, z, t in Geant4/CLHEP units
+  //! @param[out] Bfield  field value. In the case of magnetic field, the order is Bx, By, Bz in in Geant4/CLHEP units
+  void GetFieldValue(const double Point[4], double *Bfield) const override;
+
+  //! there is no cache, same as GetFieldValue
+  void GetFieldValue_nocache(const double Point[4], double *Bfield) const override;
+
+  //! batch access
+  //! @param[in]  n       number of points
+  //! @param[in]  Points  n space time coordinates, packed as x, y, z, t
+  //! @param[out] Bfields n field values, packed as Bx, By, Bz
+  void GetFieldValues(std::size_t n, const double *Points, double *Bfields) const override;
+
+  //! interpolation cell containing Point, false outside of the map
+  bool GetFieldCell(const double Point[4], PHFieldCell &cell) const override;
+
+ private:
+  //! flat index of grid node
+  std::size_t index(std::size_t ix, std::size_t iy, std::size_t iz) const
+  {
+    return (ix * m_ny + iy) * m_nz + iz;
+  }
+
+  std::string filename;
+
+  //! number of nodes along each axis
+  std::size_t m_nx {0};
+  std::size_t m_ny {0};
+  std::size_t m_nz {0};
+
+  //! grid origin
+  double m_xmin {0};
+  double m_ymin {0};
+  double m_zmin {0};
+
+  //! grid end
+  double m_xmax {0};
+  double m_ymax {0};
+  double m_zmax {0};
+
+  //! inverse step sizes
+  double m_xinvstep {0};
+  double m_yinvstep {0};
+  double m_zinvstep {0};
+
+  //! field components, one entry per grid node
+  std::vector<float> m_bx;
+  std::vector<float> m_by;
+  std::vector<float> m_bz;
+
+  //! 1 if all 8 corners of the cell whose lower corner is this node are in the map
+  std::vector<uint8_t> m_cell_valid;
+};
+
+#endif
@@ -131,21 +131,12 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
   maxz_ = *ziter;
 
   // initialize maps
-  nz = z_set.size();
-  nr = r_set.size();
-  nphi = phi_set.size();
-  r_map_.resize(nr, 0);
-  z_map_.resize(nz, 0);
-  phi_map_.resize(nphi, 0);
-
-  std::copy(z_set.begin(), z_set.end(), z_map_.begin());
-  std::copy(phi_set.begin(), phi_set.end(), phi_map_.begin());
-  std::copy(r_set.begin(), r_set.end(), r_map_.begin());
-
-  // initialize the field map vectors to the correct sizes
-  BFieldR_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldPHI_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
-  BFieldZ_.resize(nz, std::vector<std::vector<float> >(nr, std::vector<float>(nphi, 0)));
+  z_map_.set(z_set.begin(), z_set.end());
+  r_map_.set(r_set.begin(), r_set.end());
+  phi_map_.set(phi_set.begin(), phi_set.end());
+
+  // initialize the field map to the correct size
+  m_field.assign(z_map_.size() * r_map_.size() * phi_map_.size() * kNComponents, 0);
 
   // all of this assumes that  z_prev < z , i.e. the table is ordered (as of right now)
   unsigned int ir = 0;
@@ -188,9 +179,9 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
       std::cout << "!!!!!!!!! Your map isn't ordered.... z: " << z << " zprev: " << z_map_[iz - 1] << std::endl;
     }
 
-    BFieldR_[iz][ir][iphi] = Br * magfield_rescale;
-    BFieldPHI_[iz][ir][iphi] = Bphi * magfield_rescale;
-    BFieldZ_[iz][ir][iphi] = Bz * magfield_rescale;
+    m_field[index(iz, ir, iphi, kBr)] = Br * magfield_rescale;
+    m_field[index(iz, ir, iphi, kBphi)] = Bphi * magfield_rescale;
+    m_field[index(iz, ir, iphi, kBz)] = Bz * magfield_rescale;
 
     // you can change this to check table values for correctness
     // print_map prints the values in the root table, and the
@@ -203,9 +194,9 @@ PHField3DCylindrical::PHField3DCylindrical(const std::string &filename, const in
                 << r_map_[ir] << ", "
                 << phi_map_[iphi] << ", "
                 << z_map_[iz] << "):  ("
-                << BFieldR_[iz][ir][iphi] << ", "
-                << BFieldPHI_[iz][ir][iphi] << ", "
-                << BFieldZ_[iz][ir][iphi] << ")" << std::endl;
+                << m_field[index(iz, ir, iphi, kBr)] << ", "
+                << m_field[index(iz, ir, iphi, kBphi)] << ", "
+                << m_field[index(iz, ir, iphi, kBz)] << ")" << std::endl;
     }
 
   }  // end loop over root field map file
@@ -299,7 +290,7 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
     std::cout << "GetFieldCyl@ <z,r,phi>: {" << z << "," << r << "," << phi << "}" << std::endl;
   }
 
-  if (z <= z_map_[0] || z >= z_map_[z_map_.size() - 1])
+  if (z <= z_map_.front() || z >= z_map_.back())
   {
     if (Verbosity() > 2)
     {
@@ -307,16 +298,16 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
     }
     return;
   }
-  if (r < r_map_[0])
+  if (r < r_map_.front())
   {
-    r = r_map_[0];
+    r = r_map_.front();
     if (Verbosity() > 2)
     {
       std::cout << "!!!! Point not in defined region (radius too small in specific z-plane). Use min radius" << std::endl;
     }
     //    return;
   }
-  if (r > r_map_[r_map_.size() - 1])
+  if (r > r_map_.back())
   {
     if (Verbosity() > 2)
     {
@@ -325,28 +316,15 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
     return;
   }
 
-  std::vector<float>::const_iterator ziter = upper_bound(z_map_.begin(), z_map_.end(), z);
-  int z_index0 = distance(z_map_.begin(), ziter) - 1;
-  int z_index1 = z_index0 + 1;
+  const long z_index0 = z_map_.find(z);
+  const long z_index1 = z_index0 + 1;
 
   assert(z_index0 >= 0);
-  assert(z_index1 >= 0);
-  assert(z_index0 < (int) z_map_.size());
-  assert(z_index1 < (int) z_map_.size());
-
-  std::vector<float>::const_iterator riter = upper_bound(r_map_.begin(), r_map_.end(), r);
-  int r_index0 = distance(r_map_.begin(), riter) - 1;
-  if (r_index0 >= (int) r_map_.size())
-  {
-    if (Verbosity() > 2)
-    {
-      std::cout << "!!!! Point not in defined region (radius too large in specific z-plane)" << std::endl;
-    }
-    return;
-  }
+  assert(z_index1 < (long) z_map_.size());
 
-  int r_index1 = r_index0 + 1;
-  if (r_index1 >= (int) r_map_.size())
+  const long r_index0 = r_map_.find(r);
+  const long r_index1 = r_index0 + 1;
+  if (r_index1 >= (long) r_map_.size())
   {
     if (Verbosity() > 2)
     {
@@ -356,94 +334,49 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   }
 
   assert(r_index0 >= 0);
-  assert(r_index1 >= 0);
 
-  std::vector<float>::const_iterator phiiter = upper_bound(phi_map_.begin(), phi_map_.end(), phi);
-  int phi_index0 = distance(phi_map_.begin(), phiiter) - 1;
-  int phi_index1 = phi_index0 + 1;
-  if (phi_index1 >= (int) phi_map_.size())
+  const long phi_index0 = phi_map_.find(phi);
+  long phi_index1 = phi_index0 + 1;
+  if (phi_index1 >= (long) phi_map_.size())
   {
     phi_index1 = 0;
   }
 
   assert(phi_index0 >= 0);
-  assert(phi_index0 < (int) phi_map_.size());
-  assert(phi_index1 >= 0);
-
-  double Br000 = BFieldR_[z_index0][r_index0][phi_index0];
-  double Br001 = BFieldR_[z_index0][r_index0][phi_index1];
-  double Br010 = BFieldR_[z_index0][r_index1][phi_index0];
-  double Br011 = BFieldR_[z_index0][r_index1][phi_index1];
-  double Br100 = BFieldR_[z_index1][r_index0][phi_index0];
-  double Br101 = BFieldR_[z_index1][r_index0][phi_index1];
-  double Br110 = BFieldR_[z_index1][r_index1][phi_index0];
-  double Br111 = BFieldR_[z_index1][r_index1][phi_index1];
-
-  double Bphi000 = BFieldPHI_[z_index0][r_index0][phi_index0];
-  double Bphi001 = BFieldPHI_[z_index0][r_index0][phi_index1];
-  double Bphi010 = BFieldPHI_[z_index0][r_index1][phi_index0];
-  double Bphi011 = BFieldPHI_[z_index0][r_index1][phi_index1];
-  double Bphi100 = BFieldPHI_[z_index1][r_index0][phi_index0];
-  double Bphi101 = BFieldPHI_[z_index1][r_index0][phi_index1];
-  double Bphi110 = BFieldPHI_[z_index1][r_index1][phi_index0];
-  double Bphi111 = BFieldPHI_[z_index1][r_index1][phi_index1];
-
-  double Bz000 = BFieldZ_[z_index0][r_index0][phi_index0];
-  double Bz001 = BFieldZ_[z_index0][r_index0][phi_index1];
-  double Bz100 = BFieldZ_[z_index1][r_index0][phi_index0];
-  double Bz101 = BFieldZ_[z_index1][r_index0][phi_index1];
-  double Bz010 = BFieldZ_[z_index0][r_index1][phi_index0];
-  double Bz110 = BFieldZ_[z_index1][r_index1][phi_index0];
-  double Bz011 = BFieldZ_[z_index0][r_index1][phi_index1];
-  double Bz111 = BFieldZ_[z_index1][r_index1][phi_index1];
-
-  double zweight = z - z_map_[z_index0];
-  double zspacing = z_map_[z_index1] - z_map_[z_index0];
-  zweight /= zspacing;
-
-  double rweight = r - r_map_[r_index0];
-  double rspacing = r_map_[r_index1] - r_map_[r_index0];
-  rweight /= rspacing;
+  assert(phi_index0 < (long) phi_map_.size());
+
+  // the 8 corners of the cell, each with its kNComponents field components next to each other
+  const float *b000 = &m_field[index(z_index0, r_index0, phi_index0, 0)];
+  const float *b001 = &m_field[index(z_index0, r_index0, phi_index1, 0)];
+  const float *b010 = &m_field[index(z_index0, r_index1, phi_index0, 0)];
+  const float *b011 = &m_field[index(z_index0, r_index1, phi_index1, 0)];
+  const float *b100 = &m_field[index(z_index1, r_index0, phi_index0, 0)];
+  const float *b101 = &m_field[index(z_index1, r_index0, phi_index1, 0)];
+  const float *b110 = &m_field[index(z_index1, r_index1, phi_index0, 0)];
+  const float *b111 = &m_field[index(z_index1, r_index1, phi_index1, 0)];
+
+  const double zweight = z_map_.weight(z, z_index0);
+  const double rweight = r_map_.weight(r, r_index0);
 
   double phiweight = phi - phi_map_[phi_index0];
-  double phispacing = phi_map_[phi_index1] - phi_map_[phi_index0];
   if (phi_index1 == 0)
   {
-    phispacing += 2 * M_PI;
+    phiweight /= phi_map_[0] + 2 * M_PI - phi_map_[phi_index0];
+  }
+  else
+  {
+    phiweight *= phi_map_.invwidth(phi_index0);
+  }
+
+  // Z, R and PHI directions of B-field
+  for (int comp = 0; comp < kNComponents; ++comp)
+  {
+    BfieldCyl[comp] =
+        (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * b000[comp] + phiweight * b001[comp]) +
+                         rweight * ((1 - phiweight) * b010[comp] + phiweight * b011[comp])) +
+        zweight * ((1 - rweight) * ((1 - phiweight) * b100[comp] + phiweight * b101[comp]) +
+                   rweight * ((1 - phiweight) * b110[comp] + phiweight * b111[comp]));
   }
-  phiweight /= phispacing;
-
-  // Z direction of B-field
-  BfieldCyl[0] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bz000 + phiweight * Bz001) +
-                       rweight * ((1 - phiweight) * Bz010 + phiweight * Bz011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bz100 + phiweight * Bz101) +
-                 rweight * ((1 - phiweight) * Bz110 + phiweight * Bz111));
-
-  // R direction of B-field
-  BfieldCyl[1] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Br000 + phiweight * Br001) +
-                       rweight * ((1 - phiweight) * Br010 + phiweight * Br011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Br100 + phiweight * Br101) +
-                 rweight * ((1 - phiweight) * Br110 + phiweight * Br111));
-
-  // PHI Direction of B-field
-  BfieldCyl[2] =
-      (1 - zweight) * ((1 - rweight) * ((1 - phiweight) * Bphi000 + phiweight * Bphi001) +
-                       rweight * ((1 - phiweight) * Bphi010 + phiweight * Bphi011)) +
-      zweight * ((1 - rweight) * ((1 - phiweight) * Bphi100 + phiweight * Bphi101) +
-                 rweight * ((1 - phiweight) * Bphi110 + phiweight * Bphi111));
-
-  //     std::cout << "wr: " << rweight << " wz: " << zweight << " wphi: " << phiweight << std::endl;
-  //     std::cout << "Bz000: " << Bz000 << std::endl
-  //          << "Bz001: " << Bz001 << std::endl
-  //          << "Bz010: " << Bz010 << std::endl
-  //          << "Bz011: " << Bz011 << std::endl
-  //          << "Bz100: " << Bz100 << std::endl
-  //          << "Bz101: " << Bz101 << std::endl
-  //          << "Bz110: " << Bz110 << std::endl
-  //          << "Bz111: " << Bz111 << std::endl
-  //          << "Bz:    " << BfieldCyl[0] << std::endl << std::endl;
 
   if (Verbosity() > 2)
   {
@@ -455,33 +388,6 @@ void PHField3DCylindrical::GetFieldCyl(const double CylPoint[4], double *BfieldC
   return;
 }
 
-// a binary search algorithm that puts the location that "key" would be, into index...
-// it returns true if key was found, and false if not.
-bool PHField3DCylindrical::bin_search(const std::vector<float> &vec, unsigned start, unsigned end, const float &key, unsigned &index) const
-{
-  // Termination condition: start index greater than end index
-  if (start > end)
-  {
-    index = start;
-    return false;
-  }
-
-  // Find the middle element of the vector and use that for splitting
-  // the array into two pieces.
-  unsigned middle = start + ((end - start) / 2);
-
-  if (vec[middle] == key)
-  {
-    index = middle;
-    return true;
-  }
-  if (vec[middle] > key)
-  {
-    return bin_search(vec, start, middle - 1, key, index);
-  }
-  return bin_search(vec, middle + 1, end, key, index);
-}
-
 // debug function to print key/value pairs in map
 void PHField3DCylindrical::print_map(std::map<trio, trio>::iterator &it) const
 {
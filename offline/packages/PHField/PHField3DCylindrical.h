@@ -21,7 +21,9 @@
 #define PHFIELD_PHFIELD3DCYLINDRICAL_H
 
 #include "PHField.h"
+#include "PHFieldGridAxis.h"
 
+#include <cstddef>
 #include <map>
 #include <string>
 #include <tuple>
@@ -34,24 +36,41 @@ class PHField3DCylindrical : public PHField
  public:
   PHField3DCylindrical(const std::string& filename, int verb = 0, const float magfield_rescale = 1.0);
   ~PHField3DCylindrical() override {}
+
+  //! access field value
+  //! the lookup holds no cache and is thread safe
   void GetFieldValue(const double Point[4], double* Bfield) const override;
+
   void GetFieldCyl(const double CylPoint[4], double* Bfield) const;
 
  protected:
-  // < i, j, k > , this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
-  std::vector<std::vector<std::vector<float> > > BFieldZ_;
-  std::vector<std::vector<std::vector<float> > > BFieldR_;
-  std::vector<std::vector<std::vector<float> > > BFieldPHI_;
+  //! field components stored per node
+  enum
+  {
+    kBz = 0,
+    kBr = 1,
+    kBphi = 2,
+    kNComponents = 3
+  };
+
+  //! flat index of field component for node <iz, ir, iphi>
+  // this allows i and i+1 to be neighbors ( <i,j,k>=<z,r,phi> )
+  std::size_t index(std::size_t iz, std::size_t ir, std::size_t iphi, std::size_t comp) const
+  {
+    return ((iz * r_map_.size() + ir) * phi_map_.size() + iphi) * kNComponents + comp;
+  }
+
+  //! field values, one contiguous array with the components of a node next to each other
+  std::vector<float> m_field;
 
-  // maps indices to values z_map[i] = z_value that corresponds to ith index
-  std::vector<float> z_map_;    // < i >
-  std::vector<float> r_map_;    // < j >
-  std::vector<float> phi_map_;  // < k >
+  // grid axes z_map[i] = z_value that corresponds to ith index
+  PHFieldGridAxis z_map_;    // < i >
+  PHFieldGridAxis r_map_;    // < j >
+  PHFieldGridAxis phi_map_;  // < k >
 
   float maxz_, minz_;  // boundaries of magnetic field map cyl
 
  private:
-  bool bin_search(const std::vector<float>& vec, unsigned start, unsigned end, const float& key, unsigned& index) const;
   void print_map(std::map<trio, trio>::iterator& it) const;
 };
 
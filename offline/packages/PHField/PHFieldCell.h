@@ -0,0 +1,61 @@
+#ifndef PHFIELD_PHFIELDCELL_H
+#define PHFIELD_PHFIELDCELL_H
+
+//! one cell of a field map interpolated on a regular grid
+/*!
+ * Returned by PHField::GetFieldCell. It holds the 8 corner values and the
+ * grid parameters needed to interpolate any point of the cell the same way
+ * the map does, so that a caller can keep the cell of the last point and
+ * skip the map lookup as long as a track steps inside of it.
+ * Units are the Geant4/CLHEP units of PHField.
+ */
+struct PHFieldCell
+{
+  //! map origin along x, y, z
+  double origin[3] = {0, 0, 0};
+
+  //! inverse map step along x, y, z
+  double invstep[3] = {0, 0, 0};
+
+  //! cell index along x, y, z
+  int index[3] = {0, 0, 0};
+
+  //! field at the corners, Bx, By, Bz of corner 4*dx + 2*dy + dz
+  double field[8][3] = {};
+
+  //! true if the point is in the cell.
+  /*! a point on a grid plane belongs to the cell below it, like in the map */
+  bool contains(const double Point[4]) const
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const double f = (Point[i] - origin[i]) * invstep[i];
+      // false for NaN
+      if (!(f > index[i] && f <= index[i] + 1))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //! trilinear interpolation, the point must be in the cell
+  void interpolate(const double Point[4], double *Bfield) const
+  {
+    const double tx = (Point[0] - origin[0]) * invstep[0] - index[0];
+    const double ty = (Point[1] - origin[1]) * invstep[1] - index[1];
+    const double tz = (Point[2] - origin[2]) * invstep[2] - index[2];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double c00 = field[0][i] * (1. - tx) + field[4][i] * tx;
+      const double c10 = field[2][i] * (1. - tx) + field[6][i] * tx;
+      const double c01 = field[1][i] * (1. - tx) + field[5][i] * tx;
+      const double c11 = field[3][i] * (1. - tx) + field[7][i] * tx;
+      const double c0 = c00 * (1. - ty) + c10 * ty;
+      const double c1 = c01 * (1. - ty) + c11 * ty;
+      Bfield[i] = c0 * (1. - tz) + c1 * tz;
+    }
+  }
+};
+
+#endif
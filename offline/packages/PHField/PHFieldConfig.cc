@@ -38,6 +38,9 @@ std::string PHFieldConfig::get_field_config_description() const
   case FieldInterpolated:
 	return "3D field map interpolated to O(3)";
 	break;
+  case Field3DCartesianGrid:
+    return "3D field map expressed in Cartesian coordinates on a dense grid";
+    break;
   default:
     return "Invalid Field";
   }
@@ -43,6 +43,8 @@ class PHFieldConfig : public PHObject
     Field3DCartesian = 1,
     //! Interpolation of the 3D field map (Cartesian coordinates)
     FieldInterpolated = 6,
+    //! 3D field map expressed in Cartesian coordinates, stored on a dense regular grid
+    Field3DCartesianGrid = 7,
 
     //! invalid value
     kFieldInvalid = 9999
@@ -0,0 +1,108 @@
+#ifndef PHFIELD_PHFIELDGRIDAXIS_H
+#define PHFIELD_PHFIELDGRIDAXIS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+//! sorted axis of a field map grid
+/*!
+ * Stores the node positions together with the inverse width of each bin,
+ * so that the interpolation weight is a single multiplication.
+ * Equidistant axes (the usual case) are located by index arithmetic,
+ * others fall back to a binary search.
+ * All methods are const and the object holds no cache, it can be shared between threads.
+ */
+class PHFieldGridAxis
+{
+ public:
+  PHFieldGridAxis() = default;
+
+  //! initialize from sorted node positions
+  template <class Iterator>
+  void set(Iterator begin, Iterator end)
+  {
+    m_nodes.assign(begin, end);
+    m_invwidth.clear();
+    m_uniform = m_nodes.size() > 1;
+    if (m_nodes.size() < 2)
+    {
+      return;
+    }
+
+    m_invwidth.reserve(m_nodes.size() - 1);
+    for (std::size_t i = 0; i + 1 < m_nodes.size(); ++i)
+    {
+      m_invwidth.push_back(1. / (m_nodes[i + 1] - m_nodes[i]));
+    }
+
+    const double step = (m_nodes.back() - m_nodes.front()) / (m_nodes.size() - 1);
+    for (std::size_t i = 0; i < m_nodes.size(); ++i)
+    {
+      if (std::abs(m_nodes[i] - (m_nodes.front() + i * step)) > 1e-4 * step)
+      {
+        m_uniform = false;
+        break;
+      }
+    }
+    m_invstep = 1. / step;
+  }
+
+  //! number of nodes
+  std::size_t size() const { return m_nodes.size(); }
+
+  //! node position
+  float operator[](std::size_t i) const { return m_nodes[i]; }
+
+  float front() const { return m_nodes.front(); }
+  float back() const { return m_nodes.back(); }
+
+  //! inverse width of bin i, i.e. between nodes i and i+1
+  double invwidth(std::size_t i) const { return m_invwidth[i]; }
+
+  //! index of the last node which is smaller than or equal to value
+  /*! same as std::upper_bound - 1. Returns -1 if value is below the first node or not finite */
+  long find(double value) const
+  {
+    if (!std::isfinite(value))
+    {
+      return -1;
+    }
+
+    if (m_uniform)
+    {
+      // range check before the conversion, which is undefined for values that do not fit in a long
+      const double position = std::floor((value - m_nodes.front()) * m_invstep);
+      const long index = static_cast<long>(std::clamp<double>(position, -1, m_nodes.size()));
+      // protect against rounding at the node positions
+      if (index >= 0 && index < static_cast<long>(m_nodes.size()))
+      {
+        if (value < m_nodes[index])
+        {
+          return index - 1;
+        }
+        if (index + 1 < static_cast<long>(m_nodes.size()) && value >= m_nodes[index + 1])
+        {
+          return index + 1;
+        }
+      }
+      return std::clamp<long>(index, -1, m_nodes.size() - 1);
+    }
+    return std::distance(m_nodes.begin(), std::upper_bound(m_nodes.begin(), m_nodes.end(), value)) - 1;
+  }
+
+  //! interpolation weight of node index+1 for value in bin index
+  double weight(double value, std::size_t index) const
+  {
+    return (value - m_nodes[index]) * m_invwidth[index];
+  }
+
+ private:
+  std::vector<float> m_nodes;
+  std::vector<double> m_invwidth;
+  double m_invstep {0};
+  bool m_uniform {false};
+};
+
+#endif
@@ -3,6 +3,7 @@
 #include "PHField.h"
 #include "PHField2D.h"
 #include "PHField3DCartesian.h"
+#include "PHField3DCartesianGrid.h"
 #include "PHField3DCylindrical.h"
 #include "PHFieldInterpolated.h"
 #include "PHFieldConfig.h"
@@ -74,6 +75,15 @@ PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, float inner_rad
         outer_radius,
         size_z);
     break;
+  case PHFieldConfig::Field3DCartesianGrid:
+    //    return "3D field map expressed in Cartesian coordinates on a dense grid";
+    field = new PHField3DCartesianGrid(
+        field_config->get_filename(),
+        field_config->get_magfield_rescale(),
+        inner_radius,
+        outer_radius,
+        size_z);
+    break;
   case PHFieldConfig::FieldInterpolated:
 	//    return "3d interpolated fieldmap"
     field = new PHFieldInterpolated;
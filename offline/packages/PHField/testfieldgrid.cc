@@ -0,0 +1,155 @@
+// checks PHField3DCartesianGrid against the map based PHField3DCartesian on random points,
+// and for points on the upper edges of the map, where the fractional node index can round past the last node
+
+#include "PHField3DCartesian.h"
+#include "PHField3DCartesianGrid.h"
+#include "PHFieldCell.h"
+
+#include <TFile.h>
+#include <TNtuple.h>
+
+#include <Geant4/G4SystemOfUnits.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // 395 nodes over +- 440.5 cm along x, as in the sPHENIX map
+  constexpr int nx = 395;
+  constexpr double xmax = 440.5;
+  // PHField3DCartesian requires the same range along x and y
+  constexpr int ny = 3;
+  constexpr double ymax = xmax;
+  constexpr int nz = 3;
+  constexpr double zmax = 20.;
+
+  // smooth non linear field, coordinates in cm, field in tesla. All the points checked
+  // against it below are grid nodes along each axis, where the interpolation is exact
+  std::array<double, 3> field(const double x, const double y, const double z)
+  {
+    return {1e-3 * x + 0.1 * std::sin(0.03 * x), 1e-3 * y * (1. + 1e-3 * x), 1. + 1e-3 * y * z};
+  }
+
+  void write_map(const std::string &filename)
+  {
+    TFile f(filename.c_str(), "RECREATE");
+    TNtuple map("fieldmap", "fieldmap", "x:y:z:bx:by:bz");
+    for (int ix = 0; ix < nx; ++ix)
+    {
+      const double x = -xmax + 2 * xmax * ix / (nx - 1);
+      for (int iy = 0; iy < ny; ++iy)
+      {
+        const double y = -ymax + 2 * ymax * iy / (ny - 1);
+        for (int iz = 0; iz < nz; ++iz)
+        {
+          const double z = -zmax + 2 * zmax * iz / (nz - 1);
+          const auto b = field(x, y, z);
+          map.Fill(x, y, z, b[0], b[1], b[2]);
+        }
+      }
+    }
+    map.Write();
+    f.Close();
+  }
+}  // namespace
+
+int main()
+{
+  const std::string filename = "testfieldgrid.root";
+  write_map(filename);
+  PHField3DCartesianGrid grid(filename);
+  PHField3DCartesian map(filename);
+
+  int failures = 0;
+
+  // random points inside the map: same cells and weights as the map based lookup.
+  // The grid stores the field in tesla*Geant4 units as float, hence the float precision tolerance
+  std::mt19937 rng(12345);
+  std::uniform_real_distribution<double> xdist(-xmax, xmax);
+  std::uniform_real_distribution<double> ydist(-ymax, ymax);
+  std::uniform_real_distribution<double> zdist(-zmax, zmax);
+  double maxdiff = 0;
+  for (int i = 0; i < 100000; ++i)
+  {
+    const double point[4] = {xdist(rng) * cm, ydist(rng) * cm, zdist(rng) * cm, 0};
+    double bgrid[3] = {0, 0, 0};
+    double bmap[3] = {0, 0, 0};
+    grid.GetFieldValue(point, bgrid);
+    map.GetFieldValue(point, bmap);
+    for (int j = 0; j < 3; ++j)
+    {
+      maxdiff = std::max(maxdiff, std::abs(bgrid[j] - bmap[j]) / tesla);
+    }
+  }
+  if (maxdiff > 1e-6)
+  {
+    std::cout << "testfieldgrid - grid and map differ by up to " << maxdiff << " T" << std::endl;
+    ++failures;
+  }
+
+  // points on the upper edges, on each axis and on the corner. Map coordinates are stored as float
+  const double xedge = static_cast<float>(xmax);
+  const double yedge = static_cast<float>(ymax);
+  const double zedge = static_cast<float>(zmax);
+  const std::vector<std::array<double, 3>> points = {
+      {xedge, 0, 0},
+      {0, yedge, 0},
+      {0, 0, zedge},
+      {xedge, yedge, zedge},
+      {-xedge, -yedge, -zedge}};
+
+  std::vector<double> packed;
+  for (const auto &p : points)
+  {
+    const double point[4] = {p[0] * cm, p[1] * cm, p[2] * cm, 0};
+    packed.insert(packed.end(), point, point + 4);
+
+    double bfield[3] = {0, 0, 0};
+    grid.GetFieldValue(point, bfield);
+    const auto expected = field(p[0], p[1], p[2]);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::abs(bfield[i] / tesla - expected[i]) > 1e-5)
+      {
+        std::cout << "testfieldgrid - wrong field at (" << p[0] << ", " << p[1] << ", " << p[2] << ") cm, component " << i
+                  << ": " << bfield[i] / tesla << " expected " << expected[i] << std::endl;
+        ++failures;
+      }
+    }
+
+    PHFieldCell cell;
+    if (!grid.GetFieldCell(point, cell) ||
+        cell.index[0] > nx - 2 || cell.index[1] > ny - 2 || cell.index[2] > nz - 2)
+    {
+      std::cout << "testfieldgrid - wrong cell at (" << p[0] << ", " << p[1] << ", " << p[2] << ") cm" << std::endl;
+      ++failures;
+    }
+  }
+
+  // batch access goes through the same cell lookup
+  std::vector<double> bfields(3 * points.size());
+  grid.GetFieldValues(points.size(), packed.data(), bfields.data());
+  for (std::size_t ip = 0; ip < points.size(); ++ip)
+  {
+    const auto expected = field(points[ip][0], points[ip][1], points[ip][2]);
+    for (int i = 0; i < 3; ++i)
+    {
+      if (std::abs(bfields[3 * ip + i] / tesla - expected[i]) > 1e-5)
+      {
+        std::cout << "testfieldgrid - wrong batch field for point " << ip << ", component " << i << std::endl;
+        ++failures;
+      }
+    }
+  }
+
+  std::remove(filename.c_str());
+  std::cout << "testfieldgrid - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
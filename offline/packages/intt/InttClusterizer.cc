@@ -29,9 +29,6 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -52,52 +49,6 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer) const
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
-    {
-      if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer) const
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs((int) (lhs->getPhiBin()) - (int) (rhs->getPhiBin())) <= 1)  // col
-    {
-      if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs((int) (lhs->getPhiBin()) - (int)(rhs->getPhiBin())) <= 1)
-  {
-    if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) == 0)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -401,43 +352,18 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, component.data());
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    // find the groups of adjacent strips. With z clustering the strips touching
+    // by a side or a corner are connected, otherwise only those in the same column
+    std::vector<TrkrHitUnionFind::Cell> cells;
+    cells.reserve(hitvec.size());
+    for (const auto& hit : hitvec)
     {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      cells.push_back({InttDefs::getCol(hit.first), InttDefs::getRow(hit.first)});
     }
+    const std::size_t nclusters = m_unionfind.find(cells, get_z_clustering(layer) ? 1 : 0, 1);
 
     // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    for (std::size_t clusid = 0; clusid < nclusters; ++clusid)
     {
       // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
 
@@ -469,18 +395,16 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
       // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
 
       // get all hits for this cluster ID only
-      const auto clusrange = clusters.equal_range(clusid);
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (const auto ihit : m_unionfind.hits(clusid))
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        int col = InttDefs::getCol((mapiter->second).first);
-        int row = InttDefs::getRow((mapiter->second).first);
+        const auto& hit = hitvec[ihit];
+        // std::cout << " adding hitkey " << hit.first << std::endl;
+        int col = InttDefs::getCol(hit.first);
+        int row = InttDefs::getRow(hit.first);
         zbins.insert(col);
         phibins.insert(row);
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second).second->getAdc();
+        unsigned int hit_adc = hit.second->getAdc();
 
         // now get the positions from the geometry
         double local_hit_location[3] = {0., 0., 0.};
@@ -507,7 +431,7 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
         ++nhits;
 
         // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
         if (Verbosity() > 2)
         {
@@ -670,43 +594,18 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
-    {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, component.data());
-
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, RawHit*> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    // find the groups of adjacent strips. With z clustering the strips touching
+    // by a side or a corner are connected, otherwise only those in the same row
+    std::vector<TrkrHitUnionFind::Cell> cells;
+    cells.reserve(hitvec.size());
+    for (auto* hit : hitvec)
     {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      cells.push_back({static_cast<int>(hit->getPhiBin()), static_cast<int>(hit->getTBin())});
     }
+    const std::size_t nclusters = m_unionfind.find(cells, 1, get_z_clustering(layer) ? 1 : 0);
 
     // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
+    for (std::size_t clusid = 0; clusid < nclusters; ++clusid)
     {
       // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
       // make the cluster directly in the node tree
@@ -739,14 +638,13 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::map<int, unsigned int> m_z;  // hold data for
 
       // get all hits for this cluster ID only
-      const auto clusrange = clusters.equal_range(clusid);
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
+      for (const auto ihit : m_unionfind.hits(clusid))
       {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        const auto energy = (mapiter->second)->getAdc();
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
+        const auto& hit = hitvec[ihit];
+        // std::cout << " adding hitkey " << hit.first << std::endl;
+        const auto energy = hit->getAdc();
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
         //	    std::cout << " found Tbin(row) " << row << " Phibin(col) " << col << std::endl;
         zbins.insert(col);
         phibins.insert(row);
@@ -766,8 +664,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
           }
         }
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second)->getAdc();
+        unsigned int hit_adc = hit->getAdc();
 
         // now get the positions from the geometry
         double local_hit_location[3] = {0., 0., 0.};
@@ -794,7 +691,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
         ++nhits;
 
         // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        //	    m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        //	    m_clusterhitassoc->addAssoc(ckey, hit.first);
 
         if (Verbosity() > 2)
         {
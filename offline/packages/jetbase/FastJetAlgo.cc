@@ -117,7 +117,7 @@ fastjet::Selector FastJetAlgo::get_selector() const
 }
 
 std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_jets(
-    std::vector<fastjet::PseudoJet>& pseudojets)
+    const std::vector<fastjet::PseudoJet>& pseudojets)
 {
   auto jetdef = get_fastjet_definition();
   m_cluseq = new fastjet::ClusterSequence(pseudojets, jetdef);
@@ -132,7 +132,7 @@ std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_jets(
 }
 
 std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_area_jets(
-    std::vector<fastjet::PseudoJet>& pseudojets)
+    const std::vector<fastjet::PseudoJet>& pseudojets)
 {
   auto jetdef = get_fastjet_definition();
 
@@ -149,7 +149,7 @@ std::vector<fastjet::PseudoJet> FastJetAlgo::cluster_area_jets(
   return fastjet::sorted_by_pt(selector(m_cluseqarea->inclusive_jets()));
 }
 
-float FastJetAlgo::calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents) const
+float FastJetAlgo::calc_rhomeddens(const std::vector<fastjet::PseudoJet>& constituents) const
 {
   fastjet::AreaDefinition area_def(
       fastjet::active_area_explicit_ghosts,
@@ -205,6 +205,13 @@ FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles) const
   return pseudojets;
 }
 
+bool FastJetAlgo::same_constituent_selection(const FastJetAlgo& other) const
+{
+  return m_opt.constituent_min_E == other.m_opt.constituent_min_E &&
+         m_opt.use_constituent_min_pt == other.m_opt.use_constituent_min_pt &&
+         (!m_opt.use_constituent_min_pt || m_opt.constituent_min_pt == other.m_opt.constituent_min_pt);
+}
+
 void FastJetAlgo::first_call_init(JetContainer* jetcont)
 {
   m_first_cluster_call = false;
@@ -256,6 +263,12 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
 }
 
 void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
+{
+  // translate input jets to input fastjets
+  cluster_and_fill(particles, jets_to_pseudojets(particles), jetcont);
+}
+
+void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, const std::vector<fastjet::PseudoJet>& input_pseudojets, JetContainer* jetcont)
 {
   if (m_first_cluster_call)
   {
@@ -272,12 +285,15 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
     std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
   }
 
-  // translate input jets to input fastjets
-  auto pseudojets = jets_to_pseudojets(particles);
-
   // if using constituent subtraction, oberve maximum eta and subtract the constituents
+  // the input is only copied in that case
+  std::vector<fastjet::PseudoJet> subtracted_input;
+  const std::vector<fastjet::PseudoJet>* pseudojets_ptr = &input_pseudojets;
   if (m_opt.cs_calc_constsub)
   {
+    auto& pseudojets = subtracted_input;
+    pseudojets = input_pseudojets;
+
     if (m_opt.verbosity > 100)
     {
       std::cout << " Before Constituent Subtraction: " << std::endl;
@@ -320,7 +336,9 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
       std::cout << (boost::format(" jet[%2i] %8.4f  sum %8.4f") % i++ % _c.perp() % sumpt).str() << std::endl
                 << std::endl;
     }
+    pseudojets_ptr = &subtracted_input;
   }
+  const auto& pseudojets = *pseudojets_ptr;
 
   if (m_opt.calc_jetmedbkgdens)
   {
@@ -53,6 +53,16 @@ class FastJetAlgo : public JetAlgo
   std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
   void cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont) override;
 
+  // same as above, with the particles already translated by jets_to_pseudojets. Used by JetReco
+  // to translate the inputs once for all the algorithms with the same constituent selection
+  void cluster_and_fill(std::vector<Jet*>& particles, const std::vector<fastjet::PseudoJet>& pseudojets, JetContainer* jetcont);
+
+  // translate input particles to fastjet, applying the constituent selection
+  std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles) const;
+
+  // true if jets_to_pseudojets gives the same output for both algorithms
+  bool same_constituent_selection(const FastJetAlgo& other) const;
+
  private:
   FastJetOptions m_opt{};
   bool m_first_cluster_call{true};
@@ -64,10 +74,9 @@ class FastJetAlgo : public JetAlgo
   Jet::PROPERTY m_area_index{Jet::PROPERTY::no_property};
 
   // Internal processes
-  std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles) const;
-  std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& pseudojets);
-  std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& pseudojets);
-  float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents) const;
+  std::vector<fastjet::PseudoJet> cluster_jets(const std::vector<fastjet::PseudoJet>& pseudojets);
+  std::vector<fastjet::PseudoJet> cluster_area_jets(const std::vector<fastjet::PseudoJet>& pseudojets);
+  float calc_rhomeddens(const std::vector<fastjet::PseudoJet>& constituents) const;
   fastjet::JetDefinition get_fastjet_definition() const;
   fastjet::Selector get_selector() const;
   void first_call_init(JetContainer* jetcont = nullptr);
@@ -1,6 +1,7 @@
 
 #include "JetReco.h"
 
+#include "FastJetAlgo.h"
 #include "Jet.h"
 #include "JetAlgo.h"
 #include "JetContainer.h"
@@ -22,11 +23,19 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <TROOT.h>
+
+#include <fastjet/PseudoJet.hh>
+
 #include <boost/format.hpp>
 
 // standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>  // for exit
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
 #include <vector>
@@ -79,9 +88,33 @@ int JetReco::InitRun(PHCompositeNode *topNode)
     std::cout << "===========================================================================" << std::endl;
   }
 
+  if (m_num_threads > 1 && use_jetcon)
+  {
+    // JetContainers are filled from several threads
+    ROOT::EnableThreadSafety();
+  }
+
   return CreateNodes(topNode);
 }
 
+int JetReco::End(PHCompositeNode * /*topNode*/)
+{
+  if (Verbosity() > 0 && use_jetcon)
+  {
+    std::cout << "JetReco::End - " << Name()
+              << " events: " << m_nevents
+              << " jets: " << m_njets
+              << " threads: " << m_num_threads
+              << " JetContainer filling time (s): " << m_fill_time;
+    if (m_fill_time > 0)
+    {
+      std::cout << " jets/s: " << m_njets / m_fill_time;
+    }
+    std::cout << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int JetReco::process_event(PHCompositeNode *topNode)
 {
   if (Verbosity() > 1)
@@ -108,18 +141,15 @@ int JetReco::process_event(PHCompositeNode *topNode)
   //---------------------------
   // Run the jet reconstruction
   //---------------------------
+  // send the output somewhere on the DST
+  /* if (_fill_JetContainer) { */
+  if (use_jetcon)
+  {
+    FillJetContainers(topNode, inputs);
+  }
+
   for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
   {
-    // send the output somewhere on the DST
-    /* if (_fill_JetContainer) { */
-    if (use_jetcon)
-    {
-      if (Verbosity() > 5)
-      {
-        std::cout << " Verbosity>5:: filling JetContainter for " << JC_name(_outputs[ialgo]) << std::endl;
-      }
-      FillJetContainer(topNode, ialgo, inputs);
-    }
     if (use_jetmap)
     {
       if (Verbosity() > 5)
@@ -283,16 +313,113 @@ void JetReco::FillJetNode(PHCompositeNode *topNode, int ipos, const std::vector<
   return;
 }
 
-void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<Jet *> &inputs)
+void JetReco::FillJetContainers(PHCompositeNode *topNode, std::vector<Jet *> &inputs)
 {
-  JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ipos]));
-  if (!jetconn)
+  // get all the containers first, the node tree is not accessed from the worker threads
+  std::vector<JetContainer *> jetconns;
+  for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
   {
-    std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ipos] << std::endl;
-    exit(-1);
+    if (Verbosity() > 5)
+    {
+      std::cout << " Verbosity>5:: filling JetContainter for " << JC_name(_outputs[ialgo]) << std::endl;
+    }
+    JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ialgo]));
+    if (!jetconn)
+    {
+      std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ialgo] << std::endl;
+      exit(-1);
+    }
+    jetconns.push_back(jetconn);
+  }
+
+  FillJetContainers(jetconns, inputs);
+}
+
+void JetReco::FillJetContainers(const std::vector<JetContainer *> &jetconns, std::vector<Jet *> &inputs)
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (auto *jetconn : jetconns)
+  {
+    jetconn->Reset();
+  }
+
+  // translate the inputs to fastjet once for all the FastJetAlgos with the same constituent selection
+  std::vector<std::vector<fastjet::PseudoJet>> pseudojets;
+  std::vector<int> pseudojets_index(_algos.size(), -1);
+  for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+  {
+    auto *fastjetalgo = dynamic_cast<FastJetAlgo *>(_algos[ialgo]);
+    if (!fastjetalgo)
+    {
+      continue;
+    }
+    for (unsigned int iother = 0; iother < ialgo; ++iother)
+    {
+      auto *other = dynamic_cast<FastJetAlgo *>(_algos[iother]);
+      if (other && fastjetalgo->same_constituent_selection(*other))
+      {
+        pseudojets_index[ialgo] = pseudojets_index[iother];
+        break;
+      }
+    }
+    if (pseudojets_index[ialgo] < 0)
+    {
+      pseudojets_index[ialgo] = pseudojets.size();
+      pseudojets.push_back(fastjetalgo->jets_to_pseudojets(inputs));
+    }
   }
-  jetconn->Reset();
-  _algos[ipos]->cluster_and_fill(inputs, jetconn);  // fills the jet container with clustered jets
+
+  auto fill = [&](unsigned int ialgo)
+  {
+    if (pseudojets_index[ialgo] < 0)
+    {
+      _algos[ialgo]->cluster_and_fill(inputs, jetconns[ialgo]);  // fills the jet container with clustered jets
+    }
+    else
+    {
+      static_cast<FastJetAlgo *>(_algos[ialgo])->cluster_and_fill(inputs, pseudojets[pseudojets_index[ialgo]], jetconns[ialgo]);
+    }
+    FillJetContainer(ialgo, jetconns[ialgo]);
+  };
+
+  const unsigned int nthreads = std::min<unsigned int>(m_num_threads, _algos.size());
+  if (nthreads > 1)
+  {
+    // each thread takes the next algorithm not yet processed
+    std::atomic<unsigned int> next_algo{0};
+    std::vector<std::future<void>> workers;
+    for (unsigned int ithread = 0; ithread < nthreads; ++ithread)
+    {
+      workers.push_back(std::async(std::launch::async, [&]()
+                                   {
+        for (unsigned int ialgo = next_algo++; ialgo < _algos.size(); ialgo = next_algo++)
+        {
+          fill(ialgo);
+        } }));
+    }
+    for (auto &worker : workers)
+    {
+      worker.get();
+    }
+  }
+  else
+  {
+    for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
+    {
+      fill(ialgo);
+    }
+  }
+
+  ++m_nevents;
+  for (const auto *jetconn : jetconns)
+  {
+    m_njets += jetconn->size();
+  }
+  m_fill_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void JetReco::FillJetContainer(int ipos, JetContainer *jetconn)
+{
   for (auto &_input : _inputs)
   {
     jetconn->insert_src(_input->get_src());
@@ -17,6 +17,7 @@
 // forward declarations
 class Jet;
 class JetAlgo;
+class JetContainer;
 class JetInput;
 class PHCompositeNode;
 
@@ -44,6 +45,7 @@ class JetReco : public SubsysReco
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
+  int End(PHCompositeNode *topNode) override;
 
   void add_input(JetInput *input) { _inputs.push_back(input); }
   void add_algo(JetAlgo *algo, const std::string &output)
@@ -52,16 +54,26 @@ class JetReco : public SubsysReco
     _outputs.push_back(output);
   }
 
+  // number of threads used to fill the JetContainers, one algorithm per thread at a time.
+  // The default (1) runs the algorithms in order in the calling thread.
+  // FastJet must be built thread safe (--enable-thread-safety) to use more than one
+  void set_num_threads(unsigned int n) { m_num_threads = n; }
+
   void set_algo_node(const std::string &algonode) { _algonode = algonode; }
   void set_input_node(const std::string &inputnode) { _inputnode = inputnode; }
   /* void set_fill_JetContainer(bool b) { _fill_JetContainer = b; } */
 
   JetAlgo *get_algo(unsigned int which_algo = 0);
 
+  // reset and fill the containers, one per algorithm in the order of add_algo, with the configured
+  // number of threads. Called by process_event, also used to compare serial and threaded filling
+  void FillJetContainers(const std::vector<JetContainer *> &jetconns, std::vector<Jet *> &inputs);
+
  private:
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ipos, const std::vector<Jet *> &jets);
-  void FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<Jet *> &inputs);
+  void FillJetContainers(PHCompositeNode *topNode, std::vector<Jet *> &inputs);
+  void FillJetContainer(int ipos, JetContainer *jetconn);
 
   std::vector<JetInput *> _inputs;
   std::vector<JetAlgo *> _algos;
@@ -69,6 +81,13 @@ class JetReco : public SubsysReco
   std::string _inputnode;
   std::vector<std::string> _outputs;
 
+  unsigned int m_num_threads{1};
+
+  // JetContainer filling statistics, printed at End
+  unsigned long m_nevents{0};
+  unsigned long m_njets{0};
+  double m_fill_time{0};  // seconds
+
   // transition functions, while moving from JetMap to JetContainer.
   // May be removed after transition is made, depending on state of
   // functions
@@ -0,0 +1,139 @@
+// checks that JetReco fills the same jets with several threads as with one.
+// The algorithms share the pseudojet translation when their constituent selection is the same,
+// each one fills its own container and the output must not depend on the thread which ran it
+
+#include "FastJetAlgo.h"
+#include "FastJetOptions.h"
+#include "Jet.h"
+#include "JetContainerv1.h"
+#include "JetReco.h"
+#include "Jetv2.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // same algorithms, in the same order, for both JetReco
+  void add_algos(JetReco &jetreco)
+  {
+    jetreco.add_algo(new FastJetAlgo(Jet::ANTIKT, 0.2), "AntiKt_r02");
+    jetreco.add_algo(new FastJetAlgo(Jet::ANTIKT, 0.4), "AntiKt_r04");
+    jetreco.add_algo(new FastJetAlgo(Jet::ANTIKT, 0.6), "AntiKt_r06");
+    jetreco.add_algo(new FastJetAlgo({{Jet::KT, JET_R, 0.4, CONSTITUENT_MIN_PT, 0.5}}), "Kt_r04");
+    jetreco.add_algo(new FastJetAlgo({{Jet::ANTIKT, JET_R, 0.4, CALC_AREA}}), "AntiKt_r04_area");
+  }
+
+  // towers of the three calorimeters with a few hard clusters on top of a soft background
+  std::vector<Jet *> make_inputs(std::mt19937 &rng)
+  {
+    std::uniform_real_distribution<float> eta_dist(-1.1, 1.1);
+    std::uniform_real_distribution<float> phi_dist(-M_PI, M_PI);
+    std::exponential_distribution<float> pt_dist(2.);
+    std::normal_distribution<float> spread(0., 0.1);
+
+    std::vector<Jet *> inputs;
+    const unsigned int nclusters = 1 + rng() % 6;
+    for (unsigned int icluster = 0; icluster <= nclusters; ++icluster)
+    {
+      // the last "cluster" is the background
+      const bool background = icluster == nclusters;
+      const float eta0 = eta_dist(rng);
+      const float phi0 = phi_dist(rng);
+      const unsigned int ntowers = background ? 500 : 5 + rng() % 30;
+      for (unsigned int itower = 0; itower < ntowers; ++itower)
+      {
+        const float eta = background ? eta_dist(rng) : eta0 + spread(rng);
+        const float phi = background ? phi_dist(rng) : phi0 + spread(rng);
+        const float pt = background ? pt_dist(rng) : 1. + 10. * pt_dist(rng);
+
+        auto *jet = new Jetv2;
+        jet->set_px(pt * std::cos(phi));
+        jet->set_py(pt * std::sin(phi));
+        jet->set_pz(pt * std::sinh(eta));
+        jet->set_e(pt * std::cosh(eta));
+        const unsigned int calo = rng() % 3;
+        jet->insert_comp(calo == 0 ? Jet::CEMC_TOWERINFO : (calo == 1 ? Jet::HCALIN_TOWERINFO : Jet::HCALOUT_TOWERINFO), inputs.size());
+        jet->set_id(inputs.size());
+        inputs.push_back(jet);
+      }
+    }
+    return inputs;
+  }
+
+  bool same_jet(Jet *a, Jet *b, bool compare_properties)
+  {
+    // nan == nan for the fractions of jets with zero energy
+    auto same = [](float x, float y)
+    { return x == y || (std::isnan(x) && std::isnan(y)); };
+
+    return same(a->get_px(), b->get_px()) && same(a->get_py(), b->get_py()) &&
+           same(a->get_pz(), b->get_pz()) && same(a->get_e(), b->get_e()) &&
+           same(a->get_emcal_frac(), b->get_emcal_frac()) &&
+           same(a->get_ihcal_frac(), b->get_ihcal_frac()) &&
+           same(a->get_ohcal_frac(), b->get_ohcal_frac()) &&
+           a->get_comp_vec() == b->get_comp_vec() &&
+           (!compare_properties || a->get_property_vec() == b->get_property_vec());
+  }
+}  // namespace
+
+int main()
+{
+  JetReco serial("JetRecoSerial");
+  add_algos(serial);
+
+  JetReco threaded("JetRecoThreaded");
+  threaded.set_num_threads(4);
+  add_algos(threaded);
+
+  const unsigned int nalgos = 5;
+  std::vector<JetContainer *> serial_jets;
+  std::vector<JetContainer *> threaded_jets;
+  for (unsigned int ialgo = 0; ialgo < nalgos; ++ialgo)
+  {
+    serial_jets.push_back(new JetContainerv1);
+    threaded_jets.push_back(new JetContainerv1);
+  }
+
+  std::mt19937 rng(8642);
+  int failures = 0;
+  for (int event = 0; event < 50; ++event)
+  {
+    auto inputs = make_inputs(rng);
+    serial.FillJetContainers(serial_jets, inputs);
+    threaded.FillJetContainers(threaded_jets, inputs);
+
+    for (unsigned int ialgo = 0; ialgo < nalgos; ++ialgo)
+    {
+      // the ghosts used for the area are random, the area is not compared
+      const bool compare_properties = ialgo != nalgos - 1;
+      bool ok = serial_jets[ialgo]->size() == threaded_jets[ialgo]->size();
+      for (unsigned int ijet = 0; ok && ijet < serial_jets[ialgo]->size(); ++ijet)
+      {
+        ok = same_jet(serial_jets[ialgo]->get_jet(ijet), threaded_jets[ialgo]->get_jet(ijet), compare_properties);
+      }
+      if (!ok)
+      {
+        std::cout << "testjetreco - event " << event << ", algorithm " << ialgo << ": " << threaded_jets[ialgo]->size()
+                  << " threaded jets differ from " << serial_jets[ialgo]->size() << " serial jets" << std::endl;
+        ++failures;
+      }
+    }
+
+    for (auto *jet : inputs)
+    {
+      delete jet;
+    }
+  }
+
+  for (unsigned int ialgo = 0; ialgo < nalgos; ++ialgo)
+  {
+    delete serial_jets[ialgo];
+    delete threaded_jets[ialgo];
+  }
+
+  std::cout << "testjetreco - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -42,18 +42,11 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <cstdlib>  // for exit
 #include <iostream>
-#include <map>  // for multimap<>::iterator
+#include <map>
 #include <set>  // for set, set<>::iterator
 #include <string>
 #include <vector>  // for vector
@@ -69,49 +62,6 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs) const
-{
-  if (GetZClustering())
-  {
-    return
-
-        // column adjacent
-        ((MvtxDefs::getCol(lhs.first) > MvtxDefs::getCol(rhs.first)) ? MvtxDefs::getCol(lhs.first) <= MvtxDefs::getCol(rhs.first) + 1 : MvtxDefs::getCol(rhs.first) <= MvtxDefs::getCol(lhs.first) + 1) &&
-
-        // row adjacent
-        ((MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ? MvtxDefs::getRow(lhs.first) <= MvtxDefs::getRow(rhs.first) + 1 : MvtxDefs::getRow(rhs.first) <= MvtxDefs::getRow(lhs.first) + 1);
-  }
-  return
-      // column identical
-      MvtxDefs::getCol(rhs.first) == MvtxDefs::getCol(lhs.first) &&
-
-      // row adjacent
-      ((MvtxDefs::getRow(lhs.first) > MvtxDefs::getRow(rhs.first)) ? MvtxDefs::getRow(lhs.first) <= MvtxDefs::getRow(rhs.first) + 1 : MvtxDefs::getRow(rhs.first) <= MvtxDefs::getRow(lhs.first) + 1);
-}
-
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs) const
-{
-  if (GetZClustering())
-  {
-    return
-
-        // phi adjacent (== column)
-        ((lhs->getPhiBin() > rhs->getPhiBin()) ? lhs->getPhiBin() <= rhs->getPhiBin() + 1 : rhs->getPhiBin() <= lhs->getPhiBin() + 1) &&
-
-        // time adjacent (== row)
-        ((lhs->getTBin() > rhs->getTBin()) ? lhs->getTBin() <= rhs->getTBin() + 1 : rhs->getTBin() <= lhs->getTBin() + 1);
-  }
-  return
-
-      // phi identical (== column)
-      lhs->getPhiBin() == rhs->getPhiBin() &&
-
-      // time adjacent (== row)
-      ((lhs->getTBin() > rhs->getTBin()) ? lhs->getTBin() <= rhs->getTBin() + 1 : rhs->getTBin() <= lhs->getTBin() + 1);
-}
-
 MvtxClusterizer::MvtxClusterizer(const std::string &name)
   : SubsysReco(name)
 {
@@ -352,42 +302,19 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       }
     }
 
-    // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // do the clustering. Pixels touching by a side or a corner are
+    // connected, without z clustering only those in the same column
+    std::vector<TrkrHitUnionFind::Cell> cells;
+    cells.reserve(hitvec.size());
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      cells.push_back({MvtxDefs::getCol(hit.first), MvtxDefs::getRow(hit.first)});
     }
+    const std::size_t nclusters = m_unionfind.find(cells, GetZClustering() ? 1 : 0, 1);
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, component.data());
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit *> > clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
+    for (std::size_t clusid = 0; clusid < nclusters; ++clusid)
     {
-      cluster_ids.insert(component[i]);
-      clusters.insert(make_pair(component[i], hitvec[i]));
-    }
-    for (const auto &clusid : cluster_ids)
-    {
-      auto clusrange = clusters.equal_range(clusid);
+      const auto clushits = m_unionfind.hits(clusid);
       auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
 
       // determine the size of the cluster in phi and z
@@ -399,8 +326,7 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
       // determine the cluster position...
       double locxsum = 0.;
       double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
+      const unsigned int nhits = clushits.size();
 
       double locclusx = std::numeric_limits<double>::quiet_NaN();
       double locclusz = std::numeric_limits<double>::quiet_NaN();
@@ -413,13 +339,13 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (const auto ihit : clushits)
       {
+        const auto &hit = hitvec[ihit];
         // size
-        const auto energy = (mapiter->second).second->getAdc();
-        int col = MvtxDefs::getCol((mapiter->second).first);
-        int row = MvtxDefs::getRow((mapiter->second).first);
+        const auto energy = hit.second->getAdc();
+        int col = MvtxDefs::getCol(hit.first);
+        int row = MvtxDefs::getRow(hit.first);
         zbins.insert(col);
         phibins.insert(row);
 
@@ -454,9 +380,9 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         loczsum += local_coords.Z();
         // add the association between this cluster key and this hitkey to the
         // table
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        m_clusterhitassoc->addAssoc(ckey, hit.first);
 
-      }  // mapiter
+      }  // hits
 
       if (mClusHitsVerbose)
       {
@@ -654,45 +580,20 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    // do the clustering
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // do the clustering. Pixels touching by a side or a corner are
+    // connected, without z clustering only those in the same column
+    std::vector<TrkrHitUnionFind::Cell> cells;
+    cells.reserve(hitvec.size());
+    for (auto *hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      cells.push_back({static_cast<int>(hit->getPhiBin()), static_cast<int>(hit->getTBin())});
     }
+    const std::size_t nclusters = m_unionfind.find(cells, GetZClustering() ? 1 : 0, 1);
 
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    boost::connected_components(G, component.data());
-
-    // Loop over the components(hits) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
-
-    std::multimap<int, RawHit *> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);
-      clusters.emplace(component[i], hitvec[i]);
-    }
-    //    std::cout << "found cluster #: "<< clusters.size()<< std::endl;
     // loop over the componenets and make clusters
-    for (const auto &clusid : cluster_ids)
+    for (std::size_t clusid = 0; clusid < nclusters; ++clusid)
     {
-      auto clusrange = clusters.equal_range(clusid);
+      const auto clushits = m_unionfind.hits(clusid);
 
       // make the cluster directly in the node tree
       auto ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
@@ -704,8 +605,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
       // determine the cluster position...
       double locxsum = 0.;
       double loczsum = 0.;
-      const unsigned int nhits =
-          std::distance(clusrange.first, clusrange.second);
+      const unsigned int nhits = clushits.size();
 
       double locclusx = NAN;
       double locclusz = NAN;
@@ -719,12 +619,12 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         exit(1);
       }
 
-      for (auto mapiter = clusrange.first; mapiter != clusrange.second;
-           ++mapiter)
+      for (const auto ihit : clushits)
       {
+        const auto &hit = hitvec[ihit];
         // size
-        int col = (mapiter->second)->getPhiBin();
-        int row = (mapiter->second)->getTBin();
+        int col = hit->getPhiBin();
+        int row = hit->getTBin();
         zbins.insert(col);
         phibins.insert(row);
 
@@ -744,9 +644,9 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         loczsum += local_coords.Z();
         // add the association between this cluster key and this hitkey to the
         // table
-        //	      m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+        //	      m_clusterhitassoc->addAssoc(ckey, hit.first);
 
-      }  // mapiter
+      }  // hits
 
       // This is the local position
       locclusx = locxsum / nhits;
@@ -12,7 +12,6 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContMvtxHelperv1.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
-#include <trackbase/TrkrHitv2.h>
 
 #include <fun4all/Fun4AllServer.h>
 
@@ -100,7 +99,10 @@ void MvtxCombinedRawDataDecoder::CreateNodes(PHCompositeNode *topNode)
     }
 
     // create container and add to the tree
-    hit_set_container = new TrkrHitSetContainerv1;
+    // hitsets and hits are recycled between events instead of being reallocated
+    auto *container = new TrkrHitSetContainerv1;
+    container->UseEventPool();
+    hit_set_container = container;
     auto *newNode = new PHIODataNode<PHObject>(hit_set_container, "TRKR_HITSET",
                                                "PHObject");
     trkrNode->addNode(newNode);
@@ -346,14 +348,12 @@ int MvtxCombinedRawDataDecoder::process_event(PHCompositeNode *topNode)
     {
       if (!m_hot_pixel_mask->is_masked(mvtx_rawhit))
       {  // Check if the pixel is masked
-        hit = new TrkrHitv2;
-        hitset_it->second->addHitSpecificKey(hitkey, hit);
+        hitset_it->second->addHit(hitkey);
       }
     }
     else
     {
-      hit = new TrkrHitv2;
-      hitset_it->second->addHitSpecificKey(hitkey, hit);
+      hitset_it->second->addHit(hitkey);
     }
   }
 
@@ -7,6 +7,7 @@
 #include <trackbase/TrkrDefs.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_set>
 
@@ -23,6 +24,8 @@ class PHG4TpcGeom;
 class PHG4TpcGeomContainer;
 class RawHitSetContainer;
 class RawHitSet;
+class TpcWorkerPool;
+
 class TpcClusterizer : public SubsysReco
 {
 public:
@@ -30,7 +33,7 @@ public:
   typedef std::pair<unsigned short, iphiz> ihit;
 
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  ~TpcClusterizer() override = default;
+  ~TpcClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -42,6 +45,8 @@ public:
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! number of clustering threads, including the main thread. 0 uses one per hardware thread
+  void set_num_threads(unsigned int nthreads) { m_num_threads = nthreads; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(double val) { pedestal = val; }
@@ -141,6 +146,10 @@ public:
   bool m_maskHotChannels {false};
   bool m_maskFromFile {false};
   bool m_debug{false};
+
+  unsigned int m_num_threads{0};
+  std::unique_ptr<TpcWorkerPool> m_pool;
+
   std::string m_deadChannelMapName; 
   std::string m_hotChannelMapName;
 };
@@ -0,0 +1,319 @@
+/*!
+ * \file TpcDistortionCorrectionGrid.cc
+ * \brief dense grid of the combined displacement of a chain of distortion corrections
+ */
+
+#include "TpcDistortionCorrectionGrid.h"
+
+#include "TpcDistortionCorrection.h"
+#include "TpcDistortionCorrectionContainer.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  template <class T>
+  constexpr T square(const T x)
+  {
+    return x * x;
+  }
+
+  // z extent of the 2D corrections, which are scaled linearly to zero at the readout
+  constexpr double z_extent_2d = 102.605;
+
+  // node spacing along z for 2D corrections, which have no z binning
+  constexpr double z_step_2d = 2.0;
+
+  // tolerance on node positions, relative to the node spacing
+  constexpr double node_tolerance = 1e-6;
+
+  // interpolation cell of a position
+  struct Cell
+  {
+    // node offsets of the lower phi slice, and of the lower (r, z) corner within a slice
+    size_t phi = 0;
+    size_t rz = 0;
+
+    // fractional position in the cell
+    double tphi = 0;
+    double tr = 0;
+    double tz = 0;
+  };
+
+}  // namespace
+
+//! range in which a set of axes can all be interpolated, and finest binning
+struct TpcDistortionCorrectionGrid::AxisRange
+{
+  // intersection of the interpolation ranges
+  double min = std::numeric_limits<double>::lowest();
+  double max = std::numeric_limits<double>::max();
+
+  // finest bin width, and one of its bin centers, used to align the nodes
+  double width = std::numeric_limits<double>::max();
+  double origin = 0;
+
+  bool valid() const { return width < std::numeric_limits<double>::max() && min < max; }
+
+  void add(double low, double high, double bin_width, double bin_center)
+  {
+    min = std::max(min, low);
+    max = std::min(max, high);
+    if (bin_width < width)
+    {
+      width = bin_width;
+      origin = bin_center;
+    }
+  }
+
+  // corrections are only applied away from the first and last bins, see TpcDistortionCorrection
+  void add(const TAxis* axis)
+  {
+    const auto nbins = axis->GetNbins();
+    if (nbins < 3)
+    {
+      max = min;
+      return;
+    }
+    add(axis->GetBinCenter(2), axis->GetBinCenter(nbins - 1), axis->GetBinWidth(2), axis->GetBinCenter(2));
+  }
+};
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::clear()
+{
+  for (auto& side : m_sides)
+  {
+    side = Side();
+  }
+}
+
+//________________________________________________________
+bool TpcDistortionCorrectionGrid::make_axis(const AxisRange& range, Axis& axis) const
+{
+  if (!range.valid())
+  {
+    return false;
+  }
+
+  // nodes on the finest bin centers, or in between for oversampling, within the range
+  axis.step = range.width / std::max(1U, m_oversampling);
+  const auto first = std::ceil((range.min - range.origin) / axis.step - node_tolerance);
+  const auto last = std::floor((range.max - range.origin) / axis.step + node_tolerance);
+  if (last - first < 1)
+  {
+    return false;
+  }
+
+  axis.n = static_cast<size_t>(last - first) + 1;
+  axis.min = range.origin + first * axis.step;
+  axis.max = range.origin + last * axis.step;
+  return true;
+}
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::build(const std::vector<const TpcDistortionCorrectionContainer*>& containers, const TpcDistortionCorrection& correction)
+{
+  clear();
+
+  for (int index = 0; index < 2; ++index)
+  {
+    // grid extent, from the histograms of all containers
+    AxisRange phi_range;
+    AxisRange r_range;
+    AxisRange z_range;
+    for (const auto* dcc : containers)
+    {
+      for (const auto* h : {dcc->m_hDPint[index], dcc->m_hDRint[index], dcc->m_hDZint[index]})
+      {
+        if (!h)
+        {
+          continue;
+        }
+
+        phi_range.add(h->GetXaxis());
+        r_range.add(h->GetYaxis());
+        if (dcc->m_dimensions == 3)
+        {
+          z_range.add(h->GetZaxis());
+        }
+        else
+        {
+          z_range.add(index == 0 ? -z_extent_2d : 0, index == 0 ? 0 : z_extent_2d, z_step_2d, 0);
+        }
+      }
+    }
+
+    // side selection is z > 0, same as in TpcDistortionCorrection
+    if (index == 0)
+    {
+      z_range.max = std::min(z_range.max, 0.);
+    }
+    else
+    {
+      z_range.min = std::max(z_range.min, 0.);
+    }
+
+    auto& side = m_sides[index];
+    const bool valid = make_axis(phi_range, side.phi) && make_axis(r_range, side.r) && make_axis(z_range, side.z);
+    if (!valid)
+    {
+      side = Side();
+      continue;
+    }
+
+    side.values.assign(4 * side.phi.n * side.r.n * side.z.n, 0);
+    for (size_t iphi = 0; iphi < side.phi.n; ++iphi)
+    {
+      const double phi = side.phi.node(iphi);
+      for (size_t ir = 0; ir < side.r.n; ++ir)
+      {
+        const double r = side.r.node(ir);
+        for (size_t iz = 0; iz < side.z.n; ++iz)
+        {
+          // make sure nodes at z = 0 are evaluated with the positive side histograms
+          double z = side.z.node(iz);
+          if (index == 1)
+          {
+            z = std::max(z, std::numeric_limits<double>::min());
+          }
+
+          Acts::Vector3 position(r * std::cos(phi), r * std::sin(phi), z);
+          for (const auto* dcc : containers)
+          {
+            position = correction.get_corrected_position(position, dcc);
+          }
+
+          const auto r_new = std::sqrt(square(position.x()) + square(position.y()));
+          auto dphi = phi - std::atan2(position.y(), position.x());
+          dphi -= 2 * M_PI * std::round(dphi / (2 * M_PI));
+
+          auto* value = &side.values[4 * side.index(iphi, ir, iz)];
+          value[0] = dphi;
+          value[1] = r - r_new;
+          value[2] = z - position.z();
+        }
+      }
+    }
+  }
+}
+
+//________________________________________________________
+bool TpcDistortionCorrectionGrid::get_corrected_position(Acts::Vector3& position) const
+{
+  unsigned char inside = 0;
+  correct_batch({&position, 1}, {&inside, 1});
+  return inside;
+}
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::get_corrected_positions(std::span<Acts::Vector3> positions, std::vector<size_t>& outside) const
+{
+  std::array<unsigned char, batch_size> inside{};
+  for (size_t first = 0; first < positions.size(); first += batch_size)
+  {
+    const auto count = std::min(batch_size, positions.size() - first);
+    correct_batch(positions.subspan(first, count), {inside.data(), count});
+    for (size_t i = 0; i < count; ++i)
+    {
+      if (!inside[i])
+      {
+        outside.push_back(first + i);
+      }
+    }
+  }
+}
+
+//________________________________________________________
+void TpcDistortionCorrectionGrid::correct_batch(std::span<Acts::Vector3> positions, std::span<unsigned char> inside) const
+{
+  /*
+   * the loops below have no data dependent branches, so that they can be vectorized by the compiler:
+   * cells are clamped to the grid, interpolation is always done, and positions outside of the grid keep their value
+   */
+  const auto count = positions.size();
+  std::array<double, batch_size> r;
+  std::array<double, batch_size> phi;
+  std::array<double, batch_size> z;
+  std::array<unsigned char, batch_size> index;
+  std::array<Cell, batch_size> cells;
+
+  // cylindrical coordinates
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto& source = positions[i];
+    r[i] = std::sqrt(square(source.x()) + square(source.y()));
+    phi[i] = std::atan2(source.y(), source.x());
+    phi[i] += (phi[i] < 0) * 2 * M_PI;
+    z[i] = source.z();
+    index[i] = z[i] > 0;
+  }
+
+  // interpolation cells
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto& side = m_sides[index[i]];
+    inside[i] = side.valid() &
+                (phi[i] >= side.phi.min) & (phi[i] <= side.phi.max) &
+                (r[i] >= side.r.min) & (r[i] <= side.r.max) &
+                (z[i] >= side.z.min) & (z[i] <= side.z.max);
+
+    // fractional node indices, clamped to the grid. NaN goes to zero
+    const double fphi = std::min<double>(side.phi.n - 1, std::max(0., (phi[i] - side.phi.min) / side.phi.step));
+    const double fr = std::min<double>(side.r.n - 1, std::max(0., (r[i] - side.r.min) / side.r.step));
+    const double fz = std::min<double>(side.z.n - 1, std::max(0., (z[i] - side.z.min) / side.z.step));
+
+    const auto iphi = std::min(static_cast<size_t>(fphi), side.phi.n - 2);
+    const auto ir = std::min(static_cast<size_t>(fr), side.r.n - 2);
+    const auto iz = std::min(static_cast<size_t>(fz), side.z.n - 2);
+
+    auto& cell = cells[i];
+    cell.tphi = fphi - iphi;
+    cell.tr = fr - ir;
+    cell.tz = fz - iz;
+    cell.phi = iphi * side.r.n * side.z.n;
+    cell.rz = ir * side.z.n + iz;
+  }
+
+  // trilinear interpolation of the displacement, and corrected position
+  for (size_t i = 0; i < count; ++i)
+  {
+    const auto& side = m_sides[index[i]];
+    if (!side.valid())
+    {
+      continue;
+    }
+
+    const auto& cell = cells[i];
+    const auto* values = side.values.data();
+    const auto nz = side.z.n;
+    const auto nrz = side.r.n * nz;
+
+    std::array<double, 3> delta{};
+    for (size_t k = 0; k < 3; ++k)
+    {
+      const auto value = [&](size_t phi_offset, size_t rz_offset)
+      { return static_cast<double>(values[4 * (phi_offset + cell.rz + rz_offset) + k]); };
+
+      const auto interpolate_z = [&](size_t phi_offset, size_t r_offset)
+      { return value(phi_offset, r_offset) * (1 - cell.tz) + value(phi_offset, r_offset + 1) * cell.tz; };
+
+      const auto interpolate_rz = [&](size_t phi_offset)
+      { return interpolate_z(phi_offset, 0) * (1 - cell.tr) + interpolate_z(phi_offset, nz) * cell.tr; };
+
+      delta[k] = interpolate_rz(cell.phi) * (1 - cell.tphi) + interpolate_rz(cell.phi + nrz) * cell.tphi;
+    }
+
+    const double phi_new = phi[i] - delta[0];
+    const double r_new = r[i] - delta[1];
+    const double z_new = z[i] - delta[2];
+
+    const Acts::Vector3 corrected(r_new * std::cos(phi_new), r_new * std::sin(phi_new), z_new);
+    positions[i] = inside[i] ? corrected : positions[i];
+  }
+}
@@ -0,0 +1,113 @@
+#ifndef TPC_TPCDISTORTIONCORRECTIONGRID_H
+#define TPC_TPCDISTORTIONCORRECTIONGRID_H
+
+/*!
+ * \file TpcDistortionCorrectionGrid.h
+ * \brief dense grid of the combined displacement of a chain of distortion corrections
+ *
+ * The chain of correction containers is evaluated once, at every node of a regular (phi, r, z) grid per TPC side,
+ * and the resulting displacement is interpolated trilinearly afterwards. This replaces up to twelve TH1::Interpolate calls
+ * per position by a single interpolation with no virtual calls nor axis lookups.
+ * Nodes are aligned on the bin centers of the finest histogram, and the grid only covers the region where all histograms
+ * can be interpolated. The interpolated composition still only approximates the composition of interpolations.
+ * Positions outside of the grid are not corrected and must use the exact chain.
+ */
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+class TpcDistortionCorrection;
+class TpcDistortionCorrectionContainer;
+
+class TpcDistortionCorrectionGrid
+{
+ public:
+  //! constructor
+  TpcDistortionCorrectionGrid() = default;
+
+  //! node spacing relative to the finest histogram binning. Must be set before build
+  void set_oversampling(unsigned int value)
+  {
+    m_oversampling = value;
+  }
+
+  //! evaluate the chain of containers, in order, at every node of the grid
+  void build(const std::vector<const TpcDistortionCorrectionContainer*>&, const TpcDistortionCorrection&);
+
+  //! clear the grid
+  void clear();
+
+  //! true if the grid was built
+  bool valid() const
+  {
+    return m_sides[0].valid() || m_sides[1].valid();
+  }
+
+  //! number of grid nodes, both sides
+  size_t size() const
+  {
+    return m_sides[0].values.size() / 4 + m_sides[1].values.size() / 4;
+  }
+
+  //! get corrected position. Returns false and leaves the position unchanged if it is outside of the grid
+  bool get_corrected_position(Acts::Vector3&) const;
+
+  //! correct positions in place. The indices of positions outside of the grid, left unchanged, are appended to the second argument
+  void get_corrected_positions(std::span<Acts::Vector3>, std::vector<size_t>& /*outside*/) const;
+
+ private:
+  //! positions per batch, sized for the working buffers to stay in cache
+  static constexpr size_t batch_size = 256;
+
+  //! regularly spaced nodes along one axis
+  struct Axis
+  {
+    // defaults keep the cell computation of an empty side well defined
+    size_t n = 2;
+    double min = 0;
+    double max = 0;
+    double step = 1;
+
+    double node(size_t i) const { return min + i * step; }
+  };
+
+  //! grid for one side of the TPC
+  struct Side
+  {
+    bool valid() const { return !values.empty(); }
+
+    //! node index
+    size_t index(size_t iphi, size_t ir, size_t iz) const
+    {
+      return (iphi * r.n + ir) * z.n + iz;
+    }
+
+    Axis phi;
+    Axis r;
+    Axis z;
+
+    //! dphi, dr, dz and padding for each node, z running fastest
+    std::vector<float> values;
+  };
+
+  //! histogram binning along one axis, defined in the implementation
+  struct AxisRange;
+
+  //! nodes along one axis, from the histogram binning. Returns false if there are less than two nodes
+  bool make_axis(const AxisRange&, Axis&) const;
+
+  //! correct one batch of positions in place, and flag the ones outside of the grid
+  void correct_batch(std::span<Acts::Vector3>, std::span<unsigned char> /*inside*/) const;
+
+  //! node spacing relative to the finest histogram binning
+  unsigned int m_oversampling = 1;
+
+  //! negative and positive z
+  std::array<Side, 2> m_sides;
+};
+
+#endif
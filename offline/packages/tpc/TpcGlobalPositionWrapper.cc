@@ -9,11 +9,21 @@
 #include "TpcClusterZCrossingCorrection.h"
 #include "TpcDistortionCorrectionContainer.h"
 
+#include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterGlobalPositionCache.h>
+
+namespace
+{
+  //! name of the position cache node
+  const std::string position_cache_node_name = "TRKR_CLUSTER_GLOBALPOSITIONCACHE";
+}
 
 //____________________________________________________________________________________________________________________
 void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
@@ -43,10 +53,115 @@ void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
   {
     std::cout << "TpcGlobalPositionWrapper::loadNodes - found fluctuation TPC distortion correction container" << std::endl;
   }
+
+  // combined correction grid, from the enabled corrections in the order they are applied
+  m_correctionGrid.clear();
+  if (m_use_correction_grid)
+  {
+    std::vector<const TpcDistortionCorrectionContainer*> containers;
+    for (const auto& [enabled, dcc] : {std::make_pair(m_enable_module_edge_corr, m_dcc_module_edge),
+                                       std::make_pair(m_enable_static_corr, m_dcc_static),
+                                       std::make_pair(m_enable_average_corr, m_dcc_average),
+                                       std::make_pair(m_enable_fluctuation_corr, m_dcc_fluctuation)})
+    {
+      if (enabled && dcc)
+      {
+        containers.push_back(dcc);
+      }
+    }
+
+    if (!containers.empty())
+    {
+      PHTimer timer("TpcDistortionCorrectionGrid");
+      timer.stop();
+      timer.restart();
+      m_correctionGrid.build(containers, m_distortionCorrection);
+      timer.stop();
+      if (m_verbosity > 0)
+      {
+        std::cout << "TpcGlobalPositionWrapper::loadNodes - correction grid with " << m_correctionGrid.size()
+                  << " nodes built in " << timer.get_accumulated_time() << " ms" << std::endl;
+      }
+    }
+  }
+
+  // position cache, shared with the other modules. Created under DST so that it is reset every event
+  m_positionCache = nullptr;
+  if (m_use_position_cache)
+  {
+    m_positionCache = findNode::getClass<TrkrClusterGlobalPositionCache>(topNode, position_cache_node_name);
+    if (!m_positionCache)
+    {
+      PHNodeIterator iter(topNode);
+      auto* dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
+      if (dstNode)
+      {
+        m_positionCache = new TrkrClusterGlobalPositionCache;
+        dstNode->addNode(new PHDataNode<PHObject>(m_positionCache, position_cache_node_name, "PHObject"));
+      }
+    }
+  }
+}
+
+//____________________________________________________________________________________________________________________
+uint8_t TpcGlobalPositionWrapper::correctionFlags() const
+{
+  uint8_t flags = 0;
+  if (m_enable_module_edge_corr && m_dcc_module_edge)
+  {
+    flags |= 1U << 0U;
+  }
+  if (m_enable_static_corr && m_dcc_static)
+  {
+    flags |= 1U << 1U;
+  }
+  if (m_enable_average_corr && m_dcc_average)
+  {
+    flags |= 1U << 2U;
+  }
+  if (m_enable_fluctuation_corr && m_dcc_fluctuation)
+  {
+    flags |= 1U << 3U;
+  }
+  if (m_correctionGrid.valid())
+  {
+    flags |= 1U << 4U;
+  }
+  return flags;
 }
 
 //____________________________________________________________________________________________________________________
 Acts::Vector3 TpcGlobalPositionWrapper::applyDistortionCorrections(Acts::Vector3 global) const
+{
+  if (m_correctionGrid.valid() && m_correctionGrid.get_corrected_position(global))
+  {
+    return global;
+  }
+  return applyDistortionCorrectionChain(global);
+}
+
+//____________________________________________________________________________________________________________________
+void TpcGlobalPositionWrapper::applyDistortionCorrections(std::span<Acts::Vector3> positions) const
+{
+  if (!m_correctionGrid.valid())
+  {
+    for (auto& position : positions)
+    {
+      position = applyDistortionCorrectionChain(position);
+    }
+    return;
+  }
+
+  std::vector<size_t> outside;
+  m_correctionGrid.get_corrected_positions(positions, outside);
+  for (const auto& i : outside)
+  {
+    positions[i] = applyDistortionCorrectionChain(positions[i]);
+  }
+}
+
+//____________________________________________________________________________________________________________________
+Acts::Vector3 TpcGlobalPositionWrapper::applyDistortionCorrectionChain(Acts::Vector3 global) const
 {
   // apply distortion corrections
   if (m_enable_module_edge_corr && m_dcc_module_edge)
@@ -74,6 +189,31 @@ Acts::Vector3 TpcGlobalPositionWrapper::applyDistortionCorrections(Acts::Vector3
 
 //____________________________________________________________________________________________________________________
 Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey& key, TrkrCluster* cluster, short int crossing ) const
+{
+  // only corrected TPC positions are cached, invalid crossings are reported by the computation
+  const bool use_cache = m_positionCache && m_tGeometry &&
+    TrkrDefs::getTrkrId(key) == TrkrDefs::TrkrId::tpcId &&
+    crossing != SHRT_MAX;
+
+  if( !use_cache )
+  {
+    return computeGlobalPositionDistortionCorrected(key, cluster, crossing);
+  }
+
+  const auto flags = correctionFlags();
+  Acts::Vector3 global;
+  if( m_positionCache->find(key, cluster, crossing, flags, global) )
+  {
+    return global;
+  }
+
+  global = computeGlobalPositionDistortionCorrected(key, cluster, crossing);
+  m_positionCache->store(key, cluster, crossing, flags, global);
+  return global;
+}
+
+//____________________________________________________________________________________________________________________
+Acts::Vector3 TpcGlobalPositionWrapper::computeGlobalPositionDistortionCorrected(const TrkrDefs::cluskey& key, TrkrCluster* cluster, short int crossing ) const
 {
 
   if( !m_tGeometry )
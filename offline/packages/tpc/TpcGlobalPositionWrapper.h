@@ -7,14 +7,18 @@
  * \author Joe Osborn <josborn1@bnl.gov>, Hugo Pereira Da Costa <hugo.pereira-da-costa@lanl.gov>
  */
 #include "TpcDistortionCorrection.h"
+#include "TpcDistortionCorrectionGrid.h"
 
 #include <trackbase/TrkrDefs.h>
 
+#include <cstdint>
+#include <span>
 
 class ActsGeometry;
 class PHCompositeNode;
 class TpcDistortionCorrectionContainer;
 class TrkrCluster;
+class TrkrClusterGlobalPositionCache;
 
 class TpcGlobalPositionWrapper
 {
@@ -48,9 +52,30 @@ class TpcGlobalPositionWrapper
   void set_enable_average_corr(bool flag) { m_enable_average_corr = flag; }
   void set_enable_fluctuation_corr(bool flag) { m_enable_fluctuation_corr = flag; }
 
+  //! use the per event cache of TPC positions shared by all modules. Off by default. Must be set before loadNodes
+  /**
+   * cached positions are keyed on the cluster, crossing and enabled corrections only.
+   * Do not enable it for modules which modify the geometry transforms during the event,
+   * like the track fit with transient alignment transforms instead of the cluster mover
+   */
+  void set_use_position_cache(bool flag) { m_use_position_cache = flag; }
+
+  //! interpolate all enabled corrections from a single precomputed grid. Must be set before loadNodes
+  /**
+   * the grid is built at loadNodes and approximates the chained corrections, see TpcDistortionCorrectionGrid.
+   * Positions outside of the grid use the exact chain
+   */
+  void set_use_correction_grid(bool flag) { m_use_correction_grid = flag; }
+
+  //! grid node spacing relative to the finest correction histogram binning
+  void set_correction_grid_oversampling(unsigned int value) { m_correctionGrid.set_oversampling(value); }
+
   //! apply all loaded distortion corrections to a given position
   Acts::Vector3 applyDistortionCorrections( Acts::Vector3 /*source*/ ) const;
 
+  //! apply all loaded distortion corrections to a set of positions, in place
+  void applyDistortionCorrections( std::span<Acts::Vector3> /*positions*/ ) const;
+
   //! get distortion corrected global position from cluster
   /**
    * first converts cluster position local coordinate to global coordinates
@@ -60,6 +85,15 @@ class TpcGlobalPositionWrapper
 
   private:
 
+  //! global position without the cache
+  Acts::Vector3 computeGlobalPositionDistortionCorrected(const TrkrDefs::cluskey&, TrkrCluster*, short int /*crossing*/ ) const;
+
+  //! apply the chain of enabled corrections, without the grid
+  Acts::Vector3 applyDistortionCorrectionChain( Acts::Vector3 /*source*/ ) const;
+
+  //! corrections that are enabled and loaded, used to tag cached positions
+  uint8_t correctionFlags() const;
+
   //! verbosity
   unsigned int m_verbosity = 0;
 
@@ -87,6 +121,14 @@ class TpcGlobalPositionWrapper
   TpcDistortionCorrectionContainer* m_dcc_fluctuation{nullptr};
   bool m_enable_fluctuation_corr = true;
 
+  //! combined correction grid
+  TpcDistortionCorrectionGrid m_correctionGrid;
+  bool m_use_correction_grid = false;
+
+  //! per event cache of corrected TPC positions
+  TrkrClusterGlobalPositionCache* m_positionCache{nullptr};
+  bool m_use_position_cache = false;
+
 };
 
 #endif
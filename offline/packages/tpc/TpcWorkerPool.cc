@@ -0,0 +1,100 @@
+#include "TpcWorkerPool.h"
+
+#include <algorithm>
+
+TpcWorkerPool::TpcWorkerPool(unsigned int nthreads)
+{
+  if (nthreads == 0)
+  {
+    nthreads = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  // the caller is the first thread
+  m_workers.reserve(nthreads - 1);
+  for (unsigned int i = 1; i < nthreads; ++i)
+  {
+    m_workers.emplace_back(&TpcWorkerPool::work, this);
+  }
+}
+
+TpcWorkerPool::~TpcWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start.notify_all();
+  for (auto &worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+void TpcWorkerPool::run(std::size_t ntasks, const std::function<void(std::size_t)> &task)
+{
+  if (ntasks == 0)
+  {
+    return;
+  }
+
+  if (m_workers.empty())
+  {
+    for (std::size_t i = 0; i < ntasks; ++i)
+    {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_task = &task;
+    m_ntasks = ntasks;
+    m_next = 0;
+    m_active = m_workers.size();
+    ++m_generation;
+  }
+  m_start.notify_all();
+
+  process();
+
+  // every worker has to check in, so that none of them still looks at this batch
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done.wait(lock, [this]
+              { return m_active == 0; });
+  m_task = nullptr;
+}
+
+void TpcWorkerPool::work()
+{
+  unsigned int generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start.wait(lock, [this, generation]
+                   { return m_stop || m_generation != generation; });
+      if (m_stop)
+      {
+        return;
+      }
+      generation = m_generation;
+    }
+
+    process();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (--m_active == 0)
+    {
+      m_done.notify_one();
+    }
+  }
+}
+
+void TpcWorkerPool::process()
+{
+  for (std::size_t i = m_next++; i < m_ntasks; i = m_next++)
+  {
+    (*m_task)(i);
+  }
+}
@@ -0,0 +1,62 @@
+#ifndef TPC_TPCWORKERPOOL_H
+#define TPC_TPCWORKERPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! fixed set of worker threads, started once and kept for the whole run
+/*!
+ * run() executes a batch of independent tasks and returns when all of them are
+ * done. Tasks are handed out one by one through a shared atomic cursor, so that
+ * threads which finish early keep taking the remaining work instead of waiting for
+ * a static share. The calling thread takes part in the processing.
+ * Batches are processed one at a time, run() must not be called concurrently.
+ */
+class TpcWorkerPool
+{
+ public:
+  //! total number of threads, including the caller. 0 uses the hardware concurrency
+  explicit TpcWorkerPool(unsigned int nthreads = 0);
+  ~TpcWorkerPool();
+
+  TpcWorkerPool(const TpcWorkerPool &) = delete;
+  TpcWorkerPool &operator=(const TpcWorkerPool &) = delete;
+
+  //! number of threads processing a batch, including the caller
+  unsigned int size() const { return m_workers.size() + 1; }
+
+  //! call task(i) for all i in [0, ntasks) and wait for completion
+  void run(std::size_t ntasks, const std::function<void(std::size_t)> &task);
+
+ private:
+  //! worker thread loop
+  void work();
+
+  //! take tasks from the current batch until it is empty
+  void process();
+
+  std::vector<std::thread> m_workers;
+
+  std::mutex m_mutex;
+  std::condition_variable m_start;
+  std::condition_variable m_done;
+
+  const std::function<void(std::size_t)> *m_task = nullptr;
+  std::size_t m_ntasks = 0;
+  std::atomic<std::size_t> m_next{0};
+
+  //! incremented for each batch, wakes up the workers
+  unsigned int m_generation = 0;
+
+  //! workers which did not finish the current batch yet
+  unsigned int m_active = 0;
+
+  bool m_stop = false;
+};
+
+#endif
@@ -0,0 +1,180 @@
+// checks that TpcDistortionCorrectionGrid reproduces the chain of distortion corrections it was built from,
+// within a tolerance, for two chained 3D containers with a TPC like binning. Also checks that the batched and
+// single position methods agree, and that positions outside of the grid are flagged and left unchanged
+
+#include "TpcDistortionCorrection.h"
+#include "TpcDistortionCorrectionContainer.h"
+#include "TpcDistortionCorrectionGrid.h"
+
+#include <TH3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // smooth corrections (cm) in (phi, r, z), vanishing at the readout and with guard bins in phi
+  TH3* make_histogram(const std::string& name, int side, double amplitude, double frequency)
+  {
+    const double zmin = side ? -1. : -105.5;
+    const double zmax = side ? 105.5 : 1.;
+    auto* h = new TH3F(name.c_str(), name.c_str(), 38, -2 * M_PI / 36, 2 * M_PI + 2 * M_PI / 36, 18, 20, 78, 42, zmin, zmax);
+    for (int iphi = 0; iphi <= 39; ++iphi)
+    {
+      for (int ir = 0; ir <= 19; ++ir)
+      {
+        for (int iz = 0; iz <= 43; ++iz)
+        {
+          const double phi = h->GetXaxis()->GetBinCenter(iphi);
+          const double r = h->GetYaxis()->GetBinCenter(ir);
+          const double z = h->GetZaxis()->GetBinCenter(iz);
+          h->SetBinContent(iphi, ir, iz, amplitude * (std::sin(frequency * phi) * (1 - std::abs(z) / 105.5) * (r - 20) / 58. + 0.1));
+        }
+      }
+    }
+    return h;
+  }
+
+  void fill_container(TpcDistortionCorrectionContainer& container, const std::string& name, double amplitude, int frequency)
+  {
+    container.m_phi_hist_in_radians = false;
+    for (int side = 0; side < 2; ++side)
+    {
+      const auto suffix = name + std::to_string(side);
+      container.m_hDPint[side] = make_histogram("hDP" + suffix, side, 0.6 * amplitude, 3 + frequency);
+      container.m_hDRint[side] = make_histogram("hDR" + suffix, side, amplitude, 2 + frequency);
+      container.m_hDZint[side] = make_histogram("hDZ" + suffix, side, 0.4 * amplitude, 1 + frequency);
+    }
+  }
+
+  void delete_histograms(TpcDistortionCorrectionContainer& container)
+  {
+    for (int side = 0; side < 2; ++side)
+    {
+      delete container.m_hDPint[side];
+      delete container.m_hDRint[side];
+      delete container.m_hDZint[side];
+    }
+  }
+}  // namespace
+
+int main()
+{
+  // static and average like corrections, of up to about 1 cm
+  TpcDistortionCorrectionContainer static_corrections;
+  TpcDistortionCorrectionContainer average_corrections;
+  fill_container(static_corrections, "static", 0.8, 0);
+  fill_container(average_corrections, "average", 0.3, 2);
+  const std::vector<const TpcDistortionCorrectionContainer*> chain = {&static_corrections, &average_corrections};
+
+  TpcDistortionCorrection correction;
+  auto apply_chain = [&](Acts::Vector3 position)
+  {
+    for (const auto* container : chain)
+    {
+      position = correction.get_corrected_position(position, container);
+    }
+    return position;
+  };
+
+  // random positions in the TPC, and a few outside
+  std::mt19937 rng(24680);
+  std::uniform_real_distribution<double> r_dist(22, 76);
+  std::uniform_real_distribution<double> phi_dist(-M_PI, M_PI);
+  std::uniform_real_distribution<double> z_dist(-104, 104);
+  std::vector<Acts::Vector3> positions;
+  for (int i = 0; i < 200000; ++i)
+  {
+    const double r = r_dist(rng);
+    const double phi = phi_dist(rng);
+    positions.emplace_back(r * std::cos(phi), r * std::sin(phi), z_dist(rng));
+  }
+  const std::vector<Acts::Vector3> outside_positions = {{100, 0, 0}, {0, 10, 0}, {30, 30, 110}, {-40, 0, -110}};
+  positions.insert(positions.end(), outside_positions.begin(), outside_positions.end());
+
+  int failures = 0;
+  for (const unsigned int oversampling : {1U, 2U})
+  {
+    TpcDistortionCorrectionGrid grid;
+    grid.set_oversampling(oversampling);
+    grid.build(chain, correction);
+    if (!grid.valid())
+    {
+      std::cout << "testcorrectiongrid - oversampling " << oversampling << ": grid not built" << std::endl;
+      ++failures;
+      continue;
+    }
+
+    auto batch = positions;
+    std::vector<size_t> outside;
+    grid.get_corrected_positions(batch, outside);
+
+    // outside positions are flagged and not corrected
+    for (const auto& position : outside_positions)
+    {
+      auto single = position;
+      if (grid.get_corrected_position(single) || single != position)
+      {
+        std::cout << "testcorrectiongrid - oversampling " << oversampling << ": position outside of the grid was corrected" << std::endl;
+        ++failures;
+      }
+    }
+
+    double max_deviation = 0;
+    double sum_deviation = 0;
+    size_t ninside = 0;
+    size_t ioutside = 0;
+    for (size_t i = 0; i < positions.size(); ++i)
+    {
+      auto single = positions[i];
+      const bool inside = grid.get_corrected_position(single);
+      const bool flagged = ioutside < outside.size() && outside[ioutside] == i;
+      if (flagged)
+      {
+        ++ioutside;
+      }
+
+      // batched and single corrections must be identical
+      if (inside == flagged || single != batch[i] || (!inside && single != positions[i]))
+      {
+        std::cout << "testcorrectiongrid - oversampling " << oversampling << ": batched and single corrections differ for position " << i << std::endl;
+        ++failures;
+        continue;
+      }
+
+      if (inside)
+      {
+        const double deviation = (single - apply_chain(positions[i])).norm();
+        max_deviation = std::max(max_deviation, deviation);
+        sum_deviation += deviation;
+        ++ninside;
+      }
+    }
+
+    // the grid covers the TPC but the outermost bins
+    if (ninside < positions.size() / 2)
+    {
+      std::cout << "testcorrectiongrid - oversampling " << oversampling << ": only " << ninside << " positions in the grid" << std::endl;
+      ++failures;
+    }
+
+    // the grid approximates the composition of the interpolations, to a few microns on average
+    const double mean_deviation = ninside ? sum_deviation / ninside : 0;
+    std::cout << "testcorrectiongrid - oversampling " << oversampling << ": " << ninside << " positions in the grid, deviation from the chain mean "
+              << mean_deviation * 1e4 << " um, max " << max_deviation * 1e4 << " um" << std::endl;
+    if (mean_deviation > 10e-4 || max_deviation > 150e-4)
+    {
+      ++failures;
+    }
+  }
+
+  delete_histograms(static_corrections);
+  delete_histograms(average_corrections);
+
+  std::cout << "testcorrectiongrid - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,171 @@
+// checks that hitsets processed on a TpcWorkerPool give the same output as a serial loop.
+// The tasks mimic TpcClusterizer: each one clusterizes its own adc array with thread_local
+// scratch buffers into its own output buffer, and the buffers are merged in task order.
+
+#include "TpcWorkerPool.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  constexpr int nphi = 64;
+  constexpr int nt = 128;
+
+  struct Cluster
+  {
+    uint32_t key = 0;
+    double phi = 0;
+    double t = 0;
+    unsigned int adc = 0;
+
+    bool operator==(const Cluster &other) const
+    {
+      return key == other.key && phi == other.phi && t == other.t && adc == other.adc;
+    }
+  };
+
+  struct Task
+  {
+    std::vector<unsigned short> adc;
+    std::vector<Cluster> clusters;
+    int calls = 0;
+  };
+
+  // seeds above threshold which are local maxima, centroid over a 5x5 window
+  void clusterize(const std::size_t itask, Task &task)
+  {
+    ++task.calls;
+    task.clusters.clear();
+
+    // scratch copy, reused by the thread as in TpcClusterizer
+    static thread_local std::vector<unsigned short> adcval;
+    adcval = task.adc;
+
+    for (int iphi = 2; iphi < nphi - 2; ++iphi)
+    {
+      for (int it = 2; it < nt - 2; ++it)
+      {
+        const unsigned short seed = adcval[iphi * nt + it];
+        if (seed < 100)
+        {
+          continue;
+        }
+        bool maximum = true;
+        double sum = 0;
+        double sumphi = 0;
+        double sumt = 0;
+        for (int dphi = -2; dphi <= 2; ++dphi)
+        {
+          for (int dt = -2; dt <= 2; ++dt)
+          {
+            const unsigned short adc = adcval[(iphi + dphi) * nt + it + dt];
+            maximum = maximum && adc <= seed;
+            sum += adc;
+            sumphi += adc * (iphi + dphi);
+            sumt += adc * (it + dt);
+          }
+        }
+        if (maximum)
+        {
+          task.clusters.push_back({static_cast<uint32_t>((itask << 16U) + task.clusters.size()), sumphi / sum, sumt / sum, static_cast<unsigned int>(sum)});
+        }
+      }
+    }
+  }
+
+  // one event: tasks with very different occupancies, so that the threads finish at different times
+  std::vector<Task> make_event(std::mt19937 &rng)
+  {
+    std::vector<Task> tasks(288);
+    for (auto &task : tasks)
+    {
+      task.adc.resize(nphi * nt);
+      for (auto &adc : task.adc)
+      {
+        adc = rng() % 20;
+      }
+      const unsigned int npeaks = rng() % 40;
+      for (unsigned int ipeak = 0; ipeak < npeaks; ++ipeak)
+      {
+        const int iphi = rng() % nphi;
+        const int it = rng() % nt;
+        const unsigned short amplitude = 100 + rng() % 900;
+        for (int dphi = -1; dphi <= 1; ++dphi)
+        {
+          for (int dt = -1; dt <= 1; ++dt)
+          {
+            if (iphi + dphi >= 0 && iphi + dphi < nphi && it + dt >= 0 && it + dt < nt)
+            {
+              task.adc[(iphi + dphi) * nt + it + dt] += amplitude >> (std::abs(dphi) + std::abs(dt));
+            }
+          }
+        }
+      }
+    }
+    return tasks;
+  }
+
+  // merge the task outputs in task order, as TpcClusterizer fills its containers
+  std::vector<Cluster> merge(const std::vector<Task> &tasks)
+  {
+    std::vector<Cluster> clusters;
+    for (const auto &task : tasks)
+    {
+      clusters.insert(clusters.end(), task.clusters.begin(), task.clusters.end());
+    }
+    return clusters;
+  }
+}  // namespace
+
+int main()
+{
+  int failures = 0;
+  for (const unsigned int nthreads : {1U, 2U, 4U, 8U})
+  {
+    // the pool is kept for all events, as in TpcClusterizer
+    TpcWorkerPool pool(nthreads);
+    if (pool.size() != nthreads)
+    {
+      std::cout << "testworkerpool - " << pool.size() << " threads, expected " << nthreads << std::endl;
+      ++failures;
+    }
+
+    std::mt19937 rng(1357);
+    for (int event = 0; event < 20; ++event)
+    {
+      auto tasks = make_event(rng);
+      auto serial_tasks = tasks;
+
+      for (std::size_t i = 0; i < serial_tasks.size(); ++i)
+      {
+        clusterize(i, serial_tasks[i]);
+      }
+      pool.run(tasks.size(), [&tasks](std::size_t i)
+               { clusterize(i, tasks[i]); });
+
+      bool once = true;
+      for (const auto &task : tasks)
+      {
+        once = once && task.calls == 1;
+      }
+      if (!once || merge(tasks) != merge(serial_tasks))
+      {
+        std::cout << "testworkerpool - " << nthreads << " threads, event " << event << ": output differs from the serial loop" << std::endl;
+        ++failures;
+      }
+    }
+
+    // empty batch
+    pool.run(0, [&failures](std::size_t)
+             {
+      std::cout << "testworkerpool - task called in an empty batch" << std::endl;
+      ++failures; });
+  }
+
+  std::cout << "testworkerpool - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -9,6 +9,31 @@
 #include "TpcSpaceChargeMatrixContainerv2.h"
 
 #include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+  // element-wise sum of two vectors of the same size
+  template <class T>
+  void add_arrays(std::vector<T>& destination, const std::vector<T>& source)
+  {
+    for (size_t i = 0; i < destination.size(); ++i)
+    {
+      if constexpr (std::is_arithmetic_v<T>)
+      {
+        destination[i] += source[i];
+      }
+      else
+      {
+        for (size_t j = 0; j < destination[i].size(); ++j)
+        {
+          destination[i][j] += source[i][j];
+        }
+      }
+    }
+  }
+}  // namespace
 
 //___________________________________________________________
 TpcSpaceChargeMatrixContainerv2::TpcSpaceChargeMatrixContainerv2()
@@ -245,6 +270,19 @@ bool TpcSpaceChargeMatrixContainerv2::add(const TpcSpaceChargeMatrixContainer& o
     return false;
   }
 
+  // same class, add the arrays directly
+  if (const auto* other_v2 = dynamic_cast<const TpcSpaceChargeMatrixContainerv2*>(&other))
+  {
+    add_arrays(m_entries, other_v2->m_entries);
+    add_arrays(m_lhs, other_v2->m_lhs);
+    add_arrays(m_rhs, other_v2->m_rhs);
+    add_arrays(m_lhs_rphi, other_v2->m_lhs_rphi);
+    add_arrays(m_rhs_rphi, other_v2->m_rhs_rphi);
+    add_arrays(m_lhs_z, other_v2->m_lhs_z);
+    add_arrays(m_rhs_z, other_v2->m_rhs_z);
+    return true;
+  }
+
   // increment cell entries
   for (size_t cell_index = 0; cell_index < m_lhs.size(); ++cell_index)
   {
@@ -9,15 +9,21 @@
 #include "TpcSpaceChargeReconstructionHelper.h"
 
 #include <frog/FROG.h>
+#include <phool/PHTimer.h>
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 #include <TFile.h>
 #include <TH2.h>
 #include <TH3.h>
+#include <TROOT.h>
 
 #include <Eigen/Core>
 #include <Eigen/Dense>
 
+#include <omp.h>
+
+#include <array>
+#include <cstdint>
 #include <memory>
 
 namespace
@@ -64,6 +70,50 @@ namespace
     return out;
   }
 
+  // create an empty matrix container with the same grid as source
+  std::unique_ptr<TpcSpaceChargeMatrixContainer> make_container( const TpcSpaceChargeMatrixContainer& source )
+  {
+    std::unique_ptr<TpcSpaceChargeMatrixContainer> out(new TpcSpaceChargeMatrixContainerv2);
+
+    // get grid dimensions from source
+    int phibins = 0;
+    int rbins = 0;
+    int zbins = 0;
+    source.get_grid_dimensions(phibins, rbins, zbins);
+
+    // assign
+    out->set_grid_dimensions(phibins, rbins, zbins);
+    return out;
+  }
+
+  // load matrix container from file
+  std::unique_ptr<TpcSpaceChargeMatrixContainer> load_container( const std::string& filename, const std::string& objectname )
+  {
+    // open TFile
+    std::unique_ptr<TFile> inputfile(TFile::Open(filename.c_str()));
+    if (!inputfile)
+    {
+      std::cout << "TpcSpaceChargeMatrixInversion::load_container - could not open file " << filename << std::endl;
+      return nullptr;
+    }
+
+    // load object from input file
+    std::unique_ptr<TpcSpaceChargeMatrixContainer> source(dynamic_cast<TpcSpaceChargeMatrixContainer*>(inputfile->Get(objectname.c_str())));
+    if (!source)
+    {
+      std::cout << "TpcSpaceChargeMatrixInversion::load_container - could not find object name " << objectname << " in file " << filename << std::endl;
+    }
+    return source;
+  }
+
+  // distortions and errors of one cell
+  struct cell_result_t
+  {
+    int entries = 0;
+    std::array<float, 3> value = {};
+    std::array<float, 3> error = {};
+  };
+
 }  // namespace
 
 //_____________________________________________________________________
@@ -149,19 +199,10 @@ bool TpcSpaceChargeMatrixInversion::add_from_file(const std::string& shortfilena
   FROG frog;
   const auto *const filename = frog.location(shortfilename);
 
-  // open TFile
-  std::unique_ptr<TFile> inputfile(TFile::Open(filename));
-  if (!inputfile)
-  {
-    std::cout << "TpcSpaceChargeMatrixInversion::add_from_file - could not open file " << filename << std::endl;
-    return false;
-  }
-
   // load object from input file
-  std::unique_ptr<TpcSpaceChargeMatrixContainer> source(dynamic_cast<TpcSpaceChargeMatrixContainer*>(inputfile->Get(objectname.c_str())));
+  const auto source = load_container(filename, objectname);
   if (!source)
   {
-    std::cout << "TpcSpaceChargeMatrixInversion::add_from_file - could not find object name " << objectname << " in file " << filename << std::endl;
     return false;
   }
 
@@ -177,22 +218,125 @@ bool TpcSpaceChargeMatrixInversion::add_from_file(const std::string& shortfilena
   return add(*source);
 }
 
+//_____________________________________________________________________
+bool TpcSpaceChargeMatrixInversion::add_from_files(const std::vector<std::string>& shortfilenames, const std::string& objectname)
+{
+  PHTimer timer("add_from_files");
+  timer.restart();
+
+  // get filenames from frog. This is done first because FROG is not thread safe
+  std::vector<std::string> filenames;
+  filenames.reserve(shortfilenames.size());
+  FROG frog;
+  for (const auto& shortfilename : shortfilenames)
+  {
+    filenames.emplace_back(frog.location(shortfilename));
+  }
+
+  // files are opened from several threads
+  ROOT::EnableThreadSafety();
+
+  const int nthreads = m_num_threads >= 1 ? m_num_threads : omp_get_max_threads();
+  const int nfiles = filenames.size();
+
+  // the files are split in nthreads contiguous blocks, each block is summed in file order
+  // into its own container. The partition only depends on the number of files and threads,
+  // so that the float sums, and the resulting corrections, are the same from one run to the next
+  std::vector<std::unique_ptr<TpcSpaceChargeMatrixContainer>> partial_sums(nthreads);
+  bool success = true;
+
+  #pragma omp parallel for num_threads(nthreads) schedule(static, 1)
+  for (int block = 0; block < nthreads; ++block)
+  {
+    auto& partial_sum = partial_sums[block];
+    const int first = static_cast<int64_t>(nfiles) * block / nthreads;
+    const int last = static_cast<int64_t>(nfiles) * (block + 1) / nthreads;
+    for (int i = first; i < last; ++i)
+    {
+      const auto source = load_container(filenames[i], objectname);
+      if (!source)
+      {
+        #pragma omp atomic write
+        success = false;
+        continue;
+      }
+
+      if( Verbosity() )
+      {
+        #pragma omp critical
+        std::cout << "TpcSpaceChargeMatrixInversion::add_from_files -"
+          << " file: " << filenames[i]
+          << " objectname: " << objectname
+          << " entries: " << source->get_entries()
+          << std::endl;
+      }
+
+      if (!partial_sum)
+      {
+        partial_sum = make_container(*source);
+      }
+
+      if (!partial_sum->add(*source))
+      {
+        #pragma omp atomic write
+        success = false;
+      }
+    }
+  }
+
+  // merge the partial sums pairwise, in log2(nthreads) steps. The pairs are fixed by the block index
+  for (int stride = 1; stride < nthreads; stride *= 2)
+  {
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (int i = 0; i < nthreads - stride; i += 2 * stride)
+    {
+      auto& first = partial_sums[i];
+      auto& second = partial_sums[i + stride];
+      if (!second)
+      {
+        continue;
+      }
+
+      if (!first)
+      {
+        first = std::move(second);
+      }
+      else
+      {
+        if (!first->add(*second))
+        {
+          #pragma omp atomic write
+          success = false;
+        }
+        second.reset();
+      }
+    }
+  }
+
+  // add to current
+  if (partial_sums.front() && !add(*partial_sums.front()))
+  {
+    success = false;
+  }
+
+  timer.stop();
+  std::cout << "TpcSpaceChargeMatrixInversion::add_from_files -"
+    << " files: " << nfiles
+    << " threads: " << nthreads
+    << " entries: " << (m_matrix_container ? m_matrix_container->get_entries() : 0)
+    << " time (ms): " << timer.get_accumulated_time()
+    << std::endl;
+
+  return success;
+}
+
 //_____________________________________________________________________
 bool TpcSpaceChargeMatrixInversion::add(const TpcSpaceChargeMatrixContainer& source)
 {
   // check internal container, create if necessary
   if (!m_matrix_container)
   {
-    m_matrix_container.reset(new TpcSpaceChargeMatrixContainerv2);
-
-    // get grid dimensions from source
-    int phibins = 0;
-    int rbins = 0;
-    int zbins = 0;
-    source.get_grid_dimensions(phibins, rbins, zbins);
-
-    // assign
-    m_matrix_container->set_grid_dimensions(phibins, rbins, zbins);
+    m_matrix_container = make_container(source);
   }
 
   // add content
@@ -230,131 +374,167 @@ void TpcSpaceChargeMatrixInversion::calculate_distortion_corrections(const Inver
     h->GetZaxis()->SetTitle("z (cm)");
   }
 
-  // loop over bins
+  PHTimer timer("calculate_distortion_corrections");
+  timer.restart();
+
+  /*
+   * cells are independent. They are inverted in parallel and the results stored,
+   * histograms are filled afterwards. In verbose mode a single thread is used so that printouts come in order
+   */
+  const int nthreads = Verbosity() ? 1 : (m_num_threads >= 1 ? m_num_threads : omp_get_max_threads());
+  const int ncells = phibins * rbins * zbins;
+  std::vector<cell_result_t> cell_results(ncells);
+
+  #pragma omp parallel for num_threads(nthreads) schedule(dynamic, 64)
+  for (int index = 0; index < ncells; ++index)
+  {
+    // same ordering as the phi, r and z loops
+    const int iz = index % zbins;
+    const int ir = (index / zbins) % rbins;
+    const int iphi = index / (zbins * rbins);
+
+    // get cell index
+    const auto icell = m_matrix_container->get_cell_index(iphi, ir, iz);
+    auto& cell_result = cell_results[index];
+
+    // minimum number of entries per bin
+    static constexpr int min_cluster_count = 2;
+    const auto cell_entries = m_matrix_container->get_entries(icell);
+    if (cell_entries < min_cluster_count)
+    {
+      continue;
+    }
+
+    switch( inversionMode )
+    {
+      case InversionMode::FullInversion:
+      {
+        /* number of coordinates must match that of the matrix container */
+        static constexpr int ncoord = 3;
+        using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
+        using column_t = Eigen::Matrix<float, ncoord, 1>;
+
+        // build eigen matrices from container
+        matrix_t lhs = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs,ncoord>(m_matrix_container.get(),icell);
+        column_t rhs = get_column<&TpcSpaceChargeMatrixContainer::get_rhs,ncoord>(m_matrix_container.get(),icell);
+
+        if (Verbosity())
+        {
+          // print matrices and entries
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - inverting bin " << iz << ", " << ir << ", " << iphi << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - entries: " << cell_entries << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - lhs: \n"
+            << lhs << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - rhs: \n"
+            << rhs << std::endl;
+        }
+
+        // calculate result using linear solving
+        const auto cov = lhs.inverse();
+        auto partialLu = lhs.partialPivLu();
+        const auto result = partialLu.solve(rhs);
+
+        // store
+        cell_result.entries = cell_entries;
+        cell_result.value = {result(0), result(1), result(2)};
+        cell_result.error = {std::sqrt(cov(0, 0)), std::sqrt(cov(1, 1)), std::sqrt(cov(2, 2))};
+
+        if (Verbosity())
+        {
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result(0) << " +/- " << std::sqrt(cov(0, 0)) << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result(1) << " +/- " << std::sqrt(cov(1, 1)) << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr: " << result(2) << " +/- " << std::sqrt(cov(2, 2)) << std::endl;
+          std::cout << std::endl;
+        }
+        break;
+      }
+
+      case InversionMode::ReducedInversion_phi:
+      case InversionMode::ReducedInversion_z:
+      {
+        /* number of coordinates must match that of the matrix container */
+        static constexpr int ncoord = 2;
+        using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
+        using column_t = Eigen::Matrix<float, ncoord, 1>;
+
+        // build rphi eigen matrices from container and invert
+        matrix_t lhs_rphi = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs_rphi,ncoord>(m_matrix_container.get(),icell);
+        column_t rhs_rphi = get_column<&TpcSpaceChargeMatrixContainer::get_rhs_rphi,ncoord>(m_matrix_container.get(),icell);
+        const auto cov_rphi = lhs_rphi.inverse();
+        auto partialLu_rphi = lhs_rphi.partialPivLu();
+        const auto result_rphi = partialLu_rphi.solve(rhs_rphi);
+
+        // build z eigen matrices from container and invert
+        matrix_t lhs_z = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs_z,ncoord>(m_matrix_container.get(),icell);
+        column_t rhs_z = get_column<&TpcSpaceChargeMatrixContainer::get_rhs_z,ncoord>(m_matrix_container.get(),icell);
+        const auto cov_z = lhs_z.inverse();
+        auto partialLu_z = lhs_z.partialPivLu();
+        const auto result_z = partialLu_z.solve(rhs_z);
+
+        // store
+        cell_result.entries = cell_entries;
+        cell_result.value[0] = result_rphi(0);
+        cell_result.error[0] = std::sqrt(cov_rphi(0, 0));
+
+        cell_result.value[1] = result_z(0);
+        cell_result.error[1] = std::sqrt(cov_z(0, 0));
+
+        if( inversionMode == InversionMode::ReducedInversion_phi )
+        {
+          cell_result.value[2] = result_rphi(1);
+          cell_result.error[2] = std::sqrt(cov_rphi(1, 1));
+        } else if( inversionMode == InversionMode::ReducedInversion_z ) {
+          cell_result.value[2] = result_z(1);
+          cell_result.error[2] = std::sqrt(cov_z(1, 1));
+        }
+
+
+        if (Verbosity())
+        {
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result_rphi(0) << " +/- " << std::sqrt(cov_rphi(0, 0)) << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result_z(0) << " +/- " << std::sqrt(cov_z(0, 0)) << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (rphi): " << result_rphi(1) << " +/- " << std::sqrt(cov_rphi(1, 1)) << std::endl;
+          std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (z): " << result_z(1) << " +/- " << std::sqrt(cov_z(1, 1)) << std::endl;
+          std::cout << std::endl;
+        }
+        break;
+      }
+    }
+  }
+
+  // fill histograms
   for (int iphi = 0; iphi < phibins; ++iphi)
   {
     for (int ir = 0; ir < rbins; ++ir)
     {
       for (int iz = 0; iz < zbins; ++iz)
       {
-        // get cell index
-        const auto icell = m_matrix_container->get_cell_index(iphi, ir, iz);
-
-        // minimum number of entries per bin
-        static constexpr int min_cluster_count = 2;
-        const auto cell_entries = m_matrix_container->get_entries(icell);
-        if (cell_entries < min_cluster_count)
+        const auto& cell_result = cell_results[iz + zbins * (ir + rbins * iphi)];
+        if (!cell_result.entries)
         {
           continue;
         }
 
-        switch( inversionMode )
-        {
-          case InversionMode::FullInversion:
-          {
-            /* number of coordinates must match that of the matrix container */
-            static constexpr int ncoord = 3;
-            using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
-            using column_t = Eigen::Matrix<float, ncoord, 1>;
-
-            // build eigen matrices from container
-            matrix_t lhs = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs,ncoord>(m_matrix_container.get(),icell);
-            column_t rhs = get_column<&TpcSpaceChargeMatrixContainer::get_rhs,ncoord>(m_matrix_container.get(),icell);
-
-            if (Verbosity())
-            {
-              // print matrices and entries
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - inverting bin " << iz << ", " << ir << ", " << iphi << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - entries: " << cell_entries << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - lhs: \n"
-                << lhs << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - rhs: \n"
-                << rhs << std::endl;
-            }
-
-            // calculate result using linear solving
-            const auto cov = lhs.inverse();
-            auto partialLu = lhs.partialPivLu();
-            const auto result = partialLu.solve(rhs);
-
-            // fill histograms
-            hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_entries);
-
-            hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, result(0));
-            hphi->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(0, 0)));
-
-            hz->SetBinContent(iphi + 1, ir + 1, iz + 1, result(1));
-            hz->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(1, 1)));
-
-            hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result(2));
-            hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov(2, 2)));
-
-            if (Verbosity())
-            {
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result(0) << " +/- " << std::sqrt(cov(0, 0)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result(1) << " +/- " << std::sqrt(cov(1, 1)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr: " << result(2) << " +/- " << std::sqrt(cov(2, 2)) << std::endl;
-              std::cout << std::endl;
-            }
-            break;
-          }
-
-          case InversionMode::ReducedInversion_phi:
-          case InversionMode::ReducedInversion_z:
-          {
-            /* number of coordinates must match that of the matrix container */
-            static constexpr int ncoord = 2;
-            using matrix_t = Eigen::Matrix<float, ncoord, ncoord>;
-            using column_t = Eigen::Matrix<float, ncoord, 1>;
-
-            // build rphi eigen matrices from container and invert
-            matrix_t lhs_rphi = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs_rphi,ncoord>(m_matrix_container.get(),icell);
-            column_t rhs_rphi = get_column<&TpcSpaceChargeMatrixContainer::get_rhs_rphi,ncoord>(m_matrix_container.get(),icell);
-            const auto cov_rphi = lhs_rphi.inverse();
-            auto partialLu_rphi = lhs_rphi.partialPivLu();
-            const auto result_rphi = partialLu_rphi.solve(rhs_rphi);
-
-            // build z eigen matrices from container and invert
-            matrix_t lhs_z = get_matrix<&TpcSpaceChargeMatrixContainer::get_lhs_z,ncoord>(m_matrix_container.get(),icell);
-            column_t rhs_z = get_column<&TpcSpaceChargeMatrixContainer::get_rhs_z,ncoord>(m_matrix_container.get(),icell);
-            const auto cov_z = lhs_z.inverse();
-            auto partialLu_z = lhs_z.partialPivLu();
-            const auto result_z = partialLu_z.solve(rhs_z);
-
-            // fill histograms
-            hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_entries);
-
-            hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, result_rphi(0));
-            hphi->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_rphi(0, 0)));
-
-            hz->SetBinContent(iphi + 1, ir + 1, iz + 1, result_z(0));
-            hz->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_z(0, 0)));
-
-            if( inversionMode == InversionMode::ReducedInversion_phi )
-            {
-              hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result_rphi(1));
-              hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_rphi(1, 1)));
-            } else if( inversionMode == InversionMode::ReducedInversion_z ) {
-              hr->SetBinContent(iphi + 1, ir + 1, iz + 1, result_z(1));
-              hr->SetBinError(iphi + 1, ir + 1, iz + 1, std::sqrt(cov_z(1, 1)));
-            }
-
-
-            if (Verbosity())
-            {
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dphi: " << result_rphi(0) << " +/- " << std::sqrt(cov_rphi(0, 0)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dz: " << result_z(0) << " +/- " << std::sqrt(cov_z(0, 0)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (rphi): " << result_rphi(1) << " +/- " << std::sqrt(cov_rphi(1, 1)) << std::endl;
-              std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections - dr (z): " << result_z(1) << " +/- " << std::sqrt(cov_z(1, 1)) << std::endl;
-              std::cout << std::endl;
-            }
-            break;
-          }
-        }
+        hentries->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.entries);
+
+        hphi->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.value[0]);
+        hphi->SetBinError(iphi + 1, ir + 1, iz + 1, cell_result.error[0]);
+
+        hz->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.value[1]);
+        hz->SetBinError(iphi + 1, ir + 1, iz + 1, cell_result.error[1]);
+
+        hr->SetBinContent(iphi + 1, ir + 1, iz + 1, cell_result.value[2]);
+        hr->SetBinError(iphi + 1, ir + 1, iz + 1, cell_result.error[2]);
+      }
+    }
+  }
 
-      } // z-loop
-    } // r-loop
-  } // phi-loop
+  timer.stop();
+  std::cout << "TpcSpaceChargeMatrixInversion::calculate_distortion_corrections -"
+    << " cells: " << ncells
+    << " threads: " << nthreads
+    << " time (ms): " << timer.get_accumulated_time()
+    << std::endl;
 
   // split histograms in two along z axis and write
   // also write histograms suitable for space charge reconstruction
@@ -12,6 +12,8 @@
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 /**
  * \class TpcSpaceChargeMatrixInversion
@@ -39,6 +41,18 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
   /// add space charge correction matrix, loaded from file, to current. Returns true on success
   bool add_from_file(const std::string& /*filename*/, const std::string& /*objectname*/ = "TpcSpaceChargeMatrixContainer");
 
+  /// add space charge correction matrices, loaded from files, to current. Returns true on success
+  /**
+   * files are split in one contiguous block per thread, each block is summed in file order,
+   * and the block sums are merged pairwise in block order. The result is reproducible for a given
+   * number of threads, but the summation order differs from calling add_from_file on each file,
+   * or from using another number of threads, which can change the matrices at the level of the float rounding
+   */
+  bool add_from_files(const std::vector<std::string>& /*filenames*/, const std::string& /*objectname*/ = "TpcSpaceChargeMatrixContainer");
+
+  /// number of threads used to read matrices and to invert them. 0 uses the OpenMP default
+  void set_num_threads(int value) { m_num_threads = value; }
+
   enum class InversionMode
   {
     FullInversion,        // use 3D matrices (phi,z,r)
@@ -47,6 +61,7 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
   };
 
   /// calculate distortions by inverting stored matrices, and save relevant histograms
+  /** cells are inverted in parallel, unless Verbosity is set, in which case they are inverted and printed in order */
   void calculate_distortion_corrections(const InversionMode = InversionMode::FullInversion);
 
   /// extrapolate distortions
@@ -66,6 +81,9 @@ class TpcSpaceChargeMatrixInversion : public Fun4AllBase
 
   /// central membrane distortion container
   std::unique_ptr<TpcDistortionCorrectionContainer> m_dcc_cm;
+
+  /// number of threads
+  int m_num_threads = 0;
 };
 
 #endif
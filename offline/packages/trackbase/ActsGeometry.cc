@@ -173,16 +173,16 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
   double surfStepPhi = m_tGeometry.tpcSurfStepPhi;
 	
   // returns an iterator to all of the surfaces for this layer
-  auto mapIter = m_surfMaps.m_tpcSurfaceMap.find(layer);
+  const auto* surfaces = m_surfMaps.getTpcSurfaceVector(layer);
 
-  if (mapIter == m_surfMaps.m_tpcSurfaceMap.end())
+  if (!surfaces)
   {
     std::cout << "Error: hitsetkey not found in ActsGeometry::get_tpc_surface_from_coords, hitsetkey = "
               << hitsetkey << std::endl;
     return nullptr;
   }
 
-  const auto& surf_vec = mapIter->second;
+  const auto& surf_vec = *surfaces;
   unsigned int surf_index = 999;
 
   // convert global to mm for consistency with surface centers
@@ -266,16 +266,16 @@ Surface ActsGeometry::get_clusterizer_tpc_surface(
   double surfStepPhi = m_tGeometry.tpcSurfStepPhi;
   
   // returns an iterator to all of the surfaces for this layer
-  auto mapIter = m_surfMaps.m_tpcSurfaceMap.find(layer);
+  const auto* surfaces = m_surfMaps.getTpcSurfaceVector(layer);
 
-  if (mapIter == m_surfMaps.m_tpcSurfaceMap.end())
+  if (!surfaces)
   {
     std::cout << "Error: hitsetkey not found in ActsGeometry::get_tpc_surface_from_coords, hitsetkey = "
               << hitsetkey << std::endl;
     return nullptr;
   }
 
-  const auto& surf_vec = mapIter->second;
+  const auto& surf_vec = *surfaces;
   unsigned int surf_index = 999;
 
   // convert position to mm for consistency with surfaces
@@ -0,0 +1,56 @@
+#include "ActsPHFieldProvider.h"
+
+#include <phfield/PHField.h>
+
+#include <Acts/Definitions/Units.hpp>
+
+#include <CLHEP/Units/SystemOfUnits.h>
+
+#include <cassert>
+#include <utility>
+
+namespace
+{
+  //! PHField gives the field in Geant4/CLHEP units
+  constexpr double field_unit = Acts::UnitConstants::T / CLHEP::tesla;
+}  // namespace
+
+//________________________________________________________________
+ActsPHFieldProvider::ActsPHFieldProvider(const PHField* field)
+  : m_field(field)
+{
+  assert(m_field);
+}
+
+//________________________________________________________________
+Acts::MagneticFieldProvider::Cache ActsPHFieldProvider::makeCache(const Acts::MagneticFieldContext& mctx) const
+{
+  return Acts::MagneticFieldProvider::Cache(std::in_place_type<Cache>, mctx);
+}
+
+//________________________________________________________________
+Acts::Result<Acts::Vector3> ActsPHFieldProvider::getField(const Acts::Vector3& position, Acts::MagneticFieldProvider::Cache& cache) const
+{
+  auto& lcache = cache.as<Cache>();
+
+  // both Acts and PHField use mm
+  const double point[4] = {position.x(), position.y(), position.z(), 0};
+  double bfield[3] = {0, 0, 0};
+
+  if (!(lcache.valid && lcache.cell.contains(point)))
+  {
+    lcache.valid = m_field->GetFieldCell(point, lcache.cell);
+  }
+
+  if (lcache.valid)
+  {
+    lcache.cell.interpolate(point, bfield);
+  }
+  else
+  {
+    m_field->GetFieldValue_nocache(point, bfield);
+  }
+
+  const Acts::Vector3 field(bfield[0] * field_unit, bfield[1] * field_unit, bfield[2] * field_unit);
+  return Acts::Result<Acts::Vector3>::success(field);
+}
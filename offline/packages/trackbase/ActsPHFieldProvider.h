@@ -0,0 +1,53 @@
+#ifndef TRACKBASE_ACTSPHFIELDPROVIDER_H
+#define TRACKBASE_ACTSPHFIELDPROVIDER_H
+/*!
+ *  \file		ActsPHFieldProvider.h
+ *  \brief		Acts magnetic field provider reading a PHField
+ */
+
+#include <phfield/PHFieldCell.h>
+
+#include <Acts/Definitions/Algebra.hpp>
+#include <Acts/MagneticField/MagneticFieldContext.hpp>
+#include <Acts/MagneticField/MagneticFieldProvider.hpp>
+#include <Acts/Utilities/Result.hpp>
+
+class PHField;
+
+/*!
+ * Gives Acts the same field as the one used in the simulation and by the
+ * other reconstruction modules, instead of a separate Acts field map.
+ *
+ * Acts creates one cache per propagation, so per thread. It holds the map
+ * cell of the last point (see PHField::GetFieldCell) and the stepper
+ * positions inside of the same cell are interpolated without going back
+ * to the map. Fields which do not provide cells are called point by point
+ * through the thread safe PHField::GetFieldValue_nocache.
+ */
+class ActsPHFieldProvider final : public Acts::MagneticFieldProvider
+{
+ public:
+  //! per propagation cache
+  struct Cache
+  {
+    explicit Cache(const Acts::MagneticFieldContext& /*mctx*/) {}
+
+    //! map cell of the last point
+    PHFieldCell cell;
+
+    //! true if cell is from the map
+    bool valid = false;
+  };
+
+  //! the field is not owned, it must live as long as the provider
+  explicit ActsPHFieldProvider(const PHField* field);
+
+  Acts::MagneticFieldProvider::Cache makeCache(const Acts::MagneticFieldContext& mctx) const override;
+
+  Acts::Result<Acts::Vector3> getField(const Acts::Vector3& position, Acts::MagneticFieldProvider::Cache& cache) const override;
+
+ private:
+  const PHField* m_field = nullptr;
+};
+
+#endif
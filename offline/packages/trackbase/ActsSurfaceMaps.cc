@@ -13,6 +13,9 @@
 #include <Acts/Definitions/Units.hpp>
 #include <Acts/Surfaces/Surface.hpp>
 
+#include <iostream>
+#include <limits>
+
 namespace
 {
   /// square
@@ -28,20 +31,177 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  /// hitsetkey layout, see TrkrDefs: tracker id and layer in the upper 16 bits, detector specific lower 16 bits
+  constexpr unsigned int kBitShiftUpper = 16;
+  constexpr TrkrDefs::hitsetkey kLowerMask = 0xFFFF;
+
+  /// volume flags of the dense tables
+  constexpr uint8_t kTpcVolume = 1U << 0U;
+  constexpr uint8_t kSiVolume = 1U << 1U;
+  constexpr uint8_t kMicromegasVolume = 1U << 2U;
+
+  /// silicon hitsetkey with the strobe or crossing bits reset, as stored in the surface map
+  TrkrDefs::hitsetkey reset_silicon_key(TrkrDefs::hitsetkey hitsetkey)
+  {
+    switch (TrkrDefs::getTrkrId(hitsetkey))
+    {
+    case TrkrDefs::inttId:
+      return InttDefs::resetCrossing(hitsetkey);
+    case TrkrDefs::mvtxId:
+      return MvtxDefs::resetStrobe(hitsetkey);
+    default:
+      return hitsetkey;
+    }
+  }
 }  // namespace
 
+void ActsSurfaceMaps::buildSurfaceIndex()
+{
+  m_indexed = false;
+  m_indexedSurfaces.clear();
+  m_hitsetIndex.clear();
+  m_tpcSurfaceIndex.clear();
+  m_volumeFlags.clear();
+
+  // slot of a surface, added on first use
+  std::map<TrkrDefs::hitsetkey, uint16_t> slots;
+  auto get_slot = [&](TrkrDefs::hitsetkey key, const Surface& surface)
+  {
+    auto [iter, inserted] = slots.try_emplace(key, 0);
+    if (inserted)
+    {
+      m_indexedSurfaces.push_back(surface);
+      iter->second = m_indexedSurfaces.size();
+    }
+    return iter->second;
+  };
+
+  // table of the lower hitsetkey bits for the upper bits of hitsetkey
+  auto get_table = [this](TrkrDefs::hitsetkey hitsetkey) -> std::vector<uint16_t>&
+  {
+    const auto upper = hitsetkey >> kBitShiftUpper;
+    if (upper >= m_hitsetIndex.size())
+    {
+      m_hitsetIndex.resize(upper + 1);
+    }
+    auto& table = m_hitsetIndex[upper];
+    if (table.empty())
+    {
+      table.resize(kLowerMask + 1, 0);
+    }
+    return table;
+  };
+
+  // silicon: every strobe or crossing maps to the same surface, fill all of them
+  std::set<TrkrDefs::hitsetkey> silicon_upper;
+  for (const auto& [hitsetkey, surface] : m_siliconSurfaceMap)
+  {
+    silicon_upper.insert(hitsetkey >> kBitShiftUpper);
+  }
+  for (const auto& upper : silicon_upper)
+  {
+    auto& table = get_table(upper << kBitShiftUpper);
+    for (TrkrDefs::hitsetkey lower = 0; lower <= kLowerMask; ++lower)
+    {
+      const auto key = reset_silicon_key((upper << kBitShiftUpper) | lower);
+      const auto iter = m_siliconSurfaceMap.find(key);
+      if (iter != m_siliconSurfaceMap.end())
+      {
+        table[lower] = get_slot(key, iter->second);
+      }
+    }
+  }
+
+  // micromegas
+  for (const auto& [hitsetkey, surface] : m_mmSurfaceMap)
+  {
+    get_table(hitsetkey)[hitsetkey & kLowerMask] = get_slot(hitsetkey, surface);
+  }
+
+  // slots are 16 bits, keep using the maps if there are too many surfaces
+  if (m_indexedSurfaces.size() >= std::numeric_limits<uint16_t>::max())
+  {
+    std::cout << "ActsSurfaceMaps::buildSurfaceIndex - too many surfaces: " << m_indexedSurfaces.size() << ", using the maps" << std::endl;
+    m_indexedSurfaces.clear();
+    m_hitsetIndex.clear();
+    return;
+  }
+
+  // tpc
+  for (const auto& [layer, surfaces] : m_tpcSurfaceMap)
+  {
+    if (layer >= m_tpcSurfaceIndex.size())
+    {
+      m_tpcSurfaceIndex.resize(layer + 1);
+    }
+    m_tpcSurfaceIndex[layer] = surfaces;
+  }
+
+  // volume ids
+  auto add_volumes = [this](const std::set<int>& ids, uint8_t flag)
+  {
+    for (const auto& id : ids)
+    {
+      if (id < 0)
+      {
+        continue;
+      }
+      if (static_cast<size_t>(id) >= m_volumeFlags.size())
+      {
+        m_volumeFlags.resize(id + 1, 0);
+      }
+      m_volumeFlags[id] |= flag;
+    }
+  };
+  add_volumes(m_tpcVolumeIds, kTpcVolume);
+  add_volumes(m_siVolumeIds, kSiVolume);
+  add_volumes(m_micromegasVolumeIds, kMicromegasVolume);
+
+  m_indexed = true;
+}
+
+const Surface* ActsSurfaceMaps::findIndexedSurface(TrkrDefs::hitsetkey hitsetkey) const
+{
+  const auto upper = hitsetkey >> kBitShiftUpper;
+  if (upper >= m_hitsetIndex.size() || m_hitsetIndex[upper].empty())
+  {
+    return nullptr;
+  }
+  const auto slot = m_hitsetIndex[upper][hitsetkey & kLowerMask];
+  return slot ? &m_indexedSurfaces[slot - 1] : nullptr;
+}
+
+bool ActsSurfaceMaps::hasVolumeFlag(const Acts::Surface* surface, uint8_t flag) const
+{
+  const auto volume = surface->geometryId().volume();
+  return volume < m_volumeFlags.size() && (m_volumeFlags[volume] & flag);
+}
+
 bool ActsSurfaceMaps::isTpcSurface(const Acts::Surface* surface) const
 {
+  if (m_indexed)
+  {
+    return hasVolumeFlag(surface, kTpcVolume);
+  }
   return m_tpcVolumeIds.find(surface->geometryId().volume()) != m_tpcVolumeIds.end();
 }
 
 bool ActsSurfaceMaps::isSiSurface(const Acts::Surface* surface) const
 {
+  if (m_indexed)
+  {
+    return hasVolumeFlag(surface, kSiVolume);
+  }
   return m_siVolumeIds.find(surface->geometryId().volume()) != m_siVolumeIds.end();
 }
 
 bool ActsSurfaceMaps::isMicromegasSurface(const Acts::Surface* surface) const
 {
+  if (m_indexed)
+  {
+    return hasVolumeFlag(surface, kMicromegasVolume);
+  }
   return m_micromegasVolumeIds.find(surface->geometryId().volume()) != m_micromegasVolumeIds.end();
 }
 
@@ -77,6 +237,15 @@ Surface ActsSurfaceMaps::getSurface(TrkrDefs::cluskey key,
 
 Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
+  if (m_indexed && TrkrDefs::getTrkrId(hitsetkey) <= TrkrDefs::inttId)
+  {
+    if (const auto* surface = findIndexedSurface(hitsetkey))
+    {
+      return *surface;
+    }
+  }
+
+  // not indexed or not found, the map lookup prints the error
   unsigned int trkrid = TrkrDefs::getTrkrId(hitsetkey);
   TrkrDefs::hitsetkey tmpkey = hitsetkey;
 
@@ -111,21 +280,29 @@ Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
                                        TrkrDefs::subsurfkey surfkey) const
 {
-  unsigned int layer = TrkrDefs::getLayer(hitsetkey);
-  const auto iter = m_tpcSurfaceMap.find(layer);
-   
-  if (iter != m_tpcSurfaceMap.end())
-  {
-    auto surfvec = iter->second;
-    return surfvec.at(surfkey);
-  }
+  const auto* surfaces = getTpcSurfaceVector(TrkrDefs::getLayer(hitsetkey));
 
   /// If it can't be found, return nullptr to skip this cluster
-  return nullptr;
+  return surfaces ? surfaces->at(surfkey) : nullptr;
 }
 
 Surface ActsSurfaceMaps::getMMSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
+  if (m_indexed)
+  {
+    const auto* surface = (TrkrDefs::getTrkrId(hitsetkey) == TrkrDefs::micromegasId) ? findIndexedSurface(hitsetkey) : nullptr;
+    return surface ? *surface : nullptr;
+  }
   const auto iter = m_mmSurfaceMap.find(hitsetkey);
   return (iter == m_mmSurfaceMap.end()) ? nullptr : iter->second;
 }
+
+const SurfaceVec* ActsSurfaceMaps::getTpcSurfaceVector(unsigned int layer) const
+{
+  if (m_indexed)
+  {
+    return (layer < m_tpcSurfaceIndex.size() && !m_tpcSurfaceIndex[layer].empty()) ? &m_tpcSurfaceIndex[layer] : nullptr;
+  }
+  const auto iter = m_tpcSurfaceMap.find(layer);
+  return (iter == m_tpcSurfaceMap.end()) ? nullptr : &iter->second;
+}
@@ -21,6 +21,7 @@ namespace Acts
 class TGeoNode;
 class TrkrCluster;
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <set>
@@ -34,6 +35,10 @@ struct ActsSurfaceMaps
  public:
   ActsSurfaceMaps() = default;
 
+  //! build the dense lookup tables used by the methods below from the maps and volume id sets.
+  /** must be called again if the maps are modified. Without it the maps are used directly */
+  void buildSurfaceIndex();
+
   //! true if given surface corresponds to TPC
   bool isTpcSurface(const Acts::Surface* surface) const;
 
@@ -52,6 +57,9 @@ struct ActsSurfaceMaps
 
   Surface getMMSurface(TrkrDefs::hitsetkey hitsetkey) const;
 
+  //! all TPC surfaces of a layer, nullptr if the layer is not found
+  const SurfaceVec* getTpcSurfaceVector(unsigned int layer) const;
+
   //! map hitset to Surface for the silicon detectors (MVTX and INTT)
   std::map<TrkrDefs::hitsetkey, Surface> m_siliconSurfaceMap;
 
@@ -75,6 +83,31 @@ struct ActsSurfaceMaps
   //! stores all acts volume ids relevant to the micromegas
   /** it is used to quickly tell if a given Acts Surface belongs to micromegas */
   std::set<int> m_micromegasVolumeIds;
+
+ private:
+  //! silicon or micromegas surface from the dense tables, nullptr if not found
+  const Surface* findIndexedSurface(TrkrDefs::hitsetkey hitsetkey) const;
+
+  //! true if the volume id has the given flag in the dense tables
+  bool hasVolumeFlag(const Acts::Surface* surface, uint8_t flag) const;
+
+  //!@name dense lookup tables, see buildSurfaceIndex
+  //@{
+  bool m_indexed = false;
+
+  //! silicon and micromegas surfaces referenced by m_hitsetIndex
+  SurfaceVec m_indexedSurfaces;
+
+  //! indexed by the upper 16 hitsetkey bits (tracker id and layer), then by the lower 16 bits.
+  /** values are the position in m_indexedSurfaces plus one, 0 if there is no surface */
+  std::vector<std::vector<uint16_t>> m_hitsetIndex;
+
+  //! TPC surfaces indexed by layer
+  std::vector<SurfaceVec> m_tpcSurfaceIndex;
+
+  //! TPC, silicon and micromegas flags indexed by acts volume id
+  std::vector<uint8_t> m_volumeFlags;
+  //@}
 };
 
 #endif
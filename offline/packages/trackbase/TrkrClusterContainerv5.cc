@@ -0,0 +1,267 @@
+/**
+ * @file trackbase/TrkrClusterContainerv5.cc
+ * @brief Implementation of TrkrClusterContainerv5
+ */
+#include "TrkrClusterContainerv5.h"
+#include "TrkrCluster.h"
+#include "TrkrDefs.h"
+
+#include <algorithm>
+#include <typeinfo>
+
+namespace
+{
+  TrkrClusterContainer::Map dummy_map;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Reset()
+{
+  // move the cluster vectors to the spare list, keeping their capacity
+  for (auto& clusters : m_clusters)
+  {
+    clusters.clear();
+    m_spare_clusters.push_back(std::move(clusters));
+  }
+  for (auto& valid : m_valid)
+  {
+    valid.clear();
+    m_spare_valid.push_back(std::move(valid));
+  }
+  m_clusters.clear();
+  m_valid.clear();
+  m_hitsetkeys.clear();
+
+  // also clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::identify(std::ostream& os) const
+{
+  os << "-----TrkrClusterContainerv5-----" << std::endl;
+  os << "Number of clusters: " << size() << std::endl;
+
+  for (size_t i = 0; i < m_hitsetkeys.size(); ++i)
+  {
+    const TrkrDefs::hitsetkey hitsetkey = m_hitsetkeys[i];
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    os << "layer: " << layer << " hitsetkey: " << hitsetkey << std::endl;
+
+    for (size_t index = 0; index < m_clusters[i].size(); ++index)
+    {
+      if (m_valid[i][index])
+      {
+        m_clusters[i][index].identify(os);
+      }
+    }
+  }
+
+  os << "------------------------------" << std::endl;
+}
+
+//_________________________________________________________________
+int TrkrClusterContainerv5::find_hitset(TrkrDefs::hitsetkey hitsetkey) const
+{
+  const auto iter = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), hitsetkey);
+  if (iter == m_hitsetkeys.end() || *iter != hitsetkey)
+  {
+    return -1;
+  }
+  return std::distance(m_hitsetkeys.begin(), iter);
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::removeCluster(TrkrDefs::cluskey key)
+{
+  const int ihitset = find_hitset(TrkrDefs::getHitSetKeyFromClusKey(key));
+  if (ihitset < 0)
+  {
+    return;
+  }
+
+  // the cluster stays in place to keep the other indices, it is only flagged
+  const auto index = TrkrDefs::getClusIndex(key);
+  if (index < m_valid[ihitset].size())
+  {
+    m_valid[ihitset][index] = 0;
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::removeClusters(TrkrDefs::hitsetkey hitsetkey)
+{
+  const int ihitset = find_hitset(hitsetkey);
+  if (ihitset < 0)
+  {
+    return;
+  }
+
+  m_clusters[ihitset].clear();
+  m_valid[ihitset].clear();
+  m_spare_clusters.push_back(std::move(m_clusters[ihitset]));
+  m_spare_valid.push_back(std::move(m_valid[ihitset]));
+
+  m_hitsetkeys.erase(m_hitsetkeys.begin() + ihitset);
+  m_clusters.erase(m_clusters.begin() + ihitset);
+  m_valid.erase(m_valid.begin() + ihitset);
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::addClusterSpecifyKey(const TrkrDefs::cluskey key, TrkrCluster* newclus)
+{
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  // find relevant hitset or insert it at its sorted position
+  const auto iter = std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), hitsetkey);
+  const auto ihitset = std::distance(m_hitsetkeys.begin(), iter);
+  if (iter == m_hitsetkeys.end() || *iter != hitsetkey)
+  {
+    m_hitsetkeys.insert(iter, hitsetkey);
+    if (m_spare_clusters.empty())
+    {
+      m_clusters.emplace(m_clusters.begin() + ihitset);
+      m_valid.emplace(m_valid.begin() + ihitset);
+    }
+    else
+    {
+      m_clusters.insert(m_clusters.begin() + ihitset, std::move(m_spare_clusters.back()));
+      m_valid.insert(m_valid.begin() + ihitset, std::move(m_spare_valid.back()));
+      m_spare_clusters.pop_back();
+      m_spare_valid.pop_back();
+    }
+  }
+
+  auto& clus_vector = m_clusters[ihitset];
+  auto& valid_vector = m_valid[ihitset];
+
+  const auto index = TrkrDefs::getClusIndex(key);
+  if (index < valid_vector.size() && valid_vector[index])
+  {
+    std::cout << "TrkrClusterContainerv5::AddClusterSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  if (index >= clus_vector.size())
+  {
+    clus_vector.resize(index + 1);
+    valid_vector.resize(index + 1, 0);
+  }
+
+  if (typeid(*newclus) == typeid(TrkrClusterv5))
+  {
+    clus_vector[index] = *static_cast<TrkrClusterv5*>(newclus);
+  }
+  else
+  {
+    static bool first = true;
+    if (first)
+    {
+      std::cout << "TrkrClusterContainerv5::AddClusterSpecifyKey: converting " << newclus->ClassName()
+                << " to TrkrClusterv5, information not in TrkrClusterv5 is lost" << std::endl;
+      first = false;
+    }
+    clus_vector[index] = TrkrClusterv5();
+    clus_vector[index].CopyFrom(*newclus);
+  }
+  valid_vector[index] = 1;
+
+  // the container owns the clusters
+  delete newclus;
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters() const
+{
+  std::cout << "deprecated function in TrkrClusterContainerv5, user getClusters(TrkrDefs:hitsetkey)"
+            << std::endl;
+  return std::make_pair(dummy_map.begin(), dummy_map.begin());
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters(TrkrDefs::hitsetkey hitsetkey)
+{
+  // clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+
+  const int ihitset = find_hitset(hitsetkey);
+  if (ihitset >= 0)
+  {
+    auto& clusters = m_clusters[ihitset];
+    const auto& valid = m_valid[ihitset];
+    for (size_t index = 0; index < clusters.size(); ++index)
+    {
+      if (valid[index])
+      {
+        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+        m_tmpmap.insert(m_tmpmap.end(), std::make_pair(ckey, &clusters[index]));
+      }
+    }
+  }
+
+  return std::make_pair(m_tmpmap.cbegin(), m_tmpmap.cend());
+}
+
+//_________________________________________________________________
+TrkrCluster* TrkrClusterContainerv5::findCluster(TrkrDefs::cluskey key) const
+{
+  const int ihitset = find_hitset(TrkrDefs::getHitSetKeyFromClusKey(key));
+  if (ihitset < 0)
+  {
+    return nullptr;
+  }
+
+  const auto index = TrkrDefs::getClusIndex(key);
+  if (index >= m_valid[ihitset].size() || !m_valid[ihitset][index])
+  {
+    return nullptr;
+  }
+
+  // the interface hands out non-const clusters, like the pointer based containers
+  return const_cast<TrkrClusterv5*>(&m_clusters[ihitset][index]);
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys() const
+{
+  return m_hitsetkeys;
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid) const
+{
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid);
+  return HitSetKeyList(
+      std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), keylo),
+      std::upper_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), keyhi));
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid, const uint8_t layer) const
+{
+  const TrkrDefs::hitsetkey keylo = TrkrDefs::getHitSetKeyLo(trackerid, layer);
+  const TrkrDefs::hitsetkey keyhi = TrkrDefs::getHitSetKeyHi(trackerid, layer);
+  return HitSetKeyList(
+      std::lower_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), keylo),
+      std::upper_bound(m_hitsetkeys.begin(), m_hitsetkeys.end(), keyhi));
+}
+
+//_________________________________________________________________
+unsigned int TrkrClusterContainerv5::size() const
+{
+  unsigned int size = 0;
+  for (const auto& valid : m_valid)
+  {
+    size += std::count(valid.begin(), valid.end(), 1);
+  }
+  return size;
+}
@@ -0,0 +1,87 @@
+#ifndef TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+#define TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+
+/**
+ * @file trackbase/TrkrClusterContainerv5.h
+ * @brief Cluster container with clusters stored by value
+ */
+
+#include "TrkrClusterContainer.h"
+#include "TrkrClusterv5.h"
+
+#include <phool/PHObject.h>
+
+#include <cstdint>
+#include <vector>
+
+class TrkrCluster;
+
+/**
+ * @brief Cluster container with clusters stored by value
+ *
+ * Clusters are kept as TrkrClusterv5 in one contiguous array per hitset,
+ * hitsets are located by binary search in a sorted key list.
+ * There is no heap allocation per cluster and the per-hitset arrays are
+ * recycled by Reset(), so after the first events no allocation happens at all.
+ *
+ * addClusterSpecifyKey() copies the cluster and deletes the argument,
+ * the caller must not use the pointer afterwards. Clusters which are not
+ * TrkrClusterv5 are converted with TrkrClusterv5::CopyFrom.
+ * Pointers returned by findCluster() are valid until the next cluster
+ * is added to the same hitset, or the hitset is removed.
+ */
+class TrkrClusterContainerv5 : public TrkrClusterContainer
+{
+ public:
+  TrkrClusterContainerv5() = default;
+
+  void Reset() override;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) override;
+
+  //! remove cluster matching a given cluster key
+  void removeCluster(TrkrDefs::cluskey) override;
+
+  //! remove all the clusters matching a given key
+  void removeClusters(TrkrDefs::hitsetkey) override;
+
+  ConstRange getClusters() const override;  // deprecated
+
+  ConstRange getClusters(TrkrDefs::hitsetkey) override;
+
+  TrkrCluster* findCluster(TrkrDefs::cluskey) const override;
+
+  HitSetKeyList getHitSetKeys() const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId) const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId, const uint8_t /* layer */) const override;
+
+  unsigned int size() const override;
+
+ private:
+  //! position of hitsetkey in m_hitsetkeys, or -1
+  int find_hitset(TrkrDefs::hitsetkey) const;
+
+  //! sorted hitset keys
+  std::vector<TrkrDefs::hitsetkey> m_hitsetkeys;
+
+  //! clusters, one vector per hitset, same order as m_hitsetkeys. Cluster index is the position in the vector
+  std::vector<std::vector<TrkrClusterv5>> m_clusters;
+
+  //! 1 if the corresponding cluster is filled
+  std::vector<std::vector<uint8_t>> m_valid;
+
+  //! emptied cluster vectors kept for reuse
+  std::vector<std::vector<TrkrClusterv5>> m_spare_clusters;  //! transient
+  std::vector<std::vector<uint8_t>> m_spare_valid;           //! transient
+
+  //! temporary map for getClusters
+  Map m_tmpmap;  //! transient
+
+  ClassDefOverride(TrkrClusterContainerv5, 1)
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERCONTAINERV5_H
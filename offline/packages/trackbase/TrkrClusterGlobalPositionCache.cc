@@ -0,0 +1,152 @@
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.cc
+ * @brief per event cache of corrected cluster global positions, shared by the tracking modules
+ */
+
+#include "TrkrClusterGlobalPositionCache.h"
+#include "TrkrCluster.h"
+
+#include <mutex>
+
+namespace
+{
+  //! spin lock on an entry, the critical sections only copy a few words
+  class EntryLock
+  {
+   public:
+    explicit EntryLock(std::atomic_flag& flag)
+      : m_flag(flag)
+    {
+      while (m_flag.test_and_set(std::memory_order_acquire))
+      {
+      }
+    }
+    ~EntryLock() { m_flag.clear(std::memory_order_release); }
+
+    EntryLock(const EntryLock&) = delete;
+    EntryLock& operator=(const EntryLock&) = delete;
+
+   private:
+    std::atomic_flag& m_flag;
+  };
+}  // namespace
+
+//_________________________________________________________
+TrkrClusterGlobalPositionCache::HitSetTable::~HitSetTable()
+{
+  for (auto& chunk : chunks)
+  {
+    delete chunk.load();
+  }
+}
+
+//_________________________________________________________
+void TrkrClusterGlobalPositionCache::identify(std::ostream& os) const
+{
+  os << "TrkrClusterGlobalPositionCache - event: " << m_generation << " hitsets: " << m_tables.size() << std::endl;
+}
+
+//_________________________________________________________
+TrkrClusterGlobalPositionCache::Entry* TrkrClusterGlobalPositionCache::get_entry(TrkrDefs::cluskey key)
+{
+  const auto index = TrkrDefs::getClusIndex(key);
+  const auto ichunk = index / kChunkSize;
+  if (ichunk >= kMaxChunks)
+  {
+    return nullptr;
+  }
+
+  // hitset table
+  const auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+  HitSetTable* table = nullptr;
+  {
+    std::shared_lock lock(m_mutex);
+    const auto iter = m_tables.find(hitsetkey);
+    if (iter != m_tables.end())
+    {
+      table = iter->second.get();
+    }
+  }
+
+  if (!table)
+  {
+    std::unique_lock lock(m_mutex);
+    auto& new_table = m_tables[hitsetkey];
+    if (!new_table)
+    {
+      new_table = std::make_unique<HitSetTable>();
+    }
+    table = new_table.get();
+  }
+
+  // chunk, the thread losing the race deletes its own
+  auto& slot = table->chunks[ichunk];
+  auto* chunk = slot.load(std::memory_order_acquire);
+  if (!chunk)
+  {
+    auto* new_chunk = new Chunk;
+    if (slot.compare_exchange_strong(chunk, new_chunk, std::memory_order_acq_rel))
+    {
+      chunk = new_chunk;
+    }
+    else
+    {
+      delete new_chunk;
+    }
+  }
+
+  return &chunk->entries[index % kChunkSize];
+}
+
+//_________________________________________________________
+bool TrkrClusterGlobalPositionCache::find(TrkrDefs::cluskey key, const TrkrCluster* cluster, short int crossing, uint8_t flags, Acts::Vector3& position)
+{
+  auto* entry = get_entry(key);
+  if (!entry)
+  {
+    return false;
+  }
+
+  const float localX = cluster->getLocalX();
+  const float localY = cluster->getLocalY();
+  const auto subsurfkey = cluster->getSubSurfKey();
+
+  EntryLock lock(entry->lock);
+  if (entry->generation != m_generation ||
+      entry->cluster != cluster ||
+      entry->localX != localX ||
+      entry->localY != localY ||
+      entry->subsurfkey != subsurfkey ||
+      entry->crossing != crossing ||
+      entry->flags != flags)
+  {
+    return false;
+  }
+
+  position = entry->position;
+  return true;
+}
+
+//_________________________________________________________
+void TrkrClusterGlobalPositionCache::store(TrkrDefs::cluskey key, const TrkrCluster* cluster, short int crossing, uint8_t flags, const Acts::Vector3& position)
+{
+  auto* entry = get_entry(key);
+  if (!entry)
+  {
+    return;
+  }
+
+  const float localX = cluster->getLocalX();
+  const float localY = cluster->getLocalY();
+  const auto subsurfkey = cluster->getSubSurfKey();
+
+  EntryLock lock(entry->lock);
+  entry->generation = m_generation;
+  entry->cluster = cluster;
+  entry->localX = localX;
+  entry->localY = localY;
+  entry->subsurfkey = subsurfkey;
+  entry->crossing = crossing;
+  entry->flags = flags;
+  entry->position = position;
+}
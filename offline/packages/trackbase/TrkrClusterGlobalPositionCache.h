@@ -0,0 +1,100 @@
+#ifndef TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+#define TRACKBASE_TRKRCLUSTERGLOBALPOSITIONCACHE_H
+
+/**
+ * @file trackbase/TrkrClusterGlobalPositionCache.h
+ * @brief per event cache of corrected cluster global positions, shared by the tracking modules
+ */
+
+#include "TrkrDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <Acts/Definitions/Algebra.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
+
+class TrkrCluster;
+
+/**
+ * @brief per event cache of corrected cluster global positions
+ *
+ * Transient object, stored in a PHDataNode under DST so that Reset is called at the end of each event.
+ * Positions are stored per hitset in chunks indexed by the cluster index. An entry is only returned
+ * if the cluster pointer, local coordinates, sub-surface, crossing and correction flags match the
+ * ones it was stored with, so that clusters modified during the event are recomputed.
+ *
+ * find and store can be called concurrently.
+ */
+class TrkrClusterGlobalPositionCache : public PHObject
+{
+ public:
+  TrkrClusterGlobalPositionCache() = default;
+  ~TrkrClusterGlobalPositionCache() override = default;
+
+  TrkrClusterGlobalPositionCache(const TrkrClusterGlobalPositionCache&) = delete;
+  TrkrClusterGlobalPositionCache& operator=(const TrkrClusterGlobalPositionCache&) = delete;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  //! invalidate all entries. Memory is kept for the next event
+  void Reset() override { ++m_generation; }
+
+  int isValid() const override { return 1; }
+
+  //! cached global position, false if missing or outdated
+  bool find(TrkrDefs::cluskey, const TrkrCluster*, short int crossing, uint8_t flags, Acts::Vector3& /*position*/);
+
+  //! store global position
+  void store(TrkrDefs::cluskey, const TrkrCluster*, short int crossing, uint8_t flags, const Acts::Vector3& /*position*/);
+
+ private:
+  struct Entry
+  {
+    //! protects the fields below
+    std::atomic_flag lock;
+
+    //! event the entry was stored in, 0 if never
+    uint32_t generation = 0;
+
+    const TrkrCluster* cluster = nullptr;
+    float localX = 0;
+    float localY = 0;
+    TrkrDefs::subsurfkey subsurfkey = 0;
+    short int crossing = 0;
+    uint8_t flags = 0;
+    Acts::Vector3 position;
+  };
+
+  //! entries per chunk and maximum number of chunks per hitset. Clusters with larger index are not cached
+  static constexpr unsigned int kChunkSize = 1024;
+  static constexpr unsigned int kMaxChunks = 256;
+
+  struct Chunk
+  {
+    std::array<Entry, kChunkSize> entries;
+  };
+
+  struct HitSetTable
+  {
+    ~HitSetTable();
+    std::array<std::atomic<Chunk*>, kMaxChunks> chunks{};
+  };
+
+  //! entry for a cluster key, created if needed, nullptr if the index is too large
+  Entry* get_entry(TrkrDefs::cluskey);
+
+  //! protects the hitset table map. The tables are never removed
+  std::shared_mutex m_mutex;
+  std::unordered_map<TrkrDefs::hitsetkey, std::unique_ptr<HitSetTable>> m_tables;
+
+  //! current event
+  uint32_t m_generation = 1;
+};
+
+#endif
@@ -5,6 +5,7 @@
  * @brief Implementation of TrkrHitSet
  */
 #include "TrkrHitSet.h"
+#include "TrkrHitv2.h"
 
 namespace
 {
@@ -17,6 +18,14 @@ TrkrHitSet::addHitSpecificKey(const TrkrDefs::hitkey /*unused*/, TrkrHit* /*unus
   return dummy_map.cbegin();
 }
 
+TrkrHit*
+TrkrHitSet::addHit(const TrkrDefs::hitkey key)
+{
+  TrkrHit* hit = new TrkrHitv2;
+  addHitSpecificKey(key, hit);
+  return hit;
+}
+
 TrkrHitSet::ConstRange
 TrkrHitSet::getHits() const
 {
@@ -70,6 +70,16 @@ class TrkrHitSet : public PHObject
    */
   virtual ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*);
 
+  /**
+   * @brief Create a hit and add it to this container
+   * @param[in] key Hit key
+   * @param[out] Pointer to the new hit, owned by this TrkrHitSet
+   *
+   * The default creates a TrkrHitv2 on the heap. Implementations may
+   * recycle the hits of previous events instead.
+   */
+  virtual TrkrHit* addHit(const TrkrDefs::hitkey);
+
   /**
    * @brief Remove a hit using its key
    * @param[in] key to be removed
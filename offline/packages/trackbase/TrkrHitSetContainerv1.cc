@@ -8,17 +8,88 @@
 
 #include "TrkrDefs.h"
 #include "TrkrHitSetv1.h"
+#include "TrkrHitSetv2.h"
+
+#include <phool/PHEventPool.h>
 
 #include <cstdlib>
 
+namespace
+{
+  //! reports the hits recycled by the arenas of the pooled hitsets
+  class HitArenaCounter : public PHEventPoolBase
+  {
+   public:
+    using PHEventPoolBase::PHEventPoolBase;
+
+    //! the hits are recycled by their hitset, only the capacity of the event is kept
+    void rewind() override
+    {
+      m_capacity = m_pending;
+      m_pending = 0;
+    }
+
+    //! arena hits of the hitsets recycled in the last event
+    std::size_t capacity() const override { return m_capacity; }
+
+    void count(const TrkrHitSetv2* hitset)
+    {
+      m_created += hitset->arenaCreated();
+      m_reused += hitset->arenaUsed() - hitset->arenaCreated();
+      m_pending += hitset->arenaSize();
+    }
+
+   private:
+    std::size_t m_capacity{0};
+    std::size_t m_pending{0};
+  };
+}  // namespace
+
+TrkrHitSetContainerv1::~TrkrHitSetContainerv1()
+{
+  TrkrHitSetContainerv1::Reset();
+  delete m_pool;
+  delete m_hit_counter;
+}
+
 void TrkrHitSetContainerv1::Reset()
 {
   for (auto&& [key, hitset] : m_hitmap)
   {
-    delete hitset;
+    // pooled hitsets are only emptied, hitsets read from file or added by the user are deleted
+    if (m_pool && m_pool->owns(hitset))
+    {
+      recycle(hitset);
+    }
+    else
+    {
+      delete hitset;
+    }
   }
 
   m_hitmap.clear();
+
+  if (m_pool)
+  {
+    m_pool->rewind();
+    m_hit_counter->rewind();
+  }
+}
+
+void TrkrHitSetContainerv1::recycle(TrkrHitSet* hitset)
+{
+  // the pool only holds TrkrHitSetv2
+  static_cast<HitArenaCounter*>(m_hit_counter)->count(static_cast<const TrkrHitSetv2*>(hitset));
+  hitset->Reset();
+}
+
+void TrkrHitSetContainerv1::UseEventPool(const std::string& name)
+{
+  if (!m_pool)
+  {
+    m_pool = new PHEventPool<TrkrHitSetv2>(name);
+    m_hit_counter = new HitArenaCounter(name + "_hits");
+  }
 }
 
 void TrkrHitSetContainerv1::identify(std::ostream& os) const
@@ -61,7 +132,15 @@ void TrkrHitSetContainerv1::removeHitSet(TrkrDefs::hitsetkey key)
   if (iter != m_hitmap.end())
   {
     TrkrHitSet* hitset = iter->second;
-    delete hitset;
+    if (m_pool && m_pool->owns(hitset))
+    {
+      // stays in the pool until the next Reset()
+      recycle(hitset);
+    }
+    else
+    {
+      delete hitset;
+    }
     m_hitmap.erase(iter);
   }
 }
@@ -99,7 +178,8 @@ TrkrHitSetContainerv1::findOrAddHitSet(TrkrDefs::hitsetkey key)
   auto it = m_hitmap.lower_bound(key);
   if (it == m_hitmap.end() || (key < it->first))
   {
-    it = m_hitmap.insert(it, std::make_pair(key, new TrkrHitSetv1));
+    TrkrHitSet* hitset = m_pool ? static_cast<TrkrHitSet*>(m_pool->get()) : new TrkrHitSetv1;
+    it = m_hitmap.insert(it, std::make_pair(key, hitset));
     it->second->setHitSetKey(key);
   }
   return it;
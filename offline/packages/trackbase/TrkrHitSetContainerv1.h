@@ -8,12 +8,18 @@
 
 #include "TrkrDefs.h"
 #include "TrkrHitSetContainer.h"
+#include "TrkrHitSetv1.h"
 
 #include <iostream>  // for cout, ostream
 #include <map>
 #include <utility>  // for pair
 
+class PHEventPoolBase;
 class TrkrHitSet;
+class TrkrHitSetv2;
+
+template <class T>
+class PHEventPool;
 
 /**
  * Container for TrkrHitSet objects
@@ -23,13 +29,18 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
  public:
   TrkrHitSetContainerv1() = default;
 
-  ~TrkrHitSetContainerv1() override
-  {
-    TrkrHitSetContainerv1::Reset();
-  }
+  ~TrkrHitSetContainerv1() override;
 
   void Reset() override;
 
+  //! take the hitsets created by findOrAddHitSet from a pool which is recycled by Reset()
+  /*!
+   * The pooled hitsets are TrkrHitSetv2, which also recycle the hits created with TrkrHitSet::addHit.
+   * The counters are reported by Fun4AllMemoryTracker under the given name, and under name + "_hits"
+   * for the hits. A pooled container must be filled from a single thread.
+   */
+  void UseEventPool(const std::string& name = "TrkrHitSetv2");
+
   void identify(std::ostream& = std::cout) const override;
 
   ConstIterator addHitSet(TrkrHitSet*) override;
@@ -58,6 +69,15 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
  private:
   Map m_hitmap;
 
+  //! hand a pooled hitset back, count its recycled hits
+  void recycle(TrkrHitSet*);
+
+  //! pool of hitsets, null if not used
+  PHEventPool<TrkrHitSetv2>* m_pool = nullptr;  //! transient
+
+  //! counters of the hits recycled by the pooled hitsets
+  PHEventPoolBase* m_hit_counter = nullptr;  //! transient
+
   ClassDefOverride(TrkrHitSetContainerv1, 1)
 };
 
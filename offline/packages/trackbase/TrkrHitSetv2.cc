@@ -0,0 +1,260 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+#include "TrkrHit.h"
+
+#include <algorithm>
+#include <cstdlib>  // for exit
+#include <iostream>
+#include <utility>
+
+namespace
+{
+  //! minimum number of unsorted hits which are searched linearly before the tail gets merged
+  constexpr size_t min_unsorted = 32;
+
+  using HitPair = std::pair<TrkrDefs::hitkey, TrkrHit*>;
+  bool less_key(const HitPair& lhs, const HitPair& rhs) { return lhs.first < rhs.first; }
+}  // namespace
+
+void TrkrHitSetv2::delete_hits()
+{
+  // arena hits are recycled, the others were allocated by the caller or read from file
+  if (m_arena_hits != m_hits.size())
+  {
+    for (auto& hit : m_hits)
+    {
+      if (hit->IsOnHeap())
+      {
+        delete hit;
+      }
+    }
+  }
+
+  // clear keeps the capacity for the next event
+  m_keys.clear();
+  m_hits.clear();
+  m_nsorted = 0;
+  m_arena_used = 0;
+  m_arena_created = 0;
+  m_arena_hits = 0;
+
+  m_hitmap.clear();
+  m_hitmap_valid = false;
+  m_lastadded.clear();
+}
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+  delete_hits();
+}
+
+void TrkrHitSetv2::Clear(Option_t* /*option*/)
+{
+  delete_hits();
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << m_keys.size()
+      << std::endl;
+
+  const auto range = getHits();
+  for (auto iter = range.first; iter != range.second; ++iter)
+  {
+    std::cout << " hitkey " << iter->first << std::endl;
+    iter->second->identify(os);
+  }
+}
+
+void TrkrHitSetv2::merge()
+{
+  if (m_nsorted == m_keys.size())
+  {
+    return;
+  }
+
+  // scratch buffer, reused between calls
+  static thread_local std::vector<HitPair> hits;
+  hits.clear();
+  for (size_t i = 0; i < m_keys.size(); ++i)
+  {
+    hits.emplace_back(m_keys[i], m_hits[i]);
+  }
+
+  const auto middle = hits.begin() + m_nsorted;
+  std::sort(middle, hits.end(), less_key);
+  std::inplace_merge(hits.begin(), middle, hits.end(), less_key);
+
+  for (size_t i = 0; i < hits.size(); ++i)
+  {
+    m_keys[i] = hits[i].first;
+    m_hits[i] = hits[i].second;
+  }
+  m_nsorted = m_keys.size();
+}
+
+size_t TrkrHitSetv2::find(const TrkrDefs::hitkey key) const
+{
+  // sorted part
+  const auto end = m_keys.begin() + m_nsorted;
+  const auto it = std::lower_bound(m_keys.begin(), end, key);
+  if (it != end && *it == key)
+  {
+    return std::distance(m_keys.begin(), it);
+  }
+
+  // unsorted tail, kept short by append
+  for (size_t i = m_nsorted; i < m_keys.size(); ++i)
+  {
+    if (m_keys[i] == key)
+    {
+      return i;
+    }
+  }
+
+  return m_keys.size();
+}
+
+void TrkrHitSetv2::append(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  if (find(key) != m_keys.size())
+  {
+    std::cout << "TrkrHitSetv2::AddHitSpecificKey: duplicate key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+
+  m_keys.push_back(key);
+  m_hits.push_back(hit);
+  if (m_nsorted + 1 == m_keys.size() && (m_nsorted == 0 || m_keys[m_nsorted - 1] < key))
+  {
+    // hits added in increasing key order stay sorted
+    ++m_nsorted;
+  }
+  else
+  {
+    // the tail may grow like sqrt(n), so that the merges cost O(sqrt(n)) per hit
+    // when lookups and insertions alternate, as in the digitizers
+    const size_t nunsorted = m_keys.size() - m_nsorted;
+    if (nunsorted > min_unsorted && nunsorted * nunsorted > m_nsorted)
+    {
+      merge();
+    }
+  }
+  m_hitmap_valid = false;
+
+  // single entry map, its node is reused
+  if (m_lastadded.empty())
+  {
+    m_lastadded.emplace(key, hit);
+  }
+  else
+  {
+    auto node = m_lastadded.extract(m_lastadded.begin());
+    node.key() = key;
+    node.mapped() = hit;
+    m_lastadded.insert(std::move(node));
+  }
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  merge();
+  const auto it = std::lower_bound(m_keys.begin(), m_keys.end(), key);
+  if (it != m_keys.end() && *it == key)
+  {
+    const auto index = std::distance(m_keys.begin(), it);
+    TrkrHit* hit = m_hits[index];
+    if (hit->IsOnHeap())
+    {
+      delete hit;
+    }
+    else
+    {
+      // stays in the arena until the next Reset or Clear
+      --m_arena_hits;
+    }
+    m_keys.erase(it);
+    m_hits.erase(m_hits.begin() + index);
+    m_nsorted = m_keys.size();
+    m_hitmap_valid = false;
+    m_lastadded.clear();
+  }
+  else
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  append(key, hit);
+  return m_lastadded.cbegin();
+}
+
+TrkrHit*
+TrkrHitSetv2::addHit(const TrkrDefs::hitkey key)
+{
+  TrkrHitv2* hit = nullptr;
+  if (m_arena_used < m_arena.size())
+  {
+    hit = &m_arena[m_arena_used];
+    *hit = TrkrHitv2();
+  }
+  else
+  {
+    hit = &m_arena.emplace_back();
+    ++m_arena_created;
+  }
+  ++m_arena_used;
+
+  append(key, hit);
+  ++m_arena_hits;
+  return hit;
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  const size_t index = find(key);
+  return index < m_keys.size() ? m_hits[index] : nullptr;
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  // concurrent readers share one rebuild of the map
+  if (!m_hitmap_valid.load(std::memory_order_acquire))
+  {
+    std::lock_guard<std::mutex> lock(m_hitmap_mutex);
+    if (!m_hitmap_valid.load(std::memory_order_relaxed))
+    {
+      m_hitmap.clear();
+
+      // sorted part first, insertion at the end is constant time
+      for (size_t i = 0; i < m_nsorted; ++i)
+      {
+        m_hitmap.emplace_hint(m_hitmap.end(), m_keys[i], m_hits[i]);
+      }
+      for (size_t i = m_nsorted; i < m_keys.size(); ++i)
+      {
+        m_hitmap.emplace(m_keys[i], m_hits[i]);
+      }
+      m_hitmap_valid.store(true, std::memory_order_release);
+    }
+  }
+  return std::make_pair(m_hitmap.cbegin(), m_hitmap.cend());
+}
@@ -0,0 +1,154 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Container for storing TrkrHit's in sorted vectors
+ */
+#include "TrkrDefs.h"
+#include "TrkrHitSet.h"
+#include "TrkrHitv2.h"
+
+#include <atomic>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+// forward declaration
+class TrkrHit;
+
+/**
+ * @brief Container for storing TrkrHit's in sorted vectors
+ *
+ * Same interface and ownership rules as TrkrHitSetv1, but the hits are kept
+ * in a key-sorted vector (flat map) instead of a std::map.
+ * New hits are appended to an unsorted tail which addHitSpecificKey() merges
+ * into the sorted part once it is longer than about sqrt(n), so an unpacker
+ * filling hits in any order pays a few merges instead of one tree insertion per hit.
+ *
+ * Hits created with addHit() are taken from an arena owned by the hitset.
+ * Reset() and Clear() recycle the arena and keep the vector capacity, Clear() also keeps
+ * the hitset key so that the object can be reused by TrkrHitSetContainerv2 or by
+ * a pooled TrkrHitSetContainerv1. Hits passed to addHitSpecificKey() are deleted as in TrkrHitSetv1.
+ *
+ * The const accessors do not modify the hits and can be called from several threads.
+ * getHits() returns a range of a transient map which is rebuilt, under a lock,
+ * after the hitset has been modified. As for TrkrHitSetv1, hits must not be added
+ * or removed while other threads read the hitset or while iterating over the hits.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  TrkrHitSetv2() = default;
+
+  ~TrkrHitSetv2() override
+  {
+    TrkrHitSetv2::Reset();
+  }
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void Reset() override;
+
+  //! delete the hits but keep the key and the allocated memory
+  void Clear(Option_t* /*option*/ = "") override;
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  //! the returned iterator refers to the added hit and is valid until the next modification of the hitset
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+
+  //! add a hit from the arena, with adc and energy set to zero
+  TrkrHit* addHit(const TrkrDefs::hitkey) override;
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+
+  ConstRange getHits() const override;
+
+  unsigned int size() const override
+  {
+    return m_keys.size();
+  }
+
+  //! number of hits taken from the arena since the last Reset or Clear
+  size_t arenaUsed() const
+  {
+    return m_arena_used;
+  }
+
+  //! number of hits the arena had to allocate since the last Reset or Clear
+  size_t arenaCreated() const
+  {
+    return m_arena_created;
+  }
+
+  //! number of hits owned by the arena
+  size_t arenaSize() const
+  {
+    return m_arena.size();
+  }
+
+ private:
+  //! append a hit to the unsorted tail, merge the tail if it got too long
+  void append(const TrkrDefs::hitkey, TrkrHit*);
+
+  //! merge the unsorted tail into the sorted part
+  void merge();
+
+  //! position of the hit in the vectors, or size() if not found
+  size_t find(const TrkrDefs::hitkey) const;
+
+  //! delete all hits
+  void delete_hits();
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// hit keys, sorted up to m_nsorted
+  std::vector<TrkrDefs::hitkey> m_keys;
+
+  /// hits, same order as m_keys
+  std::vector<TrkrHit*> m_hits;
+
+  /// number of entries in the sorted part
+  unsigned int m_nsorted = 0;
+
+  /// hits handed out by addHit, a deque does not move them when it grows
+  std::deque<TrkrHitv2> m_arena;  //! transient
+
+  /// number of arena hits handed out since the last Reset or Clear
+  size_t m_arena_used = 0;  //! transient
+
+  /// number of arena hits allocated since the last Reset or Clear
+  size_t m_arena_created = 0;  //! transient
+
+  /// number of arena hits in m_hits, all hits are from the arena if equal to size()
+  size_t m_arena_hits = 0;  //! transient
+
+  /// map view returned by getHits
+  mutable Map m_hitmap;  //! transient
+
+  /// true when m_hitmap is in sync with the vectors
+  mutable std::atomic<bool> m_hitmap_valid = false;  //! transient
+
+  /// protects the rebuild of m_hitmap
+  mutable std::mutex m_hitmap_mutex;  //! transient
+
+  /// last added hit, for the iterator returned by addHitSpecificKey
+  Map m_lastadded;  //! transient
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
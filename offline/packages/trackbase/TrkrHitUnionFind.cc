@@ -0,0 +1,131 @@
+/**
+ * @file trackbase/TrkrHitUnionFind.cc
+ * @brief Implementation of TrkrHitUnionFind
+ */
+#include "TrkrHitUnionFind.h"
+
+#include <algorithm>
+#include <numeric>
+
+std::size_t TrkrHitUnionFind::root(std::size_t i)
+{
+  while (m_parent[i] != i)
+  {
+    m_parent[i] = m_parent[m_parent[i]];
+    i = m_parent[i];
+  }
+  return i;
+}
+
+void TrkrHitUnionFind::unite(std::size_t i, std::size_t j)
+{
+  i = root(i);
+  j = root(j);
+  if (i == j)
+  {
+    return;
+  }
+
+  // the smaller index becomes the root, trees stay shallow since hits are
+  // merged close to sorted order
+  if (j < i)
+  {
+    std::swap(i, j);
+  }
+  m_parent[j] = i;
+}
+
+std::size_t TrkrHitUnionFind::find(const std::vector<Cell> &cells, int max_dcol, int max_drow)
+{
+  const std::size_t nhits = cells.size();
+
+  m_parent.resize(nhits);
+  std::iota(m_parent.begin(), m_parent.end(), 0);
+
+  // sort by column and row. Hits from a TrkrHitSet come in key order,
+  // which is already column major, so this is mostly a check
+  m_sorted.resize(nhits);
+  std::iota(m_sorted.begin(), m_sorted.end(), 0);
+  const auto less = [&cells](std::size_t lhs, std::size_t rhs)
+  {
+    return cells[lhs].col < cells[rhs].col || (cells[lhs].col == cells[rhs].col && cells[lhs].row < cells[rhs].row);
+  };
+  if (!std::is_sorted(m_sorted.begin(), m_sorted.end(), less))
+  {
+    std::stable_sort(m_sorted.begin(), m_sorted.end(), less);
+  }
+
+  // hits of the previous column, [prev_begin, prev_end) in m_sorted, and the first
+  // of them which can still be a neighbour. Rows increase along a column, so
+  // the lower edge of the window only moves forward
+  std::size_t prev_begin = 0;
+  std::size_t prev_end = 0;
+  std::size_t prev_first = 0;
+  std::size_t col_begin = 0;
+  for (std::size_t k = 0; k < nhits; ++k)
+  {
+    const auto &cell = cells[m_sorted[k]];
+    if (k > 0 && cell.col != cells[m_sorted[k - 1]].col)
+    {
+      // new column. The previous one is only relevant if it is adjacent
+      if (max_dcol > 0 && cell.col == cells[m_sorted[k - 1]].col + 1)
+      {
+        prev_begin = col_begin;
+        prev_end = k;
+      }
+      else
+      {
+        prev_begin = prev_end = 0;
+      }
+      prev_first = prev_begin;
+      col_begin = k;
+    }
+
+    // same column, hits before in row order
+    for (std::size_t j = k; j > col_begin && cells[m_sorted[j - 1]].row >= cell.row - max_drow; --j)
+    {
+      unite(m_sorted[k], m_sorted[j - 1]);
+    }
+
+    // previous column, hits within the row window
+    while (prev_first < prev_end && cells[m_sorted[prev_first]].row < cell.row - max_drow)
+    {
+      ++prev_first;
+    }
+    for (std::size_t j = prev_first; j < prev_end && cells[m_sorted[j]].row <= cell.row + max_drow; ++j)
+    {
+      unite(m_sorted[k], m_sorted[j]);
+    }
+  }
+
+  // number the clusters in the order of their first hit
+  m_label.assign(nhits, -1);
+  m_component.resize(nhits);
+  int nclusters = 0;
+  for (std::size_t i = 0; i < nhits; ++i)
+  {
+    int &label = m_label[root(i)];
+    if (label < 0)
+    {
+      label = nclusters++;
+    }
+    m_component[i] = label;
+  }
+
+  // group the hits by cluster, keeping the hit order
+  m_offsets.assign(nclusters + 1, 0);
+  for (const int clusid : m_component)
+  {
+    ++m_offsets[clusid + 1];
+  }
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+  m_members.resize(nhits);
+  m_label.assign(nclusters, 0);  // reused as fill counter
+  for (std::size_t i = 0; i < nhits; ++i)
+  {
+    const int clusid = m_component[i];
+    m_members[m_offsets[clusid] + m_label[clusid]++] = i;
+  }
+
+  return nclusters;
+}
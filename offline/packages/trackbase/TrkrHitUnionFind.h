@@ -0,0 +1,80 @@
+/**
+ * @file trackbase/TrkrHitUnionFind.h
+ * @brief Connected hit groups on a pixel or strip grid
+ */
+#ifndef TRACKBASE_TRKRHITUNIONFIND_H
+#define TRACKBASE_TRKRHITUNIONFIND_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+/**
+ * @brief Connected hit groups on a pixel or strip grid
+ *
+ * Groups the hits of a sensor into clusters of neighbouring cells, as the
+ * boost::connected_components of the hit adjacency graph, but without testing
+ * all hit pairs. The hits are sorted by column and row and each hit is only
+ * compared to the hits before it in its own column and in the previous column,
+ * the groups are merged with a union find. This costs O(n log n) instead of O(n^2).
+ *
+ * Two hits are neighbours when their columns differ by at most max_dcol and
+ * their rows by at most max_drow. max_dcol is 0 or 1.
+ *
+ * The cluster ids are numbered the way boost::connected_components numbers
+ * them for the graph with one vertex per hit: ids follow the order of the
+ * first hit of each cluster. The hits of a cluster are listed in increasing
+ * hit order, so that the clusters are identical to the graph based ones.
+ *
+ * The object keeps its buffers, reusing it for all sensors avoids allocations.
+ */
+class TrkrHitUnionFind
+{
+ public:
+  //! cell coordinates of a hit
+  struct Cell
+  {
+    int col = 0;
+    int row = 0;
+  };
+
+  //! group the hits, returns the number of clusters
+  std::size_t find(const std::vector<Cell> &cells, int max_dcol, int max_drow);
+
+  //! number of clusters from the last call to find
+  std::size_t size() const { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+
+  //! cluster id of each hit
+  const std::vector<int> &component() const { return m_component; }
+
+  //! indices of the hits in a cluster, in increasing order
+  std::span<const std::size_t> hits(std::size_t clusid) const
+  {
+    return {m_members.data() + m_offsets[clusid], m_offsets[clusid + 1] - m_offsets[clusid]};
+  }
+
+ private:
+  //! root of the tree containing hit i, with path halving
+  std::size_t root(std::size_t i);
+
+  //! merge the trees of two hits
+  void unite(std::size_t i, std::size_t j);
+
+  //! hit indices sorted by column and row
+  std::vector<std::size_t> m_sorted;
+
+  //! union find parents
+  std::vector<std::size_t> m_parent;
+
+  //! cluster id of each hit
+  std::vector<int> m_component;
+
+  //! cluster id of each tree root, -1 when not assigned yet
+  std::vector<int> m_label;
+
+  //! hit indices grouped by cluster, with the range of cluster i in [m_offsets[i], m_offsets[i+1])
+  std::vector<std::size_t> m_members;
+  std::vector<std::size_t> m_offsets;
+};
+
+#endif
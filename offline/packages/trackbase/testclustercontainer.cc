@@ -0,0 +1,132 @@
+// checks that TrkrClusterContainerv5 (clusters by value) returns the same clusters
+// as the map based TrkrClusterContainerv4, over several events with removals
+
+#include "TpcDefs.h"
+#include "TrkrClusterContainerv4.h"
+#include "TrkrClusterContainerv5.h"
+#include "TrkrClusterv5.h"
+#include "TrkrDefs.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  bool same_cluster(const TrkrCluster *a, const TrkrCluster *b)
+  {
+    if (!a || !b)
+    {
+      return a == b;
+    }
+    return a->getLocalX() == b->getLocalX() &&
+           a->getLocalY() == b->getLocalY() &&
+           a->getAdc() == b->getAdc() &&
+           a->getSubSurfKey() == b->getSubSurfKey();
+  }
+
+  // compare two ranges of (key, cluster) pairs
+  bool same_range(const TrkrClusterContainer::ConstRange &a, const TrkrClusterContainer::ConstRange &b)
+  {
+    return std::equal(a.first, a.second, b.first, b.second,
+                      [](const auto &lhs, const auto &rhs)
+                      { return lhs.first == rhs.first && same_cluster(lhs.second, rhs.second); });
+  }
+}  // namespace
+
+int main()
+{
+  TrkrClusterContainerv4 v4;
+  TrkrClusterContainerv5 v5;
+
+  std::mt19937 rng(1234);
+  int failures = 0;
+  for (int event = 0; event < 5; ++event)
+  {
+    v4.Reset();
+    v5.Reset();
+
+    // TPC like clusters, inserted in random order with gaps in the cluster index
+    std::vector<TrkrDefs::cluskey> keys;
+    for (uint8_t layer = 7; layer < 55; ++layer)
+    {
+      for (uint8_t sector = 0; sector < 12; ++sector)
+      {
+        for (uint8_t side = 0; side < 2; ++side)
+        {
+          const auto hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
+          const uint32_t nclusters = rng() % 20;
+          for (uint32_t index = 0; index < nclusters; ++index)
+          {
+            keys.push_back(TrkrDefs::genClusKey(hitsetkey, index + (rng() % 3 == 0)));
+          }
+        }
+      }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    for (const auto key : keys)
+    {
+      TrkrClusterv5 cluster;
+      cluster.setLocalX(0.01 * (rng() % 10000));
+      cluster.setLocalY(0.01 * (rng() % 10000));
+      cluster.setAdc(rng() % 1000);
+      cluster.setSubSurfKey(rng() % 100);
+      v4.addClusterSpecifyKey(key, new TrkrClusterv5(cluster));
+      v5.addClusterSpecifyKey(key, new TrkrClusterv5(cluster));
+    }
+
+    // remove a few clusters and one full hitset
+    for (std::size_t i = 0; i < keys.size(); i += 17)
+    {
+      v4.removeCluster(keys[i]);
+      v5.removeCluster(keys[i]);
+    }
+    const auto removed_hitset = TrkrDefs::getHitSetKeyFromClusKey(keys.front());
+    v4.removeClusters(removed_hitset);
+    v5.removeClusters(removed_hitset);
+
+    if (v4.size() != v5.size())
+    {
+      std::cout << "testclustercontainer - event " << event << ": size " << v5.size() << " expected " << v4.size() << std::endl;
+      ++failures;
+    }
+
+    // every key, including removed and missing ones
+    for (const auto key : keys)
+    {
+      for (const auto k : {key, key + 1000})
+      {
+        if (!same_cluster(v4.findCluster(k), v5.findCluster(k)))
+        {
+          std::cout << "testclustercontainer - event " << event << ": findCluster differs for key " << k << std::endl;
+          ++failures;
+        }
+      }
+    }
+
+    const auto hitsetkeys = v4.getHitSetKeys();
+    if (hitsetkeys != v5.getHitSetKeys() || v4.getHitSetKeys(TrkrDefs::tpcId, 20) != v5.getHitSetKeys(TrkrDefs::tpcId, 20))
+    {
+      std::cout << "testclustercontainer - event " << event << ": hitset keys differ" << std::endl;
+      ++failures;
+    }
+    for (const auto hitsetkey : hitsetkeys)
+    {
+      if (!same_range(v4.getClusters(hitsetkey), v5.getClusters(hitsetkey)))
+      {
+        std::cout << "testclustercontainer - event " << event << ": clusters differ for hitset " << hitsetkey << std::endl;
+        ++failures;
+      }
+    }
+  }
+
+  // v4 does not delete its clusters on destruction
+  v4.Reset();
+
+  std::cout << "testclustercontainer - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,228 @@
+// checks that TrkrHitSetv2 (sorted vectors, hit arena) holds the same hits as the map based TrkrHitSetv1
+// over several recycled events, and that its const accessors can be used from several threads.
+// Also checks that a pooled TrkrHitSetContainerv1 returns the same hits as an unpooled one
+// and stops allocating once the events repeat
+
+#include "TpcDefs.h"
+#include "TrkrDefs.h"
+#include "TrkrHit.h"
+#include "TrkrHitSetContainerv1.h"
+#include "TrkrHitSetv1.h"
+#include "TrkrHitSetv2.h"
+#include "TrkrHitv2.h"
+
+#include <phool/PHEventPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // compare two ranges of (key, hit) pairs
+  bool same_range(const TrkrHitSet::ConstRange &a, const TrkrHitSet::ConstRange &b)
+  {
+    return std::equal(a.first, a.second, b.first, b.second,
+                      [](const auto &lhs, const auto &rhs)
+                      { return lhs.first == rhs.first && lhs.second->getAdc() == rhs.second->getAdc(); });
+  }
+
+  bool same_hit(const TrkrHit *a, const TrkrHit *b)
+  {
+    return (a && b) ? a->getAdc() == b->getAdc() : a == b;
+  }
+
+  PHEventPoolBase *find_pool(const std::string &name)
+  {
+    for (auto *pool : PHEventPoolBase::pools())
+    {
+      if (pool->Name() == name)
+      {
+        return pool;
+      }
+    }
+    return nullptr;
+  }
+
+  int check_container()
+  {
+    TrkrHitSetContainerv1 plain;
+    TrkrHitSetContainerv1 pooled;
+    pooled.UseEventPool("testhitset");
+    auto *hitset_pool = find_pool("testhitset");
+    auto *hit_pool = find_pool("testhitset_hits");
+    if (!hitset_pool || !hit_pool)
+    {
+      std::cout << "testhitset - pools are not registered" << std::endl;
+      return 1;
+    }
+
+    int failures = 0;
+    for (int event = 0; event < 4; ++event)
+    {
+      plain.Reset();
+      pooled.Reset();
+      if (event == 2)
+      {
+        // event 1 was a copy of event 0, nothing must have been allocated
+        if (hitset_pool->created() != 0 || hit_pool->created() != 0 || hitset_pool->reused() == 0 || hit_pool->reused() == 0)
+        {
+          std::cout << "testhitset - repeated event allocated " << hitset_pool->created() << " hitsets and "
+                    << hit_pool->created() << " hits" << std::endl;
+          ++failures;
+        }
+      }
+      hitset_pool->clear_counters();
+      hit_pool->clear_counters();
+
+      std::mt19937 rng(event < 2 ? 0 : event);
+      for (int ihit = 0; ihit < 20000; ++ihit)
+      {
+        const auto hitsetkey = TpcDefs::genHitSetKey(7 + rng() % 48, rng() % 12, rng() % 2);
+        const TrkrDefs::hitkey hitkey = rng() % 1000;
+        const unsigned int adc = rng() % 1024;
+        for (auto *container : {&plain, &pooled})
+        {
+          auto *hitset = container->findOrAddHitSet(hitsetkey)->second;
+          if (!hitset->getHit(hitkey))
+          {
+            hitset->addHit(hitkey)->setAdc(adc);
+          }
+        }
+      }
+
+      const auto removed = plain.getHitSets().first->first;
+      plain.removeHitSet(removed);
+      pooled.removeHitSet(removed);
+
+      const auto range = plain.getHitSets();
+      if (plain.size() != pooled.size())
+      {
+        std::cout << "testhitset - event " << event << ": " << pooled.size() << " pooled hitsets, expected " << plain.size() << std::endl;
+        ++failures;
+      }
+      for (auto iter = range.first; iter != range.second; ++iter)
+      {
+        const auto *hitset = pooled.findHitSet(iter->first);
+        if (!hitset || !same_range(iter->second->getHits(), hitset->getHits()))
+        {
+          std::cout << "testhitset - event " << event << ": pooled hitset " << iter->first << " differs" << std::endl;
+          ++failures;
+        }
+      }
+    }
+    return failures;
+  }
+}  // namespace
+
+int main()
+{
+  TrkrHitSetv1 v1;
+
+  // recycled between events, as done by a pooled TrkrHitSetContainerv1
+  TrkrHitSetv2 v2;
+
+  std::mt19937 rng(2468);
+  int failures = 0;
+  for (int event = 0; event < 5; ++event)
+  {
+    v1.Reset();
+    v2.Clear();
+
+    // random order, as filled by the unpackers
+    std::vector<TrkrDefs::hitkey> keys(2000 + 500 * event);
+    for (auto &key : keys)
+    {
+      key = rng() % 100000;
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    std::shuffle(keys.begin(), keys.end(), rng);
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+      const auto key = keys[i];
+
+      // lookups in between insertions, as done by the digitizers
+      if (!same_hit(v1.getHit(key), v2.getHit(key)) || !same_hit(v1.getHit(keys[i / 2]), v2.getHit(keys[i / 2])))
+      {
+        std::cout << "testhitset - event " << event << ": getHit differs before insertion of " << key << std::endl;
+        ++failures;
+      }
+
+      const unsigned int adc = rng() % 1024;
+      auto *hit = new TrkrHitv2;
+      hit->setAdc(adc);
+      v1.addHitSpecificKey(key, hit);
+
+      // half of the hits from the arena, half allocated by the caller
+      if (i % 2)
+      {
+        v2.addHit(key)->setAdc(adc);
+      }
+      else
+      {
+        auto *hit2 = new TrkrHitv2;
+        hit2->setAdc(adc);
+        const auto iter = v2.addHitSpecificKey(key, hit2);
+        if (iter->first != key || iter->second != hit2)
+        {
+          std::cout << "testhitset - event " << event << ": wrong iterator returned for key " << key << std::endl;
+          ++failures;
+        }
+      }
+    }
+
+    for (std::size_t i = 0; i < keys.size(); i += 13)
+    {
+      v1.removeHit(keys[i]);
+      v2.removeHit(keys[i]);
+    }
+
+    if (v1.size() != v2.size() || !same_range(v1.getHits(), v2.getHits()))
+    {
+      std::cout << "testhitset - event " << event << ": hits differ, size " << v2.size() << " expected " << v1.size() << std::endl;
+      ++failures;
+    }
+
+    // concurrent const reads, the first getHits call rebuilds the map
+    v2.addHit(keys[0]);
+    v1.addHit(keys[0]);
+    std::atomic<int> thread_failures = 0;
+    std::vector<std::thread> threads;
+    for (int ithread = 0; ithread < 4; ++ithread)
+    {
+      threads.emplace_back([&]
+                           {
+        for (const auto key : keys)
+        {
+          if (!same_hit(v1.getHit(key), v2.getHit(key)) || !same_hit(v1.getHit(key + 100000), v2.getHit(key + 100000)))
+          {
+            ++thread_failures;
+          }
+        }
+        if (!same_range(v1.getHits(), v2.getHits()))
+        {
+          ++thread_failures;
+        } });
+    }
+    for (auto &thread : threads)
+    {
+      thread.join();
+    }
+    if (thread_failures)
+    {
+      std::cout << "testhitset - event " << event << ": " << thread_failures << " differences in concurrent reads" << std::endl;
+      failures += thread_failures;
+    }
+  }
+
+  failures += check_container();
+
+  std::cout << "testhitset - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,173 @@
+// checks that the dense lookup tables of ActsSurfaceMaps return the same surfaces
+// and detector flags as the maps, for random silicon strobes and crossings,
+// for copies of the indexed maps and for keys without a surface
+
+#include "ActsSurfaceMaps.h"
+#include "InttDefs.h"
+#include "MvtxDefs.h"
+#include "TrkrDefs.h"
+
+#include <Acts/Geometry/GeometryIdentifier.hpp>
+#include <Acts/Surfaces/PerigeeSurface.hpp>
+#include <Acts/Surfaces/Surface.hpp>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // acts volume ids, one per detector
+  constexpr int mvtx_volume = 10;
+  constexpr int intt_volume = 12;
+  constexpr int tpc_volume = 14;
+  constexpr int micromegas_volume = 16;
+
+  Surface make_surface(int volume)
+  {
+    auto surface = Acts::Surface::makeShared<Acts::PerigeeSurface>(Acts::Vector3(0, 0, 0));
+    Acts::GeometryIdentifier id;
+    id.setVolume(volume);
+    surface->assignGeometryId(id);
+    return surface;
+  }
+
+  // MVTX, INTT, TPC and micromegas layers of the sPHENIX layout, with their volume ids
+  ActsSurfaceMaps make_maps(std::vector<TrkrDefs::hitsetkey>& keys)
+  {
+    ActsSurfaceMaps maps;
+    for (uint8_t layer = 0; layer < 3; ++layer)
+    {
+      for (uint8_t stave = 0; stave < 12 + 4 * layer; ++stave)
+      {
+        for (uint8_t chip = 0; chip < 9; ++chip)
+        {
+          const auto key = MvtxDefs::genHitSetKey(layer, stave, chip, 0);
+          maps.m_siliconSurfaceMap[key] = make_surface(mvtx_volume);
+          keys.push_back(key);
+        }
+      }
+    }
+    for (uint8_t layer = 3; layer < 7; ++layer)
+    {
+      for (uint8_t ladderz = 0; ladderz < 4; ++ladderz)
+      {
+        for (uint8_t ladderphi = 0; ladderphi < 12 + 4 * (layer / 5); ++ladderphi)
+        {
+          const auto key = InttDefs::genHitSetKey(layer, ladderz, ladderphi, 0);
+          maps.m_siliconSurfaceMap[key] = make_surface(intt_volume);
+          keys.push_back(key);
+        }
+      }
+    }
+    for (unsigned int layer = 7; layer < 55; ++layer)
+    {
+      SurfaceVec surfaces;
+      for (int i = 0; i < 24; ++i)
+      {
+        surfaces.push_back(make_surface(tpc_volume));
+      }
+      maps.m_tpcSurfaceMap[layer] = surfaces;
+    }
+    for (uint8_t layer = 55; layer < 57; ++layer)
+    {
+      for (unsigned int tile = 0; tile < 8; ++tile)
+      {
+        const auto key = TrkrDefs::genHitSetKey(TrkrDefs::micromegasId, layer) | (tile << 8U) | 1U;
+        maps.m_mmSurfaceMap[key] = make_surface(micromegas_volume);
+        keys.push_back(key);
+      }
+    }
+    maps.m_siVolumeIds = {mvtx_volume, intt_volume};
+    maps.m_tpcVolumeIds = {tpc_volume};
+    maps.m_micromegasVolumeIds = {micromegas_volume};
+    return maps;
+  }
+
+  bool same_flags(const ActsSurfaceMaps& a, const ActsSurfaceMaps& b, const Acts::Surface* surface)
+  {
+    return a.isSiSurface(surface) == b.isSiSurface(surface) &&
+           a.isTpcSurface(surface) == b.isTpcSurface(surface) &&
+           a.isMicromegasSurface(surface) == b.isMicromegasSurface(surface);
+  }
+}  // namespace
+
+int main()
+{
+  std::vector<TrkrDefs::hitsetkey> keys;
+  const auto maps = make_maps(keys);
+
+  const auto indexed = [&maps]
+  {
+    auto indexed_maps = maps;
+    indexed_maps.buildSurfaceIndex();
+    return indexed_maps;
+  }();
+
+  // copies keep the tables
+  const auto copy = indexed;
+
+  int failures = 0;
+  std::mt19937 rng(13579);
+  for (int i = 0; i < 200000; ++i)
+  {
+    auto key = keys[rng() % keys.size()];
+    const auto trkrid = TrkrDefs::getTrkrId(key);
+    if (trkrid == TrkrDefs::mvtxId)
+    {
+      key = MvtxDefs::genHitSetKey(TrkrDefs::getLayer(key), MvtxDefs::getStaveId(key), MvtxDefs::getChipId(key), static_cast<int>(rng() % 48) - 24);
+    }
+    else if (trkrid == TrkrDefs::inttId)
+    {
+      key = InttDefs::genHitSetKey(TrkrDefs::getLayer(key), InttDefs::getLadderZId(key), InttDefs::getLadderPhiId(key), static_cast<int>(rng() % 1200) - 600);
+    }
+
+    const auto surface = (trkrid == TrkrDefs::micromegasId) ? maps.getMMSurface(key) : maps.getSiliconSurface(key);
+    for (const auto* other : {&indexed, &copy})
+    {
+      const auto other_surface = (trkrid == TrkrDefs::micromegasId) ? other->getMMSurface(key) : other->getSiliconSurface(key);
+      if (!surface || other_surface != surface || !same_flags(maps, *other, surface.get()))
+      {
+        std::cout << "testsurfacemaps - hitsetkey " << key << ": indexed surface differs from the map" << std::endl;
+        ++failures;
+      }
+    }
+  }
+
+  // tpc layers, including layers without surfaces
+  for (unsigned int layer = 0; layer < 60; ++layer)
+  {
+    const auto key = TrkrDefs::genHitSetKey(TrkrDefs::tpcId, layer);
+    const auto* surfaces = maps.getTpcSurfaceVector(layer);
+    for (const auto* other : {&indexed, &copy})
+    {
+      const auto* other_surfaces = other->getTpcSurfaceVector(layer);
+      bool ok = (surfaces == nullptr) == (other_surfaces == nullptr);
+      if (ok && surfaces)
+      {
+        ok = *surfaces == *other_surfaces && maps.getTpcSurface(key, 5) == other->getTpcSurface(key, 5) &&
+             same_flags(maps, *other, surfaces->front().get());
+      }
+      if (!ok)
+      {
+        std::cout << "testsurfacemaps - tpc layer " << layer << ": indexed surfaces differ from the map" << std::endl;
+        ++failures;
+      }
+    }
+  }
+
+  // keys without a surface
+  const auto missing_mm = TrkrDefs::genHitSetKey(TrkrDefs::micromegasId, 55) | 0x7700U;
+  const auto missing_tpc = TrkrDefs::genHitSetKey(TrkrDefs::tpcId, 60);
+  for (const auto* other : {&indexed, &copy})
+  {
+    if (other->getMMSurface(missing_mm) || maps.getMMSurface(missing_mm) || other->getTpcSurface(missing_tpc, 0))
+    {
+      std::cout << "testsurfacemaps - surface returned for a missing key" << std::endl;
+      ++failures;
+    }
+  }
+
+  std::cout << "testsurfacemaps - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+// checks that TrkrHitUnionFind finds the same clusters, with the same numbering,
+// as connected components of the full hit adjacency graph
+
+#include "TrkrHitUnionFind.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // all pairs adjacency, components numbered in the order of their first hit
+  // like boost::connected_components
+  std::vector<int> brute_force(const std::vector<TrkrHitUnionFind::Cell> &cells, int max_dcol, int max_drow)
+  {
+    const std::size_t nhits = cells.size();
+    std::vector<int> component(nhits, -1);
+    int ncomponents = 0;
+    for (std::size_t seed = 0; seed < nhits; ++seed)
+    {
+      if (component[seed] >= 0)
+      {
+        continue;
+      }
+      std::vector<std::size_t> stack = {seed};
+      component[seed] = ncomponents;
+      while (!stack.empty())
+      {
+        const std::size_t i = stack.back();
+        stack.pop_back();
+        for (std::size_t j = 0; j < nhits; ++j)
+        {
+          if (component[j] < 0 &&
+              std::abs(cells[i].col - cells[j].col) <= max_dcol &&
+              std::abs(cells[i].row - cells[j].row) <= max_drow)
+          {
+            component[j] = ncomponents;
+            stack.push_back(j);
+          }
+        }
+      }
+      ++ncomponents;
+    }
+    return component;
+  }
+
+  // unique random cells in a ncols x nrows sensor, in key order (column major) or shuffled
+  std::vector<TrkrHitUnionFind::Cell> make_cells(std::mt19937 &rng, int ncols, int nrows, std::size_t nhits, bool sorted)
+  {
+    std::set<std::pair<int, int>> unique;
+    while (unique.size() < nhits)
+    {
+      unique.emplace(rng() % ncols, rng() % nrows);
+    }
+    std::vector<TrkrHitUnionFind::Cell> cells;
+    for (const auto &[col, row] : unique)
+    {
+      cells.push_back({col, row});
+    }
+    if (!sorted)
+    {
+      std::shuffle(cells.begin(), cells.end(), rng);
+    }
+    return cells;
+  }
+}  // namespace
+
+int main()
+{
+  // reused for all sensors, as in the clusterizers
+  TrkrHitUnionFind unionfind;
+
+  std::mt19937 rng(97531);
+  int failures = 0;
+  int ntests = 0;
+
+  // MVTX like (8-connected pixels) and INTT like (strips along a column) neighbourhoods,
+  // from empty and single hit sensors to dense ones where most hits merge
+  for (const auto &[max_dcol, max_drow] : {std::pair{1, 1}, std::pair{0, 1}, std::pair{1, 2}, std::pair{0, 3}})
+  {
+    for (const std::size_t nhits : {0, 1, 2, 10, 100, 500, 1500})
+    {
+      for (const bool sorted : {true, false})
+      {
+        for (int repeat = 0; repeat < 5; ++repeat)
+        {
+          ++ntests;
+          const auto cells = make_cells(rng, 40, 60, nhits, sorted);
+          const auto expected = brute_force(cells, max_dcol, max_drow);
+          const std::size_t nclusters = unionfind.find(cells, max_dcol, max_drow);
+
+          bool ok = unionfind.component() == expected &&
+                    nclusters == (expected.empty() ? 0 : static_cast<std::size_t>(*std::max_element(expected.begin(), expected.end()) + 1)) &&
+                    unionfind.size() == nclusters;
+
+          // members of each cluster, in increasing hit order
+          for (std::size_t clusid = 0; ok && clusid < nclusters; ++clusid)
+          {
+            std::vector<std::size_t> members;
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+              if (expected[i] == static_cast<int>(clusid))
+              {
+                members.push_back(i);
+              }
+            }
+            const auto hits = unionfind.hits(clusid);
+            ok = std::equal(hits.begin(), hits.end(), members.begin(), members.end());
+          }
+
+          if (!ok)
+          {
+            std::cout << "testunionfind - " << nhits << " hits, max_dcol " << max_dcol << " max_drow " << max_drow
+                      << (sorted ? " sorted" : " shuffled") << ": clusters differ from the graph components" << std::endl;
+            ++failures;
+          }
+        }
+      }
+    }
+  }
+
+  std::cout << "testunionfind - " << ntests << " sensors, " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
@@ -7,6 +7,7 @@
 
 #include "MakeActsGeometry.h"
 
+#include <trackbase/ActsPHFieldProvider.h>
 #include <trackbase/AlignmentTransformation.h>
 #include <trackbase/InttDefs.h>
 #include <trackbase/MvtxDefs.h>
@@ -290,13 +291,22 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
       gSystem->Exit(1);
     }
 
+    /*
+     * the grid implementation gives the same field and provides the
+     * interpolation cells used by the Acts field cache
+     */
     PHFieldConfigv1 fcfg;
-    fcfg.set_field_config(PHFieldConfig::FieldConfigTypes::Field3DCartesian);
+    fcfg.set_field_config(m_usePHFieldMap ? PHFieldConfig::FieldConfigTypes::Field3DCartesianGrid : PHFieldConfig::FieldConfigTypes::Field3DCartesian);
     fcfg.set_filename(m_magField);
     fcfg.set_magfield_rescale( m_magFieldRescale );
 
     // create corresponding map and store on node tree
-    PHFieldUtility::GetFieldMapNode(&fcfg, topNode);
+    PHField *field = PHFieldUtility::GetFieldMapNode(&fcfg, topNode);
+
+    if (m_useField && m_usePHFieldMap)
+    {
+      m_magneticField = std::make_shared<ActsPHFieldProvider>(field);
+    }
   }
 
   // Set the actsGeometry struct to be put on the node tree
@@ -335,6 +345,9 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
     surfMaps.m_micromegasVolumeIds.insert(surface->geometryId().volume());
   }
 
+  // dense lookup tables for the per cluster surface queries
+  surfMaps.buildSurfaceIndex();
+
   m_actsGeometry->setGeometry(trackingGeometry);
   m_actsGeometry->setSurfMaps(surfMaps);
   m_actsGeometry->set_drift_velocity(m_drift_velocity);
@@ -815,7 +828,12 @@ void MakeActsGeometry::makeGeometry(int argc, char *argv[], const std::string& r
   auto vm = ActsExamples::Options::parse(desc, argc, argv);
 
   m_tGeometry = m_TGeoDetector->m_detector.trackingGeometry();
-  if (m_useField)
+  if (m_useField && m_usePHFieldMap && !isConstantField(m_magField, fieldstrength))
+  {
+    // the field map is taken from the node tree in InitRun
+    m_magneticField = nullptr;
+  }
+  else if (m_useField)
   {
     m_magneticField = ActsExamples::Options::readMagneticField(vm);
   }
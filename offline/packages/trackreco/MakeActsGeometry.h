@@ -68,6 +68,10 @@ class MakeActsGeometry : public SubsysReco
   int InitRun(PHCompositeNode *topNode) override;
 
   void loadMagField(const bool field) { m_useField = field; }
+
+  /// give Acts the PHField map from the node tree (ActsPHFieldProvider)
+  /// instead of reading a separate Acts field map. Constant fields are not affected
+  void setUsePHFieldMap(bool value) { m_usePHFieldMap = value; }
   void setMagField(const std::string &magField)
   {
     m_magField = magField;
@@ -237,6 +241,7 @@ private:
   std::vector<double> v_globaldisplacement = {0., 0., 0.};
 
   bool m_useField = true;
+  bool m_usePHFieldMap = false;
   bool m_useActsMaterialMap = true;
   std::map<uint8_t, double> m_misalignmentFactor;
 
@@ -9,6 +9,7 @@
 
 #include "ActsPropagator.h"
 #include "MakeSourceLinks.h"
+#include "ParallelFitLoop.h"
 
 #include <tpc/TpcDistortionCorrectionContainer.h>
 
@@ -342,6 +343,13 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
 
   _topNode = topNode;
 
+  // the transient transforms of the source links and the outlier finder histograms are shared between tracks
+  if (m_num_threads > 1 && (!m_use_clustermover || m_useOutlierFinder))
+  {
+    std::cout << PHWHERE << " parallel fits need the cluster mover and no outlier finder, using one thread" << std::endl;
+    m_num_threads = 1;
+  }
+
   if (Verbosity() > 1)
   {
     std::cout << "Finish PHActsTrkFitter Setup" << std::endl;
@@ -378,7 +386,12 @@ int PHActsTrkFitter::process_event(PHCompositeNode* topNode)
   // in case the track map already exist in the file, we want to replace it
   m_trackMap->Reset();
 
+  PHTimer loopTimer("loopTimer");
+  loopTimer.stop();
+  loopTimer.restart();
   loopTracks(logLevel);
+  loopTimer.stop();
+  m_loopTime += loopTimer.get_accumulated_time();
 
   eventTimer.stop();
   auto eventTime = eventTimer.get_accumulated_time();
@@ -449,6 +462,11 @@ int PHActsTrkFitter::End(PHCompositeNode* /*topNode*/)
   if (Verbosity() > 0)
   {
     std::cout << "Finished PHActsTrkFitter" << std::endl;
+    if (m_event > 0)
+    {
+      std::cout << "PHActsTrkFitter::End - " << m_num_threads << " thread(s), track loop time per event "
+                << m_loopTime / m_event << " ms" << std::endl;
+    }
   }
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -457,6 +475,11 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 {
   auto logger = Acts::getDefaultLogger("PHActsTrkFitter", logLevel);
 
+  // with several threads the trials of all seeds are prepared first, then fitted in parallel
+  // and stored in seed order, so that the output does not depend on the number of threads
+  const bool threaded = m_num_threads > 1;
+  std::vector<FitTrial> trials;
+
   for (auto track : *m_seedMap)
   {
     if (!track)
@@ -587,449 +610,529 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
         std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
       }
 
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
-
-      SourceLinkVec sourceLinks;
-
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo, m_tGeometry, _topNode);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
-      makeSourceLinks.set_cluster_edge_rejection(m_cluster_edge_rejection);
-      for (const auto& layer : m_ignoreLayer)
+      FitTrial trial;
+      trial.track = track;
+      trial.tpcseed = tpcseed;
+      trial.siseed = siseed;
+      trial.crossing = this_crossing;
+      trial.ivary = ivary;
+      trial.nvary = nvary;
+      trial.use_estimate = use_estimate;
+      trial.valid = prepareFit(trial);
+
+      if (threaded)
       {
-        makeSourceLinks.ignoreLayer(layer);
+        trials.push_back(std::move(trial));
+        continue;
       }
-      // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-      // does nothing if m_transient_id_set is empty
-      makeSourceLinks.resetTransientTransformMap(
-          m_alignmentTransformationMapTransient,
-          m_transient_id_set,
-          m_tGeometry);
 
-      if (m_use_clustermover)
+      if (trial.valid)
       {
-        // make source links using cluster mover after making distortion correction
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              m_globalPositionWrapper,
-              this_crossing);
-        }
-
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            tpcseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            this_crossing);
-
-        // add tpc sourcelinks to silicon source links
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+        runFit(trial);
       }
-      else
-      {
-        // make source links using transient transforms for distortion corrections
-        if (Verbosity() > 1)
-        {
-          std::cout << "Calling getSourceLinks for si seed, siid " << siid << " and tpcid " << tpcid << std::endl;
-        }
+      storeFit(trial, chisq_ndf, svtx_vec);
+    }  // end ivary loop
 
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinks(
-              siseed,
-              measurements,
-              m_clusterContainer,
-              m_tGeometry,
-              m_globalPositionWrapper,
-              m_alignmentTransformationMapTransient,
-              m_transient_id_set,
-              this_crossing);
-        }
+    trackTimer.stop();
+    auto trackTime = trackTimer.get_accumulated_time();
 
-        if (Verbosity() > 1)
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+    }
+  }
+
+  if (threaded)
+  {
+    // the trials are not moved anymore, the fit results refer to their track containers
+    std::vector<float> chisq_ndf;
+    std::vector<SvtxTrack_v4> svtx_vec;
+    parallelFitLoop(
+        trials, m_num_threads,
+        [this](FitTrial& trial)
         {
-          std::cout << "Calling getSourceLinks for tpc seed, siid " << siid << " and tpcid " << tpcid << std::endl;
-        }
+          if (trial.valid)
+          {
+            runFit(trial);
+          }
+        },
+        [&](FitTrial& trial)
+        {
+          // first crossing trial of a new seed
+          if (trial.ivary == -trial.nvary)
+          {
+            chisq_ndf.clear();
+            svtx_vec.clear();
+          }
+          storeFit(trial, chisq_ndf, svtx_vec);
+        });
+  }
 
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-            tpcseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            m_alignmentTransformationMapTransient,
-            m_transient_id_set,
-            this_crossing);
-
-        // add tpc sourcelinks to silicon source links
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
-      }
+  return;
+}
 
-      Acts::GeometryContext geoContext{m_alignmentTransformationMapTransient};
+bool PHActsTrkFitter::prepareFit(FitTrial& trial)
+{
+  auto* track = trial.track;
+  auto* tpcseed = trial.tpcseed;
+  auto* siseed = trial.siseed;
+  const unsigned int tpcid = track->get_tpc_seed_index();
+  const unsigned int siid = track->get_silicon_seed_index();
+
+  auto& measurements = trial.measurements;
+  auto& sourceLinks = trial.sourceLinks;
+
+  MakeSourceLinks makeSourceLinks;
+  makeSourceLinks.initialize(_tpccellgeo, m_tGeometry, _topNode);
+  makeSourceLinks.setVerbosity(Verbosity());
+  makeSourceLinks.set_pp_mode(m_pp_mode);
+  makeSourceLinks.set_cluster_edge_rejection(m_cluster_edge_rejection);
+  for (const auto& layer : m_ignoreLayer)
+  {
+    makeSourceLinks.ignoreLayer(layer);
+  }
+  // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+  // does nothing if m_transient_id_set is empty
+  makeSourceLinks.resetTransientTransformMap(
+      m_alignmentTransformationMapTransient,
+      m_transient_id_set,
+      m_tGeometry);
+
+  if (m_use_clustermover)
+  {
+    // make source links using cluster mover after making distortion correction
+    if (siseed && !m_ignoreSilicon)
+    {
+      // silicon source links
+      sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+          siseed,
+          measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          m_globalPositionWrapper,
+          trial.crossing);
+    }
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = geoContext;
+    // tpc source links
+    const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+        tpcseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        trial.crossing);
+
+    // add tpc sourcelinks to silicon source links
+    sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+  }
+  else
+  {
+    // make source links using transient transforms for distortion corrections
+    if (Verbosity() > 1)
+    {
+      std::cout << "Calling getSourceLinks for si seed, siid " << siid << " and tpcid " << tpcid << std::endl;
+    }
 
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed && !m_ignoreSilicon)
-      {
-        position = TrackSeedHelper::get_xyz(siseed) * Acts::UnitConstants::cm;
-      }
-      if (!siseed || !is_valid(position) || m_forceTpcOnlyFit)
-      {
-        position = TrackSeedHelper::get_xyz(tpcseed) * Acts::UnitConstants::cm;
-      }
-      if (!is_valid(position))
-      {
-        if (Verbosity() > 4)
-        {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
-        }
-        continue;
-      }
+    if (siseed && !m_ignoreSilicon)
+    {
+      // silicon source links
+      sourceLinks = makeSourceLinks.getSourceLinks(
+          siseed,
+          measurements,
+          m_clusterContainer,
+          m_tGeometry,
+          m_globalPositionWrapper,
+          m_alignmentTransformationMapTransient,
+          m_transient_id_set,
+          trial.crossing);
+    }
+
+    if (Verbosity() > 1)
+    {
+      std::cout << "Calling getSourceLinks for tpc seed, siid " << siid << " and tpcid " << tpcid << std::endl;
+    }
 
-      // filter sourcelinks to remove detectors that we don't want to include in the fit
-      sourceLinks = filterSourceLinks( sourceLinks );
+    // tpc source links
+    const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+        tpcseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        m_alignmentTransformationMapTransient,
+        m_transient_id_set,
+        trial.crossing);
+
+    // add tpc sourcelinks to silicon source links
+    sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+  }
 
-      if (sourceLinks.empty())
-      {
-        continue;
-      }
+  Acts::GeometryContext geoContext{m_alignmentTransformationMapTransient};
 
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs || m_directNavigation)
-      {
+  // copy transient map for this track into transient geoContext
+  m_transient_geocontext = geoContext;
+  trial.geoContext = geoContext;
+
+  // position comes from the silicon seed, unless there is no silicon seed
+  Acts::Vector3 position(0, 0, 0);
+  if (siseed && !m_ignoreSilicon)
+  {
+    position = TrackSeedHelper::get_xyz(siseed) * Acts::UnitConstants::cm;
+  }
+  if (!siseed || !is_valid(position) || m_forceTpcOnlyFit)
+  {
+    position = TrackSeedHelper::get_xyz(tpcseed) * Acts::UnitConstants::cm;
+  }
+  if (!is_valid(position))
+  {
+    if (Verbosity() > 4)
+    {
+      std::cout << "Invalid position of " << position.transpose() << std::endl;
+    }
+    return false;
+  }
+
+  // filter sourcelinks to remove detectors that we don't want to include in the fit
+  sourceLinks = filterSourceLinks( sourceLinks );
+
+  if (sourceLinks.empty())
+  {
+    return false;
+  }
+
+  /// If using directed navigation, collect surface list to navigate
+  auto& surfaces = trial.surfaces;
+  if (m_fitSiliconMMs || m_directNavigation)
+  {
+
+    // get surfaces matching source links
+    const auto surfaces_tmp = getSurfaceVector(sourceLinks);
 
-        // get surfaces matching source links
-        const auto surfaces_tmp = getSurfaceVector(sourceLinks);
+    // skip if there is no surfaces
+    if (surfaces_tmp.empty())
+    {
+      return false;
+    }
 
-        // skip if there is no surfaces
-        if (surfaces_tmp.empty())
+    for (const auto& surface_apr : m_materialSurfaces)
+    {
+      if (m_forceSiOnlyFit)
+      {
+        if (surface_apr->geometryId().volume() > 12)
         {
           continue;
         }
-
-        for (const auto& surface_apr : m_materialSurfaces)
+      }
+      //else if (m_forceTpcOnlyFit)
+      //{
+      //  if (surface_apr->geometryId().volume() < 14)
+      //  {
+      //    continue;
+      //  }
+      //}
+      bool pop_flag = false;
+      if (surface_apr->geometryId().approach() == 1)
+      {
+        surfaces.push_back(surface_apr);
+      }
+      else
+      {
+        pop_flag = true;
+        for (const auto& surface_sns : surfaces_tmp)
         {
-          if (m_forceSiOnlyFit)
+          if (surface_apr->geometryId().volume() == surface_sns->geometryId().volume())
           {
-            if (surface_apr->geometryId().volume() > 12)
+            if (surface_apr->geometryId().layer() == surface_sns->geometryId().layer())
             {
-              continue;
-            }
-          }
-          //else if (m_forceTpcOnlyFit)
-          //{
-          //  if (surface_apr->geometryId().volume() < 14)
-          //  {
-          //    continue;
-          //  }
-          //}
-          bool pop_flag = false;
-          if (surface_apr->geometryId().approach() == 1)
-          {
-            surfaces.push_back(surface_apr);
-          }
-          else
-          {
-            pop_flag = true;
-            for (const auto& surface_sns : surfaces_tmp)
-            {
-              if (surface_apr->geometryId().volume() == surface_sns->geometryId().volume())
-              {
-                if (surface_apr->geometryId().layer() == surface_sns->geometryId().layer())
-                {
-                  pop_flag = false;
-                  surfaces.push_back(surface_sns);
-                }
-              }
-            }
-            if (!pop_flag)
-            {
-              surfaces.push_back(surface_apr);
-            }
-            else
-            {
-              surfaces.pop_back();
               pop_flag = false;
-            }
-            if (surface_apr->geometryId().volume() == 12 && surface_apr->geometryId().layer() == 8)
-            {
-              for (const auto& surface_sns : surfaces_tmp)
-              {
-                if (14 == surface_sns->geometryId().volume())
-                {
-                  surfaces.push_back(surface_sns);
-                }
-              }
+              surfaces.push_back(surface_sns);
             }
           }
         }
-        // With an empty ACTS material map, m_materialSurfaces is empty.
-        // Use the measurement surfaces directly for directed navigation.
-        if (surfaces.empty())
+        if (!pop_flag)
         {
-          surfaces = surfaces_tmp;
+          surfaces.push_back(surface_apr);
         }
-
-        checkSurfaceVec(surfaces);
-        if (Verbosity() > 1)
+        else
         {
-          for (const auto& surf : surfaces)
-          {
-            std::cout << "Surface vector : " << surf->geometryId() << std::endl;
-          }
+          surfaces.pop_back();
+          pop_flag = false;
         }
-
-        if (m_fitSiliconMMs)
+        if (surface_apr->geometryId().volume() == 12 && surface_apr->geometryId().layer() == 8)
         {
-          // make sure micromegas are in the tracks, if required
-          if (m_useMicromegas &&
-              std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-                           { return m_tGeometry->maps().isMicromegasSurface(surface); }))
+          for (const auto& surface_sns : surfaces_tmp)
           {
-            continue;
+            if (14 == surface_sns->geometryId().volume())
+            {
+              surfaces.push_back(surface_sns);
+            }
           }
         }
       }
+    }
+    // With an empty ACTS material map, m_materialSurfaces is empty.
+    // Use the measurement surfaces directly for directed navigation.
+    if (surfaces.empty())
+    {
+      surfaces = surfaces_tmp;
+    }
 
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
-
-      // get phi and theta from the silicon seed, momentum from the TPC seed
-      float seedphi = 0;
-      float seedtheta = 0;
-      float seedeta = 0;
-      if (siseed && !m_forceTpcOnlyFit)
+    checkSurfaceVec(surfaces);
+    if (Verbosity() > 1)
+    {
+      for (const auto& surf : surfaces)
       {
-        seedphi = siseed->get_phi();
-        seedtheta = siseed->get_theta();
-        seedeta = siseed->get_eta();
+        std::cout << "Surface vector : " << surf->geometryId() << std::endl;
       }
-      else
+    }
+
+    if (m_fitSiliconMMs)
+    {
+      // make sure micromegas are in the tracks, if required
+      if (m_useMicromegas &&
+          std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+                       { return m_tGeometry->maps().isMicromegasSurface(surface); }))
       {
-        seedphi = tpcseed->get_phi();
-        seedtheta = tpcseed->get_theta();
-        seedeta = tpcseed->get_eta();
+        return false;
       }
+    }
+  }
 
-      float seedpt = tpcseed->get_pt();
+  float px = std::numeric_limits<float>::quiet_NaN();
+  float py = std::numeric_limits<float>::quiet_NaN();
+  float pz = std::numeric_limits<float>::quiet_NaN();
 
-      if (m_ConstField)
-      {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-        float phi = seedphi;
-        float eta = seedeta;
-        float theta = seedtheta;
-        px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-        pz = pt * std::cosh(eta) * std::cos(theta);
-      }
-      else
-      {
-        px = seedpt * std::cos(seedphi);
-        py = seedpt * std::sin(seedphi);
-        pz = seedpt * std::cosh(seedeta) * std::cos(seedtheta);
-      }
+  // get phi and theta from the silicon seed, momentum from the TPC seed
+  float seedphi = 0;
+  float seedtheta = 0;
+  float seedeta = 0;
+  if (siseed && !m_forceTpcOnlyFit)
+  {
+    seedphi = siseed->get_phi();
+    seedtheta = siseed->get_theta();
+    seedeta = siseed->get_eta();
+  }
+  else
+  {
+    seedphi = tpcseed->get_phi();
+    seedtheta = tpcseed->get_theta();
+    seedeta = tpcseed->get_eta();
+  }
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
-      {
-        if (Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
-      }
+  float seedpt = tpcseed->get_pt();
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(position);
+  if (m_ConstField)
+  {
+    float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+    float phi = seedphi;
+    float eta = seedeta;
+    float theta = seedtheta;
+    px = pt * std::cos(phi);
+    py = pt * std::sin(phi);
+    pz = pt * std::cosh(eta) * std::cos(theta);
+  }
+  else
+  {
+    px = seedpt * std::cos(seedphi);
+    py = seedpt * std::sin(seedphi);
+    pz = seedpt * std::cosh(seedeta) * std::cos(seedtheta);
+  }
 
-      Acts::Vector4 actsFourPos(position(0), position(1), position(2), 10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+  Acts::Vector3 momentum(px, py, pz);
+  if (!is_valid(momentum))
+  {
+    if (Verbosity() > 4)
+    {
+      std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
+    }
+    return false;
+  }
 
-      int charge = tpcseed->get_charge();
+  trial.pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(position);
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      m_transient_geocontext,
-                      pSurface,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+  Acts::Vector4 actsFourPos(position(0), position(1), position(2), 10 * Acts::UnitConstants::ns);
+  Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+  int charge = tpcseed->get_charge();
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
+  /// Reset the track seed with the dummy covariance
+  trial.seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                   m_transient_geocontext,
+                   trial.pSurface,
+                   actsFourPos,
+                   momentum,
+                   charge / momentum.norm(),
+                   cov,
+                   Acts::ParticleHypothesis::pion())
+                   .value();
 
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
-      auto ppPlainOptions = Acts::PropagatorPlainOptions(m_transient_geocontext, magcontext);
+  if (Verbosity() > 2)
+  {
+    printTrackSeed(*trial.seed);
+  }
 
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
+  if (Verbosity() > 1)
+  {
+    std::cout << "Calling fitTrack for track with siid " << siid << " tpcid " << tpcid << " crossing " << trial.crossing << std::endl;
+    std::cout << "surfaces size " << surfaces.size() << " and source links size " << sourceLinks.size() << std::endl;
+  }
 
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
+  return true;
+}
 
-      auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
+void PHActsTrkFitter::runFit(FitTrial& trial) const
+{
+  /// Set host of propagator options for Acts to do e.g. material integration
+  auto calibptr = std::make_unique<Calibrator>();
+  CalibratorAdapter calibrator{*calibptr, trial.measurements};
+
+  auto magcontext = m_tGeometry->geometry().magFieldContext;
+  auto calibcontext = m_tGeometry->geometry().calibContext;
+  auto ppPlainOptions = Acts::PropagatorPlainOptions(trial.geoContext, magcontext);
+
+  ActsTrackFittingAlgorithm::GeneralFitterOptions
+      kfOptions{
+          trial.geoContext,
+          magcontext,
+          calibcontext,
+          trial.pSurface.get(),
+          ppPlainOptions};
+
+  PHTimer fitTimer("FitTimer");
+  fitTimer.stop();
+  fitTimer.restart();
+
+  auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
+  auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
+  trial.tracks.emplace(trackContainer, trackStateContainer);
+
+  trial.result.emplace(fitTrack(trial.sourceLinks, *trial.seed, kfOptions, trial.surfaces, calibrator, *trial.tracks));
+  fitTimer.stop();
+  trial.fitTime = fitTimer.get_accumulated_time();
+}
 
-      if (Verbosity() > 1)
+void PHActsTrkFitter::storeFit(FitTrial& trial, std::vector<float>& chisq_ndf, std::vector<SvtxTrack_v4>& svtx_vec)
+{
+  if (!trial.valid)
+  {
+    return;
+  }
+
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter Acts fit time " << trial.fitTime << std::endl;
+  }
+
+  auto* track = trial.track;
+  const unsigned int tpcid = track->get_tpc_seed_index();
+  const unsigned int siid = track->get_silicon_seed_index();
+  const auto& result = *trial.result;
+  const auto& tracks = *trial.tracks;
+  const auto& measurements = trial.measurements;
+
+  // fitted parameters are converted with the geometry context the track was fitted with
+  m_transient_geocontext = trial.geoContext;
+
+  /// Check that the track fit result did not return an error
+  if (result.ok())
+  {
+    if (trial.use_estimate)  // trial variation case
+    {
+      // this is a trial variation of the crossing estimate for this track
+      // Capture the chisq/ndf so we can choose the best one after all trials
+
+      SvtxTrack_v4 newTrack;
+      newTrack.set_tpc_seed(trial.tpcseed);
+      newTrack.set_crossing(trial.crossing);
+      newTrack.set_silicon_seed(trial.siseed);
+
+      if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
       {
-        std::cout << "Calling fitTrack for track with siid " << siid << " tpcid " << tpcid << " crossing " << crossing << std::endl;
-        std::cout << "surfaces size " << surfaces.size() << " and source links size " << sourceLinks.size() << std::endl;
+        float chi2ndf = newTrack.get_quality();
+        chisq_ndf.push_back(chi2ndf);
+        svtx_vec.push_back(newTrack);
+        if (Verbosity() > 1)
+        {
+          std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << trial.ivary << " this_crossing " << trial.crossing << " chi2ndf " << chi2ndf << std::endl;
+        }
       }
 
-      auto result = fitTrack(sourceLinks, seed, kfOptions, surfaces, calibrator, tracks);
-      fitTimer.stop();
+      if (trial.ivary != trial.nvary)
+      {
+        if (Verbosity() > 3)
+        {
+          std::cout << "Skipping track fit for trial variation" << std::endl;
+        }
+        return;
+      }
 
+      // if we are here this is the last crossing iteration, evaluate the results
       if (Verbosity() > 1)
       {
-        const auto fitTime = fitTimer.get_accumulated_time();
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+        std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
       }
-
-      /// Check that the track fit result did not return an error
-      if (result.ok())
+      float best_chisq = 1000.0;
+      short int best_ivary = 0;
+      for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
       {
-        if (use_estimate)  // trial variation case
+        if (chisq_ndf[i] < best_chisq)
         {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
-
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-          {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
-          }
-
-          if (ivary != nvary)
-          {
-            if (Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
-          }
-
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
-          {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
-          }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
-          {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
-          }
-          unsigned int trid = m_trackMap->size();
-          svtx_vec[best_ivary].set_id(trid);
-
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+          best_chisq = chisq_ndf[i];
+          best_ivary = i;
         }
-        else  // case where INTT crossing is known
+        if (Verbosity() > 1)
         {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
-
-          if (m_fitSiliconMMs)
-          {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              // insert in dedicated map
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
+          std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
+        }
+      }
+      unsigned int trid = m_trackMap->size();
+      svtx_vec[best_ivary].set_id(trid);
 
-          }  // end insert track for SC calib fit
-          else
-          {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
+      m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+    }
+    else  // case where INTT crossing is known
+    {
+      SvtxTrack_v4 newTrack;
+      newTrack.set_tpc_seed(trial.tpcseed);
+      newTrack.set_crossing(trial.crossing);
+      newTrack.set_silicon_seed(trial.siseed);
 
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }  // end case where INTT crossing is known
-      }
-      else if (!m_fitSiliconMMs)
+      if (m_fitSiliconMMs)
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
-        if (Verbosity() > 1)
+        unsigned int trid = m_directedTrackMap->size();
+        newTrack.set_id(trid);
+
+        if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
         {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
+          // insert in dedicated map
+          m_directedTrackMap->insertWithKey(&newTrack, trid);
         }
-      }  // end fit failed case
-    }  // end ivary loop
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+      }  // end insert track for SC calib fit
+      else
+      {
+        unsigned int trid = m_trackMap->size();
+        newTrack.set_id(trid);
 
+        if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+        {
+          m_trackMap->insertWithKey(&newTrack, trid);
+        }
+      }  // end insert track for normal fit
+    }  // end case where INTT crossing is known
+  }
+  else if (!m_fitSiliconMMs)
+  {
+    /// Track fit failed, get rid of the track from the map
+    m_nBadFits++;
     if (Verbosity() > 1)
     {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
+      std::cout << "Track fit failed for track " << m_seedMap->find(track)
+                << " with Acts error message "
+                << result.error() << ", " << result.error().message()
+                << std::endl;
     }
-  }
-
-  return;
+  }  // end fit failed case
 }
 
 bool PHActsTrkFitter::getTrackFitResult(
@@ -1119,7 +1222,7 @@ ActsTrackFittingAlgorithm::TrackFitterResult PHActsTrkFitter::fitTrack(
     const ActsTrackFittingAlgorithm::GeneralFitterOptions& kfOptions,
     const SurfacePtrVec& surfSequence,
     const CalibratorAdapter& calibrator,
-    ActsTrackFittingAlgorithm::TrackContainer& tracks)
+    ActsTrackFittingAlgorithm::TrackContainer& tracks) const
 {
   // use direct fit for silicon MM gits or direct navigation
   if (m_fitSiliconMMs || m_directNavigation)
@@ -20,6 +20,7 @@
 
 #include <Acts/Definitions/Algebra.hpp>
 #include <Acts/EventData/VectorMultiTrajectory.hpp>
+#include <Acts/Surfaces/PerigeeSurface.hpp>
 #include <Acts/Utilities/BinnedArray.hpp>
 #include <Acts/Utilities/Helpers.hpp>
 #include <Acts/Utilities/Logger.hpp>
@@ -30,11 +31,14 @@
 #include <TH1.h>
 #include <TH2.h>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 class alignmentTransformationContainer;
 class ActsGeometry;
 class SvtxTrack;
+class SvtxTrack_v4;
 class SvtxTrackMap;
 class TrackSeed;
 class TrackSeedContainer;
@@ -157,6 +161,11 @@ class PHActsTrkFitter : public SubsysReco
   void setDirectNavigation(bool flag) { m_directNavigation = flag; }
   void setClusterEdgeRejection(int edge ) { m_cluster_edge_rejection = edge; }
 
+  /// number of threads for the Acts fits of an event. With more than one thread the source links
+  /// are made first for all seeds, the fits run in parallel and the tracks are stored in seed order.
+  /// Needs the cluster mover and no outlier finder, falls back to one thread otherwise
+  void set_num_threads(int value) { m_num_threads = value; }
+
   /// extrapolation mode
   enum class ExtrapolationMode
   {
@@ -179,6 +188,42 @@ class PHActsTrkFitter : public SubsysReco
 
   void loopTracks(Acts::Logging::Level logLevel);
 
+  /// fit of one seed for one crossing hypothesis
+  struct FitTrial
+  {
+    TrackSeed* track = nullptr;
+    TrackSeed* tpcseed = nullptr;
+    TrackSeed* siseed = nullptr;
+    short int crossing = 0;
+    short int ivary = 0;
+    short int nvary = 0;
+    bool use_estimate = false;
+
+    /// false if the trial was rejected before the fit
+    bool valid = false;
+
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    SourceLinkVec sourceLinks;
+    SurfacePtrVec surfaces;
+    std::shared_ptr<Acts::PerigeeSurface> pSurface;
+    std::optional<ActsTrackFittingAlgorithm::TrackParameters> seed;
+    Acts::GeometryContext geoContext = Acts::GeometryContext::dangerouslyDefaultConstruct();
+
+    /// fit output. The result refers to the track container, the trial must not be moved once fitted
+    std::optional<ActsTrackFittingAlgorithm::TrackContainer> tracks;
+    std::optional<FitResult> result;
+    double fitTime = 0;
+  };
+
+  /// make the source links, surfaces and seed parameters. False if the trial cannot be fitted
+  bool prepareFit(FitTrial& trial);
+
+  /// run the Acts fit of a prepared trial. Only reads shared state, can run concurrently
+  void runFit(FitTrial& trial) const;
+
+  /// convert the fit result to an SvtxTrack and store it, keeping the best crossing trial
+  void storeFit(FitTrial& trial, std::vector<float>& chisq_ndf, std::vector<SvtxTrack_v4>& svtx_vec);
+
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(
       const std::vector<Acts::TrackIndexType>& tips,
@@ -194,7 +239,7 @@ class PHActsTrkFitter : public SubsysReco
     const ActsTrackFittingAlgorithm::GeneralFitterOptions& kfOptions,
     const SurfacePtrVec& surfSequence,
     const CalibratorAdapter& calibrator,
-    ActsTrackFittingAlgorithm::TrackContainer& tracks);
+    ActsTrackFittingAlgorithm::TrackContainer& tracks) const;
 
   // remove all source links for detectors that we don't want to include in the fit
   SourceLinkVec filterSourceLinks(const SourceLinkVec& sourceLinks ) const;
@@ -237,6 +282,12 @@ class PHActsTrkFitter : public SubsysReco
   /// Number of acts fits that returned an error
   int m_nBadFits = 0;
 
+  /// threads for the track fits, see set_num_threads
+  int m_num_threads = 1;
+
+  /// time spent in the track loop, in ms, for the summary at End
+  double m_loopTime = 0;
+
   /// Boolean to use normal tracking geometry navigator or the
   /// Acts::DirectedNavigator with a list of sorted silicon+MM surfaces
   bool m_fitSiliconMMs = false;
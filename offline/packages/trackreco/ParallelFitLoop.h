@@ -0,0 +1,25 @@
+#ifndef TRACKRECO_PARALLELFITLOOP_H
+#define TRACKRECO_PARALLELFITLOOP_H
+
+#include <cstddef>
+#include <vector>
+
+/// runs fit on all the trials with nthreads OpenMP threads, then calls store on each trial
+/// in order from the calling thread, so that the stored output does not depend on the number
+/// of threads. fit must only modify its own trial, the trials are not moved
+template <class Trial, class Fit, class Store>
+void parallelFitLoop(std::vector<Trial>& trials, int nthreads, const Fit& fit, const Store& store)
+{
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+  for (std::size_t i = 0; i < trials.size(); ++i)
+  {
+    fit(trials[i]);
+  }
+
+  for (auto& trial : trials)
+  {
+    store(trial);
+  }
+}
+
+#endif
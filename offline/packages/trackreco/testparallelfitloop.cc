@@ -0,0 +1,248 @@
+// checks that the threaded track loop of PHActsTrkFitter (trials prepared first, fitted with
+// parallelFitLoop and stored in trial order) gives the same tracks as the serial loop, which
+// prepares, fits and stores each trial in turn. The fits are least squares fits of a circle to
+// the points of each seed, shifted along z by the crossing hypothesis, and the store step keeps
+// the best crossing of each seed as PHActsTrkFitter::storeFit does
+
+#include "ParallelFitLoop.h"
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+  struct Point
+  {
+    double x = 0;
+    double y = 0;
+    double z = 0;
+  };
+
+  struct Trial
+  {
+    unsigned int seed = 0;
+    short int crossing = 0;
+    short int ivary = 0;
+    short int nvary = 0;
+    bool valid = false;
+    std::vector<Point> points;
+
+    // fit output
+    int nfits = 0;
+    double radius = 0;
+    double z0 = 0;
+    double chi2ndf = 0;
+  };
+
+  struct Track
+  {
+    unsigned int seed = 0;
+    short int crossing = 0;
+    double radius = 0;
+    double z0 = 0;
+    double chi2ndf = 0;
+
+    bool operator==(const Track& other) const
+    {
+      return seed == other.seed && crossing == other.crossing && radius == other.radius &&
+             z0 == other.z0 && chi2ndf == other.chi2ndf;
+    }
+  };
+
+  // algebraic circle fit, x^2 + y^2 = 2 a x + 2 b y + c solved with the normal equations,
+  // then the mean z with the drift of the crossing hypothesis removed
+  void fit(Trial& trial)
+  {
+    ++trial.nfits;
+
+    // scratch residuals, reused by the thread
+    static thread_local std::vector<double> residuals;
+    residuals.clear();
+
+    // normal equations m * (2a, 2b, c) = v
+    double m[3][3] = {};
+    double v[3] = {};
+    for (const auto& point : trial.points)
+    {
+      const double row[3] = {point.x, point.y, 1.};
+      const double rhs = point.x * point.x + point.y * point.y;
+      for (int i = 0; i < 3; ++i)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          m[i][j] += row[i] * row[j];
+        }
+        v[i] += row[i] * rhs;
+      }
+    }
+    auto det = [](const double a[3][3])
+    {
+      return a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]) -
+             a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]) +
+             a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    };
+    double solution[3];
+    for (int k = 0; k < 3; ++k)
+    {
+      double mk[3][3];
+      for (int i = 0; i < 3; ++i)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          mk[i][j] = (j == k) ? v[i] : m[i][j];
+        }
+      }
+      solution[k] = det(mk) / det(m);
+    }
+    const double xc = solution[0] / 2;
+    const double yc = solution[1] / 2;
+    const double radius = std::sqrt(solution[2] + xc * xc + yc * yc);
+
+    double sum_z = 0;
+    for (const auto& point : trial.points)
+    {
+      sum_z += point.z - 0.5 * trial.crossing;
+    }
+    trial.radius = radius;
+    trial.z0 = sum_z / trial.points.size();
+
+    double chi2 = 0;
+    for (const auto& point : trial.points)
+    {
+      residuals.push_back(std::hypot(point.x - xc, point.y - yc) - radius);
+      residuals.push_back(point.z - 0.5 * trial.crossing - trial.z0);
+    }
+    for (const double residual : residuals)
+    {
+      chi2 += residual * residual;
+    }
+    trial.chi2ndf = chi2 / (residuals.size() - 2);
+  }
+
+  // keeps the trials of a seed, the best one is stored after the last trial
+  void store(const Trial& trial, std::vector<Track>& candidates, std::vector<Track>& tracks)
+  {
+    if (!trial.valid)
+    {
+      return;
+    }
+    candidates.push_back({trial.seed, trial.crossing, trial.radius, trial.z0, trial.chi2ndf});
+    if (trial.ivary != trial.nvary)
+    {
+      return;
+    }
+    const Track* best = &candidates.front();
+    for (const auto& candidate : candidates)
+    {
+      if (candidate.chi2ndf < best->chi2ndf)
+      {
+        best = &candidate;
+      }
+    }
+    tracks.push_back(*best);
+  }
+
+  // points along a circle, with z drifting with the true crossing
+  Trial prepare(std::mt19937& rng, unsigned int seed, short int crossing, short int true_crossing)
+  {
+    std::normal_distribution<double> noise(0., 0.05);
+    const double radius = 20. + rng() % 500;
+    const double z0 = noise(rng) * 100.;
+
+    Trial trial;
+    trial.seed = seed;
+    trial.crossing = crossing;
+
+    // some seeds are rejected before the fit, as when there are too few source links
+    trial.valid = rng() % 20 != 0;
+    const unsigned int npoints = 10 + rng() % 40;
+    for (unsigned int i = 0; i < npoints; ++i)
+    {
+      const double phi = 0.02 * (i + 1);
+      trial.points.push_back({radius * (1 - std::cos(phi)) + noise(rng), radius * std::sin(phi) + noise(rng), z0 + 0.5 * true_crossing + noise(rng)});
+    }
+    return trial;
+  }
+}  // namespace
+
+int main()
+{
+  int failures = 0;
+  for (const int nthreads : {1, 2, 4, 8})
+  {
+    std::mt19937 serial_rng(4321);
+    std::mt19937 threaded_rng(4321);
+    for (int event = 0; event < 10; ++event)
+    {
+      std::vector<Track> serial_tracks;
+      std::vector<Trial> trials;
+      for (unsigned int seed = 0; seed < 500; ++seed)
+      {
+        // a single trial or a scan of the crossing around the estimate
+        const short int nvary = (seed % 3) ? 0 : 3;
+        const short int true_crossing = seed % 7;
+
+        // serial loop: each trial is prepared, fitted and stored in turn
+        std::vector<Track> candidates;
+        for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+        {
+          auto trial = prepare(serial_rng, seed, true_crossing + ivary, true_crossing);
+          trial.ivary = ivary;
+          trial.nvary = nvary;
+          if (trial.valid)
+          {
+            fit(trial);
+          }
+          store(trial, candidates, serial_tracks);
+        }
+
+        // threaded loop: all trials are prepared first
+        for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+        {
+          auto trial = prepare(threaded_rng, seed, true_crossing + ivary, true_crossing);
+          trial.ivary = ivary;
+          trial.nvary = nvary;
+          trials.push_back(std::move(trial));
+        }
+      }
+
+      std::vector<Track> tracks;
+      std::vector<Track> candidates;
+      parallelFitLoop(
+          trials, nthreads,
+          [](Trial& trial)
+          {
+            if (trial.valid)
+            {
+              fit(trial);
+            }
+          },
+          [&](Trial& trial)
+          {
+            // first crossing trial of a new seed
+            if (trial.ivary == -trial.nvary)
+            {
+              candidates.clear();
+            }
+            store(trial, candidates, tracks);
+          });
+
+      bool once = true;
+      for (const auto& trial : trials)
+      {
+        once = once && trial.nfits == (trial.valid ? 1 : 0);
+      }
+      if (!once || tracks != serial_tracks)
+      {
+        std::cout << "testparallelfitloop - " << nthreads << " threads, event " << event << ": " << tracks.size()
+                  << " tracks differ from " << serial_tracks.size() << " serial tracks" << std::endl;
+        ++failures;
+      }
+    }
+  }
+
+  std::cout << "testparallelfitloop - " << (failures ? "FAILED" : "OK") << std::endl;
+  return failures ? 1 : 0;
+}
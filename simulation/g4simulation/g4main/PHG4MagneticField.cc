@@ -24,5 +24,19 @@ void PHG4MagneticField::GetFieldValue(const double Point[4], double* Bfield) con
 {
   assert(field_);
 
-  field_->GetFieldValue(Point, Bfield);
+  if (cell_valid_ && cell_.contains(Point))
+  {
+    cell_.interpolate(Point, Bfield);
+    return;
+  }
+
+  cell_valid_ = field_->GetFieldCell(Point, cell_);
+  if (cell_valid_)
+  {
+    cell_.interpolate(Point, Bfield);
+  }
+  else
+  {
+    field_->GetFieldValue(Point, Bfield);
+  }
 }
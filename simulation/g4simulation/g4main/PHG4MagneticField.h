@@ -13,12 +13,18 @@
 #ifndef G4MAIN_PHG4MAGNETICFIELD_H
 #define G4MAIN_PHG4MAGNETICFIELD_H
 
+#include <phfield/PHFieldCell.h>
+
 #include <Geant4/G4MagneticField.hh>
 
 class PHField;
 
 /*!
  * \brief PHG4MagneticField interfaces with Geant4
+ *
+ * The map cell of the last point is cached, so that the steps of a track
+ * inside of the same cell are interpolated without going back to the map.
+ * Geant4 uses one field object per thread, the cache is not shared.
  */
 class PHG4MagneticField : public G4MagneticField
 {
@@ -34,12 +40,19 @@ class PHG4MagneticField : public G4MagneticField
   void set_field(const PHField* field)
   {
     field_ = field;
+    cell_valid_ = false;
   }
 
   void GetFieldValue(const double Point[4], double* Bfield) const override;
 
  private:
   const PHField* field_;
+
+  //! map cell of the last point
+  mutable PHFieldCell cell_;
+
+  //! true if cell_ is from the map
+  mutable bool cell_valid_ = false;
 };
 
 #endif /* SIMULATION_CORESOFTWARE_SIMULATION_G4SIMULATION_G4MAIN_PHG4MAGNETICFIELD_H_ */
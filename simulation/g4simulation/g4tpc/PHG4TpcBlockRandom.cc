@@ -0,0 +1,279 @@
+#include "PHG4TpcBlockRandom.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  //! Philox4x32 constants
+  constexpr uint32_t philox_m0 = 0xD2511F53U;
+  constexpr uint32_t philox_m1 = 0xCD9E8D57U;
+  constexpr uint32_t philox_w0 = 0x9E3779B9U;
+  constexpr uint32_t philox_w1 = 0xBB67AE85U;
+  constexpr unsigned int philox_rounds = 10;
+
+  //! Philox4x32-10 on the counter words, in place
+  inline void philox(uint32_t& c0, uint32_t& c1, uint32_t& c2, uint32_t& c3, uint32_t key0, uint32_t key1)
+  {
+    for (unsigned int round = 0; round < philox_rounds; ++round)
+    {
+      const uint64_t product0 = static_cast<uint64_t>(philox_m0) * c0;
+      const uint64_t product1 = static_cast<uint64_t>(philox_m1) * c2;
+      const uint32_t c1_in = c1;
+      const uint32_t c3_in = c3;
+      c0 = static_cast<uint32_t>(product1 >> 32U) ^ c1_in ^ key0;
+      c1 = static_cast<uint32_t>(product1);
+      c2 = static_cast<uint32_t>(product0 >> 32U) ^ c3_in ^ key1;
+      c3 = static_cast<uint32_t>(product0);
+      key0 += philox_w0;
+      key1 += philox_w1;
+    }
+  }
+
+  //! uniform in ]0,1[ with 52 bits from two words, the sum is exact
+  /*! the conversion is done from 32 bit words, since 64 bit integer conversions do not vectorize */
+  inline double to_uniform(uint32_t high, uint32_t low)
+  {
+    return high * 0x1p-32 + (low >> 12U) * 0x1p-52 + 0x1p-53;
+  }
+
+  //! poisson for small mean, by multiplication of uniform numbers
+  template <class Uniform>
+  unsigned int poisson_multiplication(double mu, Uniform&& uniform)
+  {
+    const double limit = std::exp(-mu);
+    unsigned int k = 0;
+    double product = uniform();
+    while (product > limit)
+    {
+      ++k;
+      product *= uniform();
+    }
+    return k;
+  }
+
+  //! poisson for large mean, transformed rejection with squeeze (Hoermann, PTRS)
+  template <class Uniform>
+  unsigned int poisson_ptrs(double mu, Uniform&& uniform)
+  {
+    const double slam = std::sqrt(mu);
+    const double loglam = std::log(mu);
+    const double b = 0.931 + 2.53 * slam;
+    const double a = -0.059 + 0.02483 * b;
+    const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+    const double vr = 0.9277 - 3.6224 / (b - 2);
+
+    while (true)
+    {
+      const double u = uniform() - 0.5;
+      const double v = uniform();
+      const double us = 0.5 - std::abs(u);
+      const double k = std::floor((2 * a / us + b) * u + mu + 0.43);
+      if (us >= 0.07 && v <= vr)
+      {
+        return static_cast<unsigned int>(k);
+      }
+      if (k < 0 || (us < 0.013 && v > us))
+      {
+        continue;
+      }
+      if (std::log(v) + std::log(invalpha) - std::log(a / (us * us) + b) <= -mu + k * loglam - std::lgamma(k + 1))
+      {
+        return static_cast<unsigned int>(k);
+      }
+    }
+  }
+}  // namespace
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::set_seed(uint64_t seed)
+{
+  m_key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32U)};
+  set_stream(m_event, m_id);
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::set_stream(uint32_t event, uint64_t id)
+{
+  m_event = event;
+  m_id = id;
+  m_position = 0;
+  m_next = buffer_size;
+  m_has_gaussian = false;
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::fill_uniform_pairs(double* values, std::size_t npairs)
+{
+  const uint32_t first = m_position;
+  const uint32_t event = m_event;
+  const uint32_t id_low = static_cast<uint32_t>(m_id);
+  const uint32_t id_high = static_cast<uint32_t>(m_id >> 32U);
+  const uint32_t key0 = m_key[0];
+  const uint32_t key1 = m_key[1];
+#pragma omp simd
+  for (std::size_t i = 0; i < npairs; ++i)
+  {
+    uint32_t c0 = first + static_cast<uint32_t>(i);
+    uint32_t c1 = event;
+    uint32_t c2 = id_low;
+    uint32_t c3 = id_high;
+    philox(c0, c1, c2, c3, key0, key1);
+    values[2 * i] = to_uniform(c0, c1);
+    values[2 * i + 1] = to_uniform(c2, c3);
+  }
+  m_position += static_cast<uint32_t>(npairs);
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::fill_uniform(std::span<double> values)
+{
+  const std::size_t npairs = values.size() / 2;
+  fill_uniform_pairs(values.data(), npairs);
+  if (values.size() % 2)
+  {
+    values.back() = uniform();
+  }
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::fill_flat(std::span<double> values, double a, double b)
+{
+  fill_uniform(values);
+  const double width = b - a;
+#pragma omp simd
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = a + width * values[i];
+  }
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::fill_gaussian(std::span<double> values, double sigma)
+{
+  // Box-Muller, on pairs of uniform numbers
+  fill_uniform(values);
+  const std::size_t npairs = values.size() / 2;
+  for (std::size_t i = 0; i < npairs; ++i)
+  {
+    const double radius = sigma * std::sqrt(-2 * std::log(values[2 * i]));
+    const double angle = 2 * M_PI * values[2 * i + 1];
+    values[2 * i] = radius * std::cos(angle);
+    values[2 * i + 1] = radius * std::sin(angle);
+  }
+  if (values.size() % 2)
+  {
+    values.back() = sigma * std::sqrt(-2 * std::log(values.back())) * std::cos(2 * M_PI * uniform());
+  }
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::fill_exponential(std::span<double> values, double mu)
+{
+  fill_uniform(values);
+  for (auto& value : values)
+  {
+    value = -mu * std::log(value);
+  }
+}
+
+//_____________________________________________________________________
+double PHG4TpcBlockRandom::uniform()
+{
+  if (m_next == buffer_size)
+  {
+    fill_uniform_pairs(m_buffer.data(), buffer_size / 2);
+    m_next = 0;
+  }
+  return m_buffer[m_next++];
+}
+
+//_____________________________________________________________________
+double PHG4TpcBlockRandom::gaussian(double sigma)
+{
+  if (m_has_gaussian)
+  {
+    m_has_gaussian = false;
+    return sigma * m_gaussian;
+  }
+
+  const double radius = std::sqrt(-2 * std::log(uniform()));
+  const double angle = 2 * M_PI * uniform();
+  m_gaussian = radius * std::sin(angle);
+  m_has_gaussian = true;
+  return sigma * radius * std::cos(angle);
+}
+
+//_____________________________________________________________________
+double PHG4TpcBlockRandom::exponential(double mu)
+{
+  return -mu * std::log(uniform());
+}
+
+//_____________________________________________________________________
+unsigned int PHG4TpcBlockRandom::poisson(double mu)
+{
+  if (!(mu > 0))
+  {
+    return 0;
+  }
+  auto draw = [this]
+  { return uniform(); };
+  return (mu < 10) ? poisson_multiplication(mu, draw) : poisson_ptrs(mu, draw);
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::InverseCdf::fill(const std::function<double(double)>& f, double xmin, double xmax, unsigned int npoints)
+{
+  m_cdf.clear();
+  if (npoints == 0 || !(xmax > xmin))
+  {
+    return;
+  }
+
+  m_xmin = xmin;
+  m_width = (xmax - xmin) / npoints;
+
+  // integral of each bin from the density at its edges, negative values are ignored
+  std::vector<double> cdf(npoints + 1, 0);
+  double previous = std::max(0., f(xmin));
+  for (unsigned int i = 1; i <= npoints; ++i)
+  {
+    const double current = std::max(0., f(xmin + i * m_width));
+    cdf[i] = cdf[i - 1] + 0.5 * (previous + current) * m_width;
+    previous = current;
+  }
+
+  const double integral = cdf.back();
+  if (!(integral > 0))
+  {
+    return;
+  }
+  for (auto& value : cdf)
+  {
+    value /= integral;
+  }
+  cdf.back() = 1;
+  m_cdf = std::move(cdf);
+}
+
+//_____________________________________________________________________
+double PHG4TpcBlockRandom::InverseCdf::sample(double u) const
+{
+  // first edge above u, the bin is the one which ends there
+  const auto upper = std::upper_bound(m_cdf.begin() + 1, m_cdf.end() - 1, u);
+  const auto bin = std::distance(m_cdf.begin(), upper) - 1;
+  const double low = m_cdf[bin];
+  const double content = m_cdf[bin + 1] - low;
+  const double fraction = content > 0 ? (u - low) / content : 0.5;
+  return m_xmin + (bin + fraction) * m_width;
+}
+
+//_____________________________________________________________________
+void PHG4TpcBlockRandom::InverseCdf::sample(std::span<double> values) const
+{
+  for (auto& value : values)
+  {
+    value = sample(value);
+  }
+}
@@ -0,0 +1,114 @@
+// Tell emacs that this is a C++ source
+// -*- C++ -*-.
+#ifndef G4TPC_PHG4TPCBLOCKRANDOM_H
+#define G4TPC_PHG4TPCBLOCKRANDOM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+//! counter based random numbers for the TPC simulation, drawn in bulk
+/*!
+ * The numbers come from the Philox4x32-10 generator (Salmon et al., SC11),
+ * where each number is a function of a key and a counter only. The key is
+ * made from the seed, the counter from the stream (event number and g4hit
+ * id) and the position in the stream. The numbers of a g4hit are therefore
+ * reproducible given the seed (from PHRandomSeed), independent of the order
+ * in which g4hits are processed and of the other modules.
+ *
+ * The fill methods generate whole arrays in one pass, the single number
+ * methods are served from an internal buffer.
+ */
+class PHG4TpcBlockRandom
+{
+ public:
+  PHG4TpcBlockRandom() = default;
+
+  //! set the key, usually from PHRandomSeed
+  void set_seed(uint64_t seed);
+
+  //! start a new stream, numbers are reproducible for given seed, event and id
+  void set_stream(uint32_t event, uint64_t id);
+
+  //!@name bulk generation
+  //@{
+  //! uniform in ]0,1[
+  void fill_uniform(std::span<double> values);
+
+  //! uniform in ]a,b[
+  void fill_flat(std::span<double> values, double a, double b);
+
+  //! gaussian with mean 0
+  void fill_gaussian(std::span<double> values, double sigma);
+
+  //! exponential with mean mu
+  void fill_exponential(std::span<double> values, double mu);
+  //@}
+
+  //!@name single numbers
+  //@{
+  //! uniform in ]0,1[
+  double uniform();
+
+  //! uniform in ]a,b[
+  double flat(double a, double b) { return a + (b - a) * uniform(); }
+
+  //! gaussian with mean 0
+  double gaussian(double sigma);
+
+  //! exponential with mean mu
+  double exponential(double mu);
+
+  //! poisson with mean mu
+  unsigned int poisson(double mu);
+  //@}
+
+  //! tabulated inverse cumulative distribution, to sample arbitrary shapes from uniform numbers
+  class InverseCdf
+  {
+   public:
+    //! tabulate the density f on npoints equal bins between xmin and xmax
+    void fill(const std::function<double(double)>& f, double xmin, double xmax, unsigned int npoints);
+
+    //! true if the table was filled with a positive integral
+    bool valid() const { return !m_cdf.empty(); }
+
+    //! x for a uniform number u in [0,1], linear inside each bin
+    double sample(double u) const;
+
+    //! transform uniform numbers into x, in place
+    void sample(std::span<double> values) const;
+
+   private:
+    double m_xmin{0};
+    double m_width{0};
+
+    //! normalized cumulative integral at the bin edges, starts at 0 and ends at 1
+    std::vector<double> m_cdf;
+  };
+
+ private:
+  //! two uniform numbers per counter, the counter is (position, event, id)
+  void fill_uniform_pairs(double* values, std::size_t npairs);
+
+  std::array<uint32_t, 2> m_key{};
+
+  //! counter words set by the stream, the position in the stream is the first word
+  uint32_t m_event{0};
+  uint64_t m_id{0};
+  uint32_t m_position{0};
+
+  //! buffer for the single numbers
+  static constexpr std::size_t buffer_size = 64;
+  std::array<double, buffer_size> m_buffer{};
+  std::size_t m_next{buffer_size};
+
+  //! second gaussian of the last Box-Muller pair
+  double m_gaussian{0};
+  bool m_has_gaussian{false};
+};
+
+#endif  // G4TPC_PHG4TPCBLOCKRANDOM_H
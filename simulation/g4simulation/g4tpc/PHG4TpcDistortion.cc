@@ -14,6 +14,7 @@
 #include <TH3.h>
 #include <TTree.h>
 
+#include <algorithm>
 #include <cmath>    // for sqrt, fabs, NAN
 #include <cstdlib>  // for exit
 #include <iostream>
@@ -86,6 +87,9 @@ void PHG4TpcDistortion::Init()
       hReach[0] = dynamic_cast<TH3*>(m_static_tfile->Get("hReachesReadout_negz"));
       hReach[1] = dynamic_cast<TH3*>(m_static_tfile->Get("hReachesReadout_posz"));
     }
+
+    // static maps are copied to dense grids once
+    fill_grids(static_histograms(), m_static_grids);
   }
 
   if (m_do_time_ordered_distortions)
@@ -145,6 +149,9 @@ void PHG4TpcDistortion::load_event(int event_num)
       std::cout << "Distortion map sequence repeating as of event number " << event_num << std::endl;
     }
     TimeTree->GetEntry(event_num);
+
+    // the histograms change with each entry
+    fill_grids(time_ordered_histograms(), m_time_ordered_grids);
   }
 
   return;
@@ -229,91 +236,227 @@ double PHG4TpcDistortion::get_reaches_readout(double r, double phi, double z) co
   return 1;
 }
 
-double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double z) const
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::get_distortions(std::size_t n, const double* r, const double* phi, const double* z,
+                                        double* dr, double* drphi, double* dz, double* reaches) const
 {
-  if (phi < 0)
-  {
-    phi += 2 * M_PI;
+  std::fill(dr, dr + n, 0.);
+  std::fill(drphi, drphi + n, 0.);
+  std::fill(dz, dz + n, 0.);
+
+  add_distortions(kR, n, r, phi, z, dr);
+  add_distortions(kPhi, n, r, phi, z, drphi);
+  add_distortions(kZ, n, r, phi, z, dz);
+
+  if (m_phi_hist_in_radians)
+  {  // if the hist is in radians, multiply by r to get the rphi distortion
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      drphi[i] *= r[i];
+    }
   }
-  const int zpart = (z > 0 ? 1 : 0);  // z<0 corresponds to the negative side, which is element 0.
 
-  TH3* hdistortion = nullptr;
+  if (reaches)
+  {
+    if (m_do_ReachesReadout)
+    {
+      std::fill(reaches, reaches + n, 0.);
+      add_distortions(kReaches, n, r, phi, z, reaches);
+    }
+    else
+    {
+      std::fill(reaches, reaches + n, 1.);
+    }
+  }
+}
 
-  if (axis != 'r' && axis != 'p' && axis != 'z' && axis != 'R')
+//__________________________________________________________________________________________________________
+double PHG4TpcDistortion::get_distortion(char axis, double r, double phi, double z) const
+{
+  Component component = kR;
+  switch (axis)
   {
+  case 'r':
+    component = kR;
+    break;
+  case 'p':
+    component = kPhi;
+    break;
+  case 'z':
+    component = kZ;
+    break;
+  case 'R':
+    component = kReaches;
+    break;
+  default:
     std::cout << "Distortion Requested along axis " << axis << " which is invalid.  Exiting.\n"
               << std::endl;
     exit(1);
   }
 
   double _distortion = 0.;
+  add_distortions(component, 1, &r, &phi, &z, &_distortion);
+  return _distortion;
+}
+
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::add_distortions(Component component, std::size_t n, const double* r, const double* phi, const double* z, double* values) const
+{
+  static constexpr std::array<char, kNComponents> axis_names = {'r', 'p', 'z', 'R'};
 
-  // select the appropriate histogram:
   if (m_do_static_distortions)
   {
-    if (axis == 'r')
+    TH3* const* histograms = static_histograms()[component];
+    if (!histograms[0] || !histograms[1])
     {
-      hdistortion = hDRint[zpart];
-    }
-    else if (axis == 'p')
-    {
-      hdistortion = hDPint[zpart];
-    }
-    else if (axis == 'z')
-    {
-      hdistortion = hDZint[zpart];
+      std::cout << "Static Distortion Requested along axis " << axis_names[component] << ", but distortion map does not exist.  Exiting.\n"
+                << std::endl;
+      exit(1);
     }
-    else if (axis == 'R')
+    add_distortions(m_static_grids[component], histograms, n, r, phi, z, values);
+  }
+
+  if (m_do_time_ordered_distortions)
+  {
+    TH3* const* histograms = time_ordered_histograms()[component];
+    if (!histograms[0] || !histograms[1])
     {
-      hdistortion = hReach[zpart];
+      std::cout << "Time Series Distortion Requested along axis " << axis_names[component] << ", but distortion map does not exist.  Exiting.\n"
+                << std::endl;
+      exit(1);
     }
-    if (hdistortion)
+    add_distortions(m_time_ordered_grids[component], histograms, n, r, phi, z, values);
+  }
+}
+
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::add_distortions(const DistortionGrid (&grids)[2], TH3* const* histograms, std::size_t n, const double* r, const double* phi, const double* z, double* values)
+{
+  if (!(grids[0].valid() && grids[1].valid()))
+  {
+    // variable size bins, use the histograms
+    for (std::size_t i = 0; i < n; ++i)
     {
-      if (check_boundaries(hdistortion, phi, r, z))
+      const double phi_i = phi[i] < 0 ? phi[i] + 2 * M_PI : phi[i];
+      const int zpart = (z[i] > 0 ? 1 : 0);  // z<0 corresponds to the negative side, which is element 0.
+      if (check_boundaries(histograms[zpart], phi_i, r[i], z[i]))
       {
-        _distortion += hdistortion->Interpolate(phi, r, z);
+        values[i] += histograms[zpart]->Interpolate(phi_i, r[i], z[i]);
       }
     }
-    else
+    return;
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const double phi_i = phi[i] < 0 ? phi[i] + 2 * M_PI : phi[i];
+    const int zpart = (z[i] > 0 ? 1 : 0);  // z<0 corresponds to the negative side, which is element 0.
+    values[i] += grids[zpart].interpolate(phi_i, r[i], z[i]);
+  }
+}
+
+//__________________________________________________________________________________________________________
+void PHG4TpcDistortion::fill_grids(const std::array<TH3* const*, kNComponents>& histograms, DistortionGrid (&grids)[kNComponents][2])
+{
+  for (int component = 0; component < kNComponents; ++component)
+  {
+    for (int zpart = 0; zpart < 2; ++zpart)
     {
-      std::cout << "Static Distortion Requested along axis " << axis << ", but distortion map does not exist.  Exiting.\n"
-                << std::endl;
-      exit(1);
+      // grids keep their storage from one event to the next
+      auto& grid = grids[component][zpart];
+      if (TH3* h = histograms[component][zpart])
+      {
+        grid.fill(h);
+      }
+      else
+      {
+        grid = DistortionGrid();
+      }
     }
   }
+}
 
-  if (m_do_time_ordered_distortions)
+//__________________________________________________________________________________________________________
+bool PHG4TpcDistortion::DistortionGrid::fill(const TH3* h)
+{
+  m_content.clear();
+
+  const std::array<const TAxis*, 3> axes = {h->GetXaxis(), h->GetYaxis(), h->GetZaxis()};
+  for (int i = 0; i < 3; ++i)
   {
-    if (axis == 'r')
+    // the interpolation needs at least one bin inside the first and last ones
+    if (axes[i]->IsVariableBinSize() || axes[i]->GetNbins() < 3)
     {
-      hdistortion = TimehDR[zpart];
+      return false;
     }
-    else if (axis == 'p')
+    m_axis[i].nbins = axes[i]->GetNbins();
+    m_axis[i].min = axes[i]->GetXmin();
+    m_axis[i].max = axes[i]->GetXmax();
+    m_axis[i].width = (m_axis[i].max - m_axis[i].min) / m_axis[i].nbins;
+  }
+
+  m_stride_y = m_axis[0].nbins + 2;
+  m_stride_z = m_stride_y * (m_axis[1].nbins + 2);
+  m_content.resize(m_stride_z * (m_axis[2].nbins + 2));
+  for (std::size_t bin = 0; bin < m_content.size(); ++bin)
+  {
+    m_content[bin] = h->GetBinContent(bin);
+  }
+  return true;
+}
+
+//__________________________________________________________________________________________________________
+double PHG4TpcDistortion::DistortionGrid::interpolate(double phi, double r, double z) const
+{
+  const std::array<double, 3> point = {phi, r, z};
+  std::array<std::size_t, 3> lower = {0, 0, 0};
+  std::array<double, 3> fraction = {0, 0, 0};
+  for (int i = 0; i < 3; ++i)
+  {
+    const auto& axis = m_axis[i];
+    const double x = point[i];
+
+    // same as TAxis::FindFixBin
+    int bin = 0;
+    if (x < axis.min)
     {
-      hdistortion = TimehDP[zpart];
+      bin = 0;
     }
-    else if (axis == 'z')
+    else if (!(x < axis.max))
     {
-      hdistortion = TimehDZ[zpart];
+      bin = axis.nbins + 1;
     }
-    else if (axis == 'R')
+    else
     {
-      hdistortion = TimehRR[zpart];
+      bin = 1 + int(axis.nbins * (x - axis.min) / (axis.max - axis.min));
     }
-    if (hdistortion)
+
+    // same as check_boundaries, the value must not be in the first and last bin
+    if (bin < 2 || bin >= axis.nbins)
     {
-      if (check_boundaries(hdistortion, phi, r, z))
-      {
-        _distortion += hdistortion->Interpolate(phi, r, z);
-      }
+      return 0;
     }
-    else
+
+    // neighbouring bin centers and interpolation fraction, same as TH3::Interpolate
+    const auto center = [&axis](int b)
+    { return axis.min + (b - 1) * axis.width + 0.5 * axis.width; };
+    if (x < center(bin))
     {
-      std::cout << "Time Series Distortion Requested along axis " << axis << ", but distortion map does not exist.  Exiting.\n"
-                << std::endl;
-      exit(1);
+      --bin;
     }
+    lower[i] = bin;
+    fraction[i] = (x - center(bin)) / (center(bin + 1) - center(bin));
   }
 
-  return _distortion;
+  const double* v = m_content.data() + lower[0] + m_stride_y * lower[1] + m_stride_z * lower[2];
+  const double xd = fraction[0];
+  const double yd = fraction[1];
+  const double zd = fraction[2];
+  const double i1 = v[0] * (1 - zd) + v[m_stride_z] * zd;
+  const double i2 = v[m_stride_y] * (1 - zd) + v[m_stride_y + m_stride_z] * zd;
+  const double j1 = v[1] * (1 - zd) + v[1 + m_stride_z] * zd;
+  const double j2 = v[1 + m_stride_y] * (1 - zd) + v[1 + m_stride_y + m_stride_z] * zd;
+  const double w1 = i1 * (1 - yd) + i2 * yd;
+  const double w2 = j1 * (1 - yd) + j2 * yd;
+  return w1 * (1 - xd) + w2 * xd;
 }
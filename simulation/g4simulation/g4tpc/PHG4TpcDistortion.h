@@ -11,8 +11,11 @@
 #ifndef G4TPC_PHG4TPCDISTORTION_H
 #define G4TPC_PHG4TPCDISTORTION_H
 
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <vector>
 
 class TFile;
 class TH3;
@@ -49,6 +52,14 @@ class PHG4TpcDistortion
   // The ReachesReadout serves as a fourth axis in the distortion histogram
   double get_reaches_readout(double r, double phi, double z) const;
 
+  //! r, r*phi, z distortions and reaches readout for n cylindrical truth locations at once
+  /*!
+   * same values as the single point accessors, evaluated in one pass per distortion map.
+   * reaches can be nullptr, it is set to 1 when ReachesReadout is disabled
+   */
+  void get_distortions(std::size_t n, const double *r, const double *phi, const double *z,
+                       double *dr, double *drphi, double *dz, double *reaches) const;
+
   //! Gets the verbosity of this module.
   int Verbosity() const
   {
@@ -110,9 +121,70 @@ class PHG4TpcDistortion
   //@}
 
  private:
+  //! dense copy of a distortion histogram
+  /*!
+   * holds the bin contents of a fixed binning TH3 in a contiguous array, and
+   * interpolates them the same way as TH3::Interpolate, without bin lookups
+   * through the histogram. Points in the first and last bin of any axis give 0,
+   * as check_boundaries does for the histograms
+   */
+  class DistortionGrid
+  {
+   public:
+    //! copy the histogram. Returns false, and leaves the grid invalid, for variable size bins
+    bool fill(const TH3 *h);
+
+    //! true when filled
+    bool valid() const { return !m_content.empty(); }
+
+    //! interpolated value at (phi, r, z), 0 outside the valid range
+    double interpolate(double phi, double r, double z) const;
+
+   private:
+    struct Axis
+    {
+      int nbins = 0;
+      double min = 0;
+      double max = 0;
+      double width = 0;
+    };
+
+    std::array<Axis, 3> m_axis;
+
+    //! bin contents with ROOT global bin numbering, including under and overflow bins
+    std::vector<double> m_content;
+    std::size_t m_stride_y = 0;
+    std::size_t m_stride_z = 0;
+  };
+
+  //! distortion components, index of the histograms and grids
+  enum Component
+  {
+    kR = 0,
+    kPhi,
+    kZ,
+    kReaches,
+    kNComponents
+  };
+
   //! get distortion for a set of histogram and an input momentum distribution
   double get_distortion(char axis, double r, double phi, double z) const;
 
+  //! add the static and time ordered distortions of one component to n points
+  void add_distortions(Component component, std::size_t n, const double *r, const double *phi, const double *z, double *values) const;
+
+  //! add interpolated values of a pair (negative, positive z) of histograms or grids to n points
+  static void add_distortions(const DistortionGrid (&grids)[2], TH3 *const *histograms, std::size_t n, const double *r, const double *phi, const double *z, double *values);
+
+  //! static histograms, indexed by component
+  std::array<TH3 *const *, kNComponents> static_histograms() const { return {hDRint, hDPint, hDZint, hReach}; }
+
+  //! time ordered histograms, indexed by component
+  std::array<TH3 *const *, kNComponents> time_ordered_histograms() const { return {TimehDR, TimehDP, TimehDZ, TimehRR}; }
+
+  //! rebuild the grids from the histograms
+  static void fill_grids(const std::array<TH3 *const *, kNComponents> &histograms, DistortionGrid (&grids)[kNComponents][2]);
+
   //! The verbosity level. 0 means not verbose at all.
   int verbosity = 0;
 
@@ -130,6 +202,7 @@ class PHG4TpcDistortion
   TH3 *hDPint[2] = {nullptr, nullptr};
   TH3 *hDZint[2] = {nullptr, nullptr};
   TH3 *hReach[2] = {nullptr, nullptr};
+  DistortionGrid m_static_grids[kNComponents][2];
   //@}
 
   //!@name time ordered histograms
@@ -142,6 +215,7 @@ class PHG4TpcDistortion
   TH3 *TimehDP[2] = {nullptr, nullptr};
   TH3 *TimehDZ[2] = {nullptr, nullptr};
   TH3 *TimehRR[2] = {nullptr, nullptr};
+  DistortionGrid m_time_ordered_grids[kNComponents][2];
   //@}
 };
 
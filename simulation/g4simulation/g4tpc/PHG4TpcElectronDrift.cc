@@ -59,6 +59,7 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cmath>    // for sqrt, abs, NAN
@@ -70,6 +71,9 @@
 
 namespace
 {
+  //! number of electrons drifted together
+  constexpr unsigned int electron_block_size = 256;
+
   template <class T>
   constexpr T square(const T &x)
   {
@@ -350,6 +354,7 @@ int PHG4TpcElectronDrift::InitRun(PHCompositeNode *topNode)
     se->registerHisto(ntpad);
   }
 
+  padplane->UseBlockRandom(m_use_block_random);
   padplane->InitRun(topNode);
 
   // print all layers radii
@@ -522,8 +527,15 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
     // Instead, use a temporary map to accumulate the charge from all
     // drifted electrons, then copy to the node tree later
 
+    if (m_use_block_random)
+    {
+      // the random numbers of a g4hit only depend on the seed, the event and the g4hit id
+      m_block_random.set_stream(event_num, hiter->first);
+      padplane->SetRandomStream(event_num, hiter->first);
+    }
+
     double eion = hiter->second->get_eion();
-    unsigned int n_electrons = gsl_ran_poisson(RandomGenerator.get(), eion * electrons_per_gev);
+    unsigned int n_electrons = m_use_block_random ? m_block_random.poisson(eion * electrons_per_gev) : gsl_ran_poisson(RandomGenerator.get(), eion * electrons_per_gev);
     //    count_electrons += n_electrons;
 
     if (Verbosity() > 100)
@@ -556,166 +568,227 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
     int notReachingReadout = 0;
     //    int notInAcceptance = 0;
-    for (unsigned int i = 0; i < n_electrons; i++)
+    // electrons are drifted in blocks, so that the distortions are looked up
+    // for the whole block at once. The gsl random numbers are drawn in the same
+    // order as electron by electron, the pad plane has its own generator
+    for (unsigned int block_start = 0; block_start < n_electrons; block_start += electron_block_size)
     {
-      // We choose the electron starting position at random from a flat
-      // distribution along the path length the parameter t is the fraction of
-      // the distance along the path betwen entry and exit points, it has
-      // values between 0 and 1
-      const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
-
-      const double x_start_glob = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-      const double y_start_glob = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-      const double z_start_glob = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-      const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
-
-      Acts::Vector3 start_glob(x_start_glob, y_start_glob, z_start_glob);
-      Acts::Vector3 start = m_tGeometry->transformTpcWorldToEnvelope(start_glob); // we drift in tpc envelope coords, where E is in the z direction
-
-      const double x_start = start.x();
-      const double y_start = start.y();
-      const double z_start = start.z();
-      /*
-      std::cout << " xg " << x_start_glob << " x " << x_start
-		<<" yg " << y_start_glob << " y " << y_start
-		<<" zg " << z_start_glob << " z " << z_start << std::endl;
-      */
-      unsigned int side = 0;
-      if (z_start > 0)
-      {
-        side = 1;
-      }
-
-      const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
-      const double rantrans =
-          gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
-          gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
-
-      const double t_path = (tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
-      const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
-      const double rantime =
-          gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
-	gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / layergeom->get_drift_velocity_sim();
-      double t_final = t_start + t_path + rantime;
-
-      if (t_final < min_time || t_final > max_time)
+      const unsigned int block_end = std::min(n_electrons, block_start + electron_block_size);
+      m_electrons.clear();
+      if (m_use_block_random)
       {
-        continue;
+        // one flat, four gaussian and one azimuthal number per electron
+        const unsigned int nrandom = block_end - block_start;
+        m_electrons.random_flat.resize(nrandom);
+        m_electrons.random_gaussian.resize(4 * nrandom);
+        m_electrons.random_phi.resize(nrandom);
+        m_block_random.fill_uniform(m_electrons.random_flat);
+        m_block_random.fill_gaussian(m_electrons.random_gaussian, 1);
+        m_block_random.fill_flat(m_electrons.random_phi, -M_PI, M_PI);
       }
 
-      double z_final;
-      if (z_start < 0)
+      for (unsigned int i = block_start; i < block_end; i++)
       {
-        z_final = -tpc_length / 2. + t_final * layergeom->get_drift_velocity_sim();
-      }
-      else
-      {
-        z_final = tpc_length / 2. - t_final * layergeom->get_drift_velocity_sim();
-      }
+        const unsigned int irandom = i - block_start;
+
+        // We choose the electron starting position at random from a flat
+        // distribution along the path length the parameter t is the fraction of
+        // the distance along the path betwen entry and exit points, it has
+        // values between 0 and 1
+        const double f = m_use_block_random ? m_electrons.random_flat[irandom] : gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
+
+        const double x_start_glob = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
+        const double y_start_glob = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
+        const double z_start_glob = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
+        const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
+
+        Acts::Vector3 start_glob(x_start_glob, y_start_glob, z_start_glob);
+        Acts::Vector3 start = m_tGeometry->transformTpcWorldToEnvelope(start_glob); // we drift in tpc envelope coords, where E is in the z direction
+
+        const double x_start = start.x();
+        const double y_start = start.y();
+        const double z_start = start.z();
+
+        const double r_sigma = diffusion_trans * sqrt(tpc_length / 2. - std::abs(z_start));
+        const double rantrans = m_use_block_random ?
+            r_sigma * m_electrons.random_gaussian[4 * irandom] +
+            added_smear_sigma_trans * m_electrons.random_gaussian[4 * irandom + 1] :
+            gsl_ran_gaussian(RandomGenerator.get(), r_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_trans);
+
+        const double t_path = (tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
+        const double t_sigma = diffusion_long * sqrt(tpc_length / 2. - std::abs(z_start)) / layergeom->get_drift_velocity_sim();
+        const double rantime = m_use_block_random ?
+            t_sigma * m_electrons.random_gaussian[4 * irandom + 2] +
+            added_smear_sigma_long * m_electrons.random_gaussian[4 * irandom + 3] / layergeom->get_drift_velocity_sim() :
+            gsl_ran_gaussian(RandomGenerator.get(), t_sigma) +
+            gsl_ran_gaussian(RandomGenerator.get(), added_smear_sigma_long) / layergeom->get_drift_velocity_sim();
+        const double t_final = t_start + t_path + rantime;
+
+        if (t_final < min_time || t_final > max_time)
+        {
+          continue;
+        }
 
-      const double radstart = std::sqrt(square(x_start) + square(y_start));
-      const double phistart = std::atan2(y_start, x_start);
-      const double ranphi = gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
+        double z_final;
+        if (z_start < 0)
+        {
+          z_final = -tpc_length / 2. + t_final * layergeom->get_drift_velocity_sim();
+        }
+        else
+        {
+          z_final = tpc_length / 2. - t_final * layergeom->get_drift_velocity_sim();
+        }
 
-      double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
-      double y_final = y_start + rantrans * std::sin(ranphi);
+        const double radstart = std::sqrt(square(x_start) + square(y_start));
+        const double phistart = std::atan2(y_start, x_start);
+        const double ranphi = m_use_block_random ? m_electrons.random_phi[irandom] : gsl_ran_flat(RandomGenerator.get(), -M_PI, M_PI);
 
-      double rad_final = sqrt(square(x_final) + square(y_final));
-      double phi_final = atan2(y_final, x_final);
+        m_electrons.add(i, f, x_start, y_start, z_start, radstart, phistart, t_start, t_path, t_sigma, rantime, t_final, z_final, rantrans, ranphi);
+      }
 
-      if (do_ElectronDriftQAHistos)
+      const std::size_t nblock = m_electrons.index.size();
+      if (m_distortionMap)
       {
-        z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
-        deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
-        deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
+        m_distortionMap->get_distortions(nblock, m_electrons.radstart.data(), m_electrons.phistart.data(), m_electrons.z_start.data(),
+                                         m_electrons.dr.data(), m_electrons.drphi.data(), m_electrons.dz.data(), m_electrons.reaches.data());
       }
 
-      if (m_distortionMap)
+      for (std::size_t ie = 0; ie < nblock; ++ie)
       {
-        // zhangcanyu
-        const double reaches = m_distortionMap->get_reaches_readout(radstart, phistart, z_start);
-        if (reaches < thresholdforreachesreadout)
+        const unsigned int i = m_electrons.index[ie];
+        const double f = m_electrons.f[ie];
+        const double x_start = m_electrons.x_start[ie];
+        const double y_start = m_electrons.y_start[ie];
+        const double z_start = m_electrons.z_start[ie];
+        const double radstart = m_electrons.radstart[ie];
+        const double phistart = m_electrons.phistart[ie];
+        const double t_start = m_electrons.t_start[ie];
+        const double t_path = m_electrons.t_path[ie];
+        const double t_sigma = m_electrons.t_sigma[ie];
+        const double rantime = m_electrons.rantime[ie];
+        const double rantrans = m_electrons.rantrans[ie];
+        const double ranphi = m_electrons.ranphi[ie];
+        double t_final = m_electrons.t_final[ie];
+        double z_final = m_electrons.z_final[ie];
+
+        unsigned int side = 0;
+        if (z_start > 0)
         {
-          notReachingReadout++;
-          continue;
+          side = 1;
         }
 
-        const double r_distortion = m_distortionMap->get_r_distortion(radstart, phistart, z_start);
-        const double phi_distortion = m_distortionMap->get_rphi_distortion(radstart, phistart, z_start) / radstart;
-        const double z_distortion = m_distortionMap->get_z_distortion(radstart, phistart, z_start);
+        double x_final = x_start + rantrans * std::cos(ranphi);  // Initialize these to be only diffused first, will be overwritten if doing SC distortion
+        double y_final = y_start + rantrans * std::sin(ranphi);
 
-        rad_final += r_distortion;
-        phi_final += phi_distortion;
-        z_final += z_distortion;
-        if (z_start < 0)
+        double rad_final = sqrt(square(x_final) + square(y_final));
+        double phi_final = atan2(y_final, x_final);
+
+        if (do_ElectronDriftQAHistos)
         {
-          t_final = (z_final + tpc_length / 2.0) / layergeom->get_drift_velocity_sim();
+          z_startmap->Fill(z_start, radstart);                   // map of starting location in Z vs. R
+          deltaphinodist->Fill(phistart, rantrans / rad_final);  // delta phi no distortion, just diffusion+smear
+          deltarnodist->Fill(radstart, rantrans);                // delta r no distortion, just diffusion+smear
         }
-        else
+
+        if (m_distortionMap)
         {
-          t_final = (tpc_length / 2.0 - z_final) / layergeom->get_drift_velocity_sim();
-        }
+          // zhangcanyu
+          if (m_electrons.reaches[ie] < thresholdforreachesreadout)
+          {
+            notReachingReadout++;
+            continue;
+          }
+
+          const double r_distortion = m_electrons.dr[ie];
+          const double phi_distortion = m_electrons.drphi[ie] / radstart;
+          const double z_distortion = m_electrons.dz[ie];
 
-        x_final = rad_final * std::cos(phi_final);
-        y_final = rad_final * std::sin(phi_final);
+          rad_final += r_distortion;
+          phi_final += phi_distortion;
+          z_final += z_distortion;
+          if (z_start < 0)
+          {
+            t_final = (z_final + tpc_length / 2.0) / layergeom->get_drift_velocity_sim();
+          }
+          else
+          {
+            t_final = (tpc_length / 2.0 - z_final) / layergeom->get_drift_velocity_sim();
+          }
 
-        //	if(i < 1)
-        //{std::cout << " electron " << i << " r_distortion " << r_distortion << " phi_distortion " << phi_distortion << " rad_final " << rad_final << " phi_final " << phi_final << " r*dphi distortion " << rad_final * phi_distortion << " z_distortion " << z_distortion << std::endl;}
+          x_final = rad_final * std::cos(phi_final);
+          y_final = rad_final * std::sin(phi_final);
 
-        if (do_ElectronDriftQAHistos)
+          if (do_ElectronDriftQAHistos)
+          {
+            const double phi_final_nodiff = phistart + phi_distortion;
+            const double rad_final_nodiff = radstart + r_distortion;
+            deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
+            deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
+            deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
+            deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
+
+            // Fill Diagnostic plots, written into ElectronDriftQA.root
+            hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
+            hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
+            hitmapstart_z->Fill(z_start, radstart);
+            hitmapend_z->Fill(z_final, rad_final);
+            deltar->Fill(radstart, rad_final - radstart);    // total delta r
+            deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
+            deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+          }
+        }
+
+        // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
+        if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
         {
-          const double phi_final_nodiff = phistart + phi_distortion;
-          const double rad_final_nodiff = radstart + r_distortion;
-          deltarnodiff->Fill(radstart, rad_final_nodiff - radstart);    // delta r no diffusion, just distortion
-          deltaphinodiff->Fill(phistart, phi_final_nodiff - phistart);  // delta phi no diffusion, just distortion
-          deltaphivsRnodiff->Fill(radstart, phi_final_nodiff - phistart);
-          deltaRphinodiff->Fill(radstart, rad_final_nodiff * phi_final_nodiff - radstart * phistart);
-
-          // Fill Diagnostic plots, written into ElectronDriftQA.root
-          hitmapstart->Fill(x_start, y_start);  // G4Hit starting positions
-          hitmapend->Fill(x_final, y_final);    // INcludes diffusion and distortion
-          hitmapstart_z->Fill(z_start, radstart);
-          hitmapend_z->Fill(z_final, rad_final);
-          deltar->Fill(radstart, rad_final - radstart);    // total delta r
-          deltaphi->Fill(phistart, phi_final - phistart);  // total delta phi
-          deltaz->Fill(z_start, z_distortion);             // map of distortion in Z (time)
+          //        notInAcceptance++;
+          continue;
         }
-      }
 
-      // remove electrons outside of our acceptance. Careful though, electrons from just inside 30 cm can contribute in the 1st active layer readout, so leave a little margin
-      if (rad_final < min_active_radius - 2.0 || rad_final > max_active_radius + 1.0)
-      {
-        //        notInAcceptance++;
-        continue;
-      }
+        if (Verbosity() > 1000)
+        //      if(i < 1)
+        {
+          std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
+          std::cout << "radstart " << radstart << " x_start: " << x_start
+                    << ", y_start: " << y_start
+                    << ",z_start: " << z_start
+                    << " t_start " << t_start
+                    << " t_path " << t_path
+                    << " t_sigma " << t_sigma
+                    << " rantime " << rantime
+                    << std::endl;
+
+          std::cout << "       rad_final " << rad_final << " x_final " << x_final
+                    << " y_final " << y_final
+                    << " z_final " << z_final << " t_final " << t_final
+                    << " zdiff " << z_final - z_start << std::endl;
+        }
 
-      if (Verbosity() > 1000)
-      //      if(i < 1)
-      {
-        std::cout << "electron " << i << " g4hitid " << hiter->first << " f " << f << std::endl;
-        std::cout << "radstart " << radstart << " x_start: " << x_start
-                  << ", y_start: " << y_start
-                  << ",z_start: " << z_start
-                  << " t_start " << t_start
-                  << " t_path " << t_path
-                  << " t_sigma " << t_sigma
-                  << " rantime " << rantime
-                  << std::endl;
-
-        std::cout << "       rad_final " << rad_final << " x_final " << x_final
-                  << " y_final " << y_final
-                  << " z_final " << z_final << " t_final " << t_final
-                  << " zdiff " << z_final - z_start << std::endl;
+        if (Verbosity() > 0)
+        {
+          assert(nt);
+          nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
+        }
+        // the pad plane takes the electrons of the block which end on the same side at once
+        if (!m_electrons.x_gem.empty() && side != m_electrons.gem_side)
+        {
+          padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                  temp_hitsetcontainer.get(), hittruthassoc, m_electrons.x_gem, m_electrons.y_gem, m_electrons.t_gem,
+                                  m_electrons.gem_side, hiter, ntpad, nthit);
+          m_electrons.clear_gem();
+        }
+        m_electrons.gem_side = side;
+        m_electrons.x_gem.push_back(x_final);
+        m_electrons.y_gem.push_back(y_final);
+        m_electrons.t_gem.push_back(t_final);
       }
-
-      if (Verbosity() > 0)
+      if (!m_electrons.x_gem.empty())
       {
-        assert(nt);
-        nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
+        padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                                temp_hitsetcontainer.get(), hittruthassoc, m_electrons.x_gem, m_electrons.y_gem, m_electrons.t_gem,
+                                m_electrons.gem_side, hiter, ntpad, nthit);
       }
-      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
-                              temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
-                              side, hiter, ntpad, nthit);
     }  // end loop over electrons for this g4hit
 
     if (do_ElectronDriftQAHistos)
@@ -836,6 +909,9 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
   }  // end loop over g4hits
 
+  // charge kept by the pad plane for the whole event
+  padplane->FillHitSets(hitsetcontainer);
+
   if (truth_track)
   {
     truth_clusterer.cluster_hits(truth_track);
@@ -947,6 +1023,53 @@ int PHG4TpcElectronDrift::End(PHCompositeNode * /*topNode*/)
 void PHG4TpcElectronDrift::set_seed(const unsigned int seed)
 {
   gsl_rng_set(RandomGenerator.get(), seed);
+  m_block_random.set_seed(seed);
+}
+
+void PHG4TpcElectronDrift::ElectronBlock::clear()
+{
+  // clear keeps the capacity for the next block
+  for (auto *values : {&f, &x_start, &y_start, &z_start, &radstart, &phistart, &t_start, &t_path, &t_sigma,
+                       &rantime, &t_final, &z_final, &rantrans, &ranphi, &dr, &drphi, &dz, &reaches})
+  {
+    values->clear();
+  }
+  index.clear();
+  clear_gem();
+}
+
+void PHG4TpcElectronDrift::ElectronBlock::clear_gem()
+{
+  x_gem.clear();
+  y_gem.clear();
+  t_gem.clear();
+}
+
+void PHG4TpcElectronDrift::ElectronBlock::add(unsigned int i, double f_, double x_start_, double y_start_, double z_start_,
+                                              double radstart_, double phistart_, double t_start_, double t_path_, double t_sigma_,
+                                              double rantime_, double t_final_, double z_final_, double rantrans_, double ranphi_)
+{
+  index.push_back(i);
+  f.push_back(f_);
+  x_start.push_back(x_start_);
+  y_start.push_back(y_start_);
+  z_start.push_back(z_start_);
+  radstart.push_back(radstart_);
+  phistart.push_back(phistart_);
+  t_start.push_back(t_start_);
+  t_path.push_back(t_path_);
+  t_sigma.push_back(t_sigma_);
+  rantime.push_back(rantime_);
+  t_final.push_back(t_final_);
+  z_final.push_back(z_final_);
+  rantrans.push_back(rantrans_);
+  ranphi.push_back(ranphi_);
+
+  // filled by the distortion map
+  dr.push_back(0);
+  drphi.push_back(0);
+  dz.push_back(0);
+  reaches.push_back(1);
 }
 
 void PHG4TpcElectronDrift::SetDefaultParameters()
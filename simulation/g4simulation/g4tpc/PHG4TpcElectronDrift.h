@@ -3,6 +3,7 @@
 #ifndef G4TPC_PHG4TPCELECTRONDRIFT_H
 #define G4TPC_PHG4TPCELECTRONDRIFT_H
 
+#include "PHG4TpcBlockRandom.h"
 #include "TpcClusterBuilder.h"
 
 #include <trackbase/ActsGeometry.h>
@@ -17,10 +18,12 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <fstream>
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHG4TpcPadPlane;
 class PHG4TpcDistortion;
@@ -84,6 +87,8 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   void set_zero_bfield_flag(bool flag) { zero_bfield = flag; };
   void set_zero_bfield_diffusion_factor(double f) { zero_bfield_diffusion_factor = f; };
   void use_PDG_gas_params() { m_use_PDG_gas_params = true; }
+  //! draw the random numbers in bulk from counter based streams, reproducible per g4hit, also for the pad plane
+  void use_block_random(bool flag = true) { m_use_block_random = flag; }
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
@@ -143,6 +148,7 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   bool do_getReachReadout{false};
   bool zero_bfield{false};
   bool m_use_PDG_gas_params{false};
+  bool m_use_block_random{false};
 
   std::unique_ptr<TrkrHitSetContainer> temp_hitsetcontainer;
   std::unique_ptr<TrkrHitSetContainer> single_hitsetcontainer;
@@ -151,6 +157,50 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
   std::unique_ptr<TFile> m_outf;
   std::unique_ptr<TFile> EDrift_outf;
 
+  //! electrons of one block which reached the readout in time, one array per quantity
+  struct ElectronBlock
+  {
+    void clear();
+    void clear_gem();
+    void add(unsigned int i, double f, double x_start, double y_start, double z_start,
+             double radstart, double phistart, double t_start, double t_path, double t_sigma,
+             double rantime, double t_final, double z_final, double rantrans, double ranphi);
+
+    std::vector<unsigned int> index;
+    std::vector<double> f;
+    std::vector<double> x_start;
+    std::vector<double> y_start;
+    std::vector<double> z_start;
+    std::vector<double> radstart;
+    std::vector<double> phistart;
+    std::vector<double> t_start;
+    std::vector<double> t_path;
+    std::vector<double> t_sigma;
+    std::vector<double> rantime;
+    std::vector<double> t_final;
+    std::vector<double> z_final;
+    std::vector<double> rantrans;
+    std::vector<double> ranphi;
+
+    //! random numbers of all electrons of the block, when drawn in bulk
+    std::vector<double> random_flat;
+    std::vector<double> random_gaussian;
+    std::vector<double> random_phi;
+
+    //! distortions at the start position
+    std::vector<double> dr;
+    std::vector<double> drphi;
+    std::vector<double> dz;
+    std::vector<double> reaches;
+
+    //! electrons at the gem waiting for the pad plane, all on gem_side
+    std::vector<double> x_gem;
+    std::vector<double> y_gem;
+    std::vector<double> t_gem;
+    unsigned int gem_side{0};
+  };
+  ElectronBlock m_electrons;
+
   std::string detector;
   std::string hitnodename;
   std::string seggeonodename;
@@ -163,6 +213,9 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
     void operator()(gsl_rng *rng) const { gsl_rng_free(rng); }
   };
   std::unique_ptr<gsl_rng, Deleter> RandomGenerator;
+
+  //! counter based random numbers, used instead of RandomGenerator with use_block_random
+  PHG4TpcBlockRandom m_block_random;
 };
 
 #endif  // G4TPC_PHG4TPCELECTRONDRIFT_H
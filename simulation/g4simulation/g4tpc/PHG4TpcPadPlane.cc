@@ -47,3 +47,11 @@ int PHG4TpcPadPlane::InitRun(PHCompositeNode *topNode)
   UpdateInternalParameters();
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+void PHG4TpcPadPlane::MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, std::span<const double> x_gem, std::span<const double> y_gem, std::span<const double> t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit)
+{
+  for (std::size_t i = 0; i < x_gem.size(); ++i)
+  {
+    MapToPadPlane(builder, single_hitsetcontainer, hitsetcontainer, hittruthassoc, x_gem[i], y_gem[i], t_gem[i], side, hiter, ntpad, nthit);
+  }
+}
@@ -9,6 +9,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <span>
 #include <string>  // for string
 
 class TrkrHitSetContainer;
@@ -31,8 +32,17 @@ class PHG4TpcPadPlane : public SubsysReco, public PHParameterInterface
   virtual void SetReadoutTime(float) { return; }
   int InitRun(PHCompositeNode *topNode) override;
   virtual void UpdateInternalParameters() { return; }
+  //! draw the random numbers from counter based streams (PHG4TpcBlockRandom) instead of the gsl generator
+  virtual void UseBlockRandom(bool /*flag*/) { return; }
+  //! start the random stream of a g4hit, used with UseBlockRandom
+  virtual void SetRandomStream(unsigned int /*event*/, PHG4HitDefs::keytype /*hitid*/) { return; }
   //  virtual void MapToPadPlane(PHG4CellContainer * /*g4cells*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) {}
   virtual void MapToPadPlane(TpcClusterBuilder & /*builder*/, TrkrHitSetContainer * /*single_hitsetcontainer*/, TrkrHitSetContainer * /*hitsetcontainer*/, TrkrHitTruthAssoc * /*hittruthassoc*/, const double /*x_gem*/, const double /*y_gem*/, const double /*t_gem*/, const unsigned int /*side*/, PHG4HitContainer::ConstIterator /*hiter*/, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) = 0;  // { return {}; }
+  //! block of electrons of one g4hit, by default one electron at a time
+  /*! implementations may keep the charge and add it to the hitsets only in FillHitSets */
+  virtual void MapToPadPlane(TpcClusterBuilder &builder, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc *hittruthassoc, std::span<const double> x_gem, std::span<const double> y_gem, std::span<const double> t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple *ntpad, TNtuple *nthit);
+  //! add the charge kept by the pad plane to the hitsets, called once per event after the last MapToPadPlane
+  virtual void FillHitSets(TrkrHitSetContainer * /*hitsetcontainer*/) { return; }
   void Detector(const std::string &name) { detector = name; }
 
  protected:
@@ -37,12 +37,14 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_alloc
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>  // for getenv
 #include <format>
 #include <fstream>
 #include <iostream>
 #include <map>      // for _Rb_tree_cons...
+#include <tuple>
 #include <utility>  // for pair
 
 class PHCompositeNode;
@@ -72,6 +74,12 @@ namespace
 
   constexpr unsigned int print_layer = 18;
 
+  //! number of bins of the tabulated gain distributions
+  constexpr unsigned int langau_cdf_bins = 1000;
+
+  //! bin width of the radius to layer lookup table (cm)
+  constexpr double layer_lookup_step = 0.05;
+
 }  // namespace
 
 PHG4TpcPadPlaneReadout::PHG4TpcPadPlaneReadout(const std::string &name)
@@ -82,7 +90,9 @@ PHG4TpcPadPlaneReadout::PHG4TpcPadPlaneReadout(const std::string &name)
   // if(m_flagToUseGain==1)
   ReadGain();
 
-  gsl_rng_set(RandomGenerator, PHRandomSeed());  // fixed seed is handled in this funtcion
+  const unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
+  gsl_rng_set(RandomGenerator, seed);
+  m_block_random.set_seed(seed);
 
   return;
 }
@@ -108,6 +118,7 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
   const std::string seggeonodename = "TPCGEOMCONTAINER";
   GeomContainer = findNode::getClass<PHG4TpcGeomContainer>(topNode, seggeonodename);
   assert(GeomContainer);
+  make_layer_lookup();
   
   PHG4TpcGeom *layergeom =  GeomContainer->GetLayerCellGeom(20);  // z geometry is the same for all layers
   double tpc_adc_clock = layergeom->get_adc_clock();
@@ -203,6 +214,12 @@ int PHG4TpcPadPlaneReadout::InitRun(PHCompositeNode *topNode)
 		    return (par[2] * step * sum * invsq2pi / par[3]); }, 0, 5000, 4);
 
           flangau[side][region][sector]->SetParameters(par0, par1, par2, par3);
+          if (m_use_block_random)
+          {
+            TF1 *f = flangau[side][region][sector];
+            m_langau_cdf[side][region][sector].fill([f](double x)
+                                                    { return f->Eval(x); }, 0, 5000, langau_cdf_bins);
+          }
           // std::cout << " iside " << iside << " side " << side << " ir " << ir
           //	    << " region " << region << " isec " << isec
           //	    << " sector " << sector << " weight " << weight << std::endl;
@@ -233,7 +250,7 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification()
   // Bob A.: I like Tom's suggestion to use the exponential distribution as a first approximation
   //         for the single electron gain distribution -
   //         and yes, the parameter you're looking for is of course the slope, which is the inverse gain.
-  double nelec = gsl_ran_exponential(RandomGenerator, averageGEMGain);
+  double nelec = m_use_block_random ? m_block_random.exponential(averageGEMGain) : gsl_ran_exponential(RandomGenerator, averageGEMGain);
   if (m_usePolya)
   {
     double y;
@@ -241,8 +258,8 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification()
     double ymax = 0.376;
     while (true)
     {
-      nelec = gsl_ran_flat(RandomGenerator, 0, xmax);
-      y = gsl_rng_uniform(RandomGenerator) * ymax;
+      nelec = m_use_block_random ? m_block_random.flat(0, xmax) : gsl_ran_flat(RandomGenerator, 0, xmax);
+      y = (m_use_block_random ? m_block_random.uniform() : gsl_rng_uniform(RandomGenerator)) * ymax;
       if (y <= pow((1 + polyaTheta) * (nelec / averageGEMGain), polyaTheta) * exp(-(1 + polyaTheta) * (nelec / averageGEMGain)))
       {
         break;
@@ -266,7 +283,7 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(double weight)
   //         for the single electron gain distribution -
   //         and yes, the parameter you're looking for is of course the slope, which is the inverse gain.
   double q_bar = averageGEMGain * weight;
-  double nelec = gsl_ran_exponential(RandomGenerator, q_bar);
+  double nelec = m_use_block_random ? m_block_random.exponential(q_bar) : gsl_ran_exponential(RandomGenerator, q_bar);
   if (m_usePolya)
   {
     double y;
@@ -274,8 +291,8 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(double weight)
     double ymax = 0.376;
     while (true)
     {
-      nelec = gsl_ran_flat(RandomGenerator, 0, xmax);
-      y = gsl_rng_uniform(RandomGenerator) * ymax;
+      nelec = m_use_block_random ? m_block_random.flat(0, xmax) : gsl_ran_flat(RandomGenerator, 0, xmax);
+      y = (m_use_block_random ? m_block_random.uniform() : gsl_rng_uniform(RandomGenerator)) * ymax;
       if (y <= pow((1 + polyaTheta) * (nelec / q_bar), polyaTheta) * exp(-(1 + polyaTheta) * (nelec / q_bar)))
       {
         break;
@@ -296,6 +313,12 @@ double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(TF1 *f)
   return nelec;
 }
 
+//_________________________________________________________
+double PHG4TpcPadPlaneReadout::getSingleEGEMAmplification(const PHG4TpcBlockRandom::InverseCdf &cdf)
+{
+  return cdf.sample(m_block_random.uniform());
+}
+
 void PHG4TpcPadPlaneReadout::MapToPadPlane(
     TpcClusterBuilder &tpc_truth_clusterer,
     TrkrHitSetContainer *single_hitsetcontainer,
@@ -308,18 +331,148 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   // The x_gem and y_gem values have already been randomized within the transverse drift diffusion width
   // The t_gem value already reflects the drift time of the primary electron from the production point, and is randomized within the longitudinal diffusion witdth
 
-  double phi = atan2(y_gem, x_gem);
-  if (phi > +M_PI)
+  if (!amplify_electron(x_gem, y_gem, t_gem, side, hiter))
   {
-    phi -= 2 * M_PI;
+    return;
   }
-  if (phi < -M_PI)
+
+  // new containers
+  //============
+  // We add the Tpc TrkrHitsets directly to the node using hitsetcontainer
+  // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a Tpc readout module
+  distribute_charge(tpc_truth_clusterer, side, t_gem,
+                    [&](TrkrDefs::hitsetkey hitsetkey, TrkrDefs::hitkey hitkey, unsigned int /*sector*/, int /*pad_num*/, int /*tbin_num*/, float neffelectrons, bool masked)
+                    {
+                      // Use existing hitset or add new one if needed
+                      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
+                      TrkrHitSetContainer::Iterator single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
+                      if (masked)
+                      {
+                        return;
+                      }
+                      add_energy(hitsetit->second, hitkey, neffelectrons);
+                      // repeat for the single_hitsetcontainer
+                      add_energy(single_hitsetit->second, hitkey, neffelectrons);
+                    });
+
+  m_NHits++;
+}
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::MapToPadPlane(
+    TpcClusterBuilder &tpc_truth_clusterer,
+    TrkrHitSetContainer *single_hitsetcontainer,
+    TrkrHitSetContainer *hitsetcontainer,
+    TrkrHitTruthAssoc * /*hittruthassoc*/,
+    std::span<const double> x_gem, std::span<const double> y_gem, std::span<const double> t_gem, const unsigned int side,
+    PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/)
+{
+  // the electrons are processed in order, the gain random numbers are the same as one electron at a time.
+  // The charge goes to the dense buffers, which are copied to the hitsets by FillHitSets
+  m_single_hits.clear();
+  for (std::size_t ie = 0; ie < x_gem.size(); ++ie)
   {
-    phi += 2 * M_PI;
+    if (!amplify_electron(x_gem[ie], y_gem[ie], t_gem[ie], side, hiter))
+    {
+      continue;
+    }
+
+    distribute_charge(tpc_truth_clusterer, side, t_gem[ie],
+                      [&](TrkrDefs::hitsetkey hitsetkey, TrkrDefs::hitkey hitkey, unsigned int sector, int pad_num, int tbin_num, float neffelectrons, bool masked)
+                      {
+                        if (!add_dense_energy(sector, side, pad_num, tbin_num, neffelectrons, masked))
+                        {
+                          // not covered by the dense buffers, use the hitset container
+                          TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
+                          if (masked)
+                          {
+                            return;
+                          }
+                          add_energy(hitsetit->second, hitkey, neffelectrons);
+                        }
+                        if (!masked)
+                        {
+                          m_single_hits.push_back({hitsetkey, hitkey, neffelectrons});
+                        }
+                      });
+
+    m_NHits++;
   }
 
-  double rad_gem = get_r(x_gem, y_gem);
+  // hits of this g4hit, one lookup per hit instead of one per contribution
+  std::sort(m_single_hits.begin(), m_single_hits.end(), [](const SingleHit &lhs, const SingleHit &rhs)
+            { return std::tie(lhs.hitsetkey, lhs.hitkey) < std::tie(rhs.hitsetkey, rhs.hitkey); });
+  TrkrHitSetContainer::Iterator single_hitsetit;
+  TrkrHit *single_hit = nullptr;
+  for (std::size_t i = 0; i < m_single_hits.size(); ++i)
+  {
+    const auto &contribution = m_single_hits[i];
+    if (i == 0 || contribution.hitsetkey != m_single_hits[i - 1].hitsetkey)
+    {
+      single_hitsetit = single_hitsetcontainer->findOrAddHitSet(contribution.hitsetkey);
+      single_hit = nullptr;
+    }
+    if (!single_hit || contribution.hitkey != m_single_hits[i - 1].hitkey)
+    {
+      single_hit = single_hitsetit->second->getHit(contribution.hitkey);
+      if (!single_hit)
+      {
+        single_hit = new TrkrHitv2();
+        single_hitsetit->second->addHitSpecificKey(contribution.hitkey, single_hit);
+      }
+    }
+    single_hit->addEnergy(contribution.neffelectrons);
+  }
+}
 
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::FillHitSets(TrkrHitSetContainer *hitsetcontainer)
+{
+  for (const unsigned int index : m_dense_used)
+  {
+    auto &dense = m_dense_hitsets[index];
+    const unsigned int sector = index % NSectors;
+    const unsigned int side = (index / NSectors) % NSides;
+    const unsigned int layer = index / (NSectors * NSides);
+    const TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
+    TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
+    for (std::size_t itile = 0; itile < dense.tiles.size(); ++itile)
+    {
+      auto &tile = dense.tiles[itile];
+      if (tile.empty())
+      {
+        continue;
+      }
+      for (unsigned int ipad = 0; ipad < dense.npads; ++ipad)
+      {
+        for (unsigned int it = 0; it < dense_tile_tbins; ++it)
+        {
+          auto &value = tile[ipad * dense_tile_tbins + it];
+          if (value == 0)
+          {
+            continue;
+          }
+          const TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(sector * dense.npads + ipad, itile * dense_tile_tbins + it);
+          TrkrHit *hit = hitsetit->second->getHit(hitkey);
+          if (!hit)
+          {
+            hit = new TrkrHitv2();
+            hitsetit->second->addHitSpecificKey(hitkey, hit);
+          }
+          // adc values are exact multiples of the energy scale
+          hit->addEnergy((value - 1) / TrkrDefs::EdepScaleFactor);
+          value = 0;
+        }
+      }
+    }
+    dense.used = false;
+  }
+  m_dense_used.clear();
+}
+
+//_________________________________________________________
+double PHG4TpcPadPlaneReadout::move_from_dead_area(double rad_gem) const
+{
   // Moving electrons from dead area to a closest pad
   for (int iregion = 0; iregion < 3; ++iregion)
   {
@@ -344,51 +497,144 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
       }
     }
   }
+  return rad_gem;
+}
 
-  unsigned int layernum = 0;
-  /* TpcClusterBuilder pass_data {}; */
-
-  // Find which readout layer this electron ends up in
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::make_layer_lookup()
+{
+  m_lookup_layers.clear();
+  m_layer_lookup.clear();
+  LayerGeom = nullptr;
 
+  unsigned int max_layer = 0;
   PHG4TpcGeomContainer::ConstRange layerrange = GeomContainer->get_begin_end();
   for (PHG4TpcGeomContainer::ConstIterator layeriter = layerrange.first;
        layeriter != layerrange.second;
        ++layeriter)
   {
-    double rad_low = layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0;
-    double rad_high = layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0;
+    const double rad_low = layeriter->second->get_radius() - layeriter->second->get_thickness() / 2.0;
+    const double rad_high = layeriter->second->get_radius() + layeriter->second->get_thickness() / 2.0;
+    m_lookup_layers.push_back({layeriter->second, rad_low, rad_high});
+    max_layer = std::max<unsigned int>(max_layer, layeriter->second->get_layer());
+  }
+  if (m_lookup_layers.empty())
+  {
+    return;
+  }
 
-    if (rad_gem > rad_low && rad_gem < rad_high)
-    {
-      // capture the layer where this electron hits the gem stack
-      LayerGeom = layeriter->second;
+  m_lookup_rmin = m_lookup_layers.front().rad_low;
+  m_lookup_rmax = m_lookup_layers.front().rad_high;
+  for (const auto &layer : m_lookup_layers)
+  {
+    m_lookup_rmin = std::min(m_lookup_rmin, layer.rad_low);
+    m_lookup_rmax = std::max(m_lookup_rmax, layer.rad_high);
+  }
 
-      layernum = LayerGeom->get_layer();
-      /* pass_data.layerGeom = LayerGeom; */
-      /* pass_data.layer = layernum; */
-      if (Verbosity() > 1000)
+  // candidate layers per radius bin, with one bin margin on each side against rounding
+  const auto nbins = static_cast<std::size_t>(std::ceil((m_lookup_rmax - m_lookup_rmin) / layer_lookup_step)) + 1;
+  m_layer_lookup.assign(nbins, {0, 0});
+  for (std::size_t bin = 0; bin < nbins; ++bin)
+  {
+    const double low = m_lookup_rmin + (bin - 1.) * layer_lookup_step;
+    const double high = m_lookup_rmin + (bin + 2.) * layer_lookup_step;
+    unsigned int first = m_lookup_layers.size();
+    unsigned int last = 0;
+    for (unsigned int ilayer = 0; ilayer < m_lookup_layers.size(); ++ilayer)
+    {
+      if (m_lookup_layers[ilayer].rad_low < high && m_lookup_layers[ilayer].rad_high > low)
       {
-        std::cout << " g4hit id " << hiter->first << " rad_gem " << rad_gem << " rad_low " << rad_low << " rad_high " << rad_high
-                  << " layer  " << hiter->second->get_layer() << " want to change to " << layernum << std::endl;
+        first = std::min(first, ilayer);
+        last = ilayer + 1;
       }
-      hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
+    }
+    if (last > first)
+    {
+      m_layer_lookup[bin] = {first, last};
     }
   }
 
-  if (layernum == 0)
+  // dense charge buffers, the tiles are allocated on first use
+  m_dense_hitsets.clear();
+  m_dense_hitsets.resize((max_layer + 1) * NSides * NSectors);
+  m_dense_used.clear();
+  for (const auto &layer : m_lookup_layers)
   {
-    return;
+    const unsigned int npads = layer.geom->get_phibins() / NSectors;
+    const unsigned int ntiles = (layer.geom->get_zbins() + dense_tile_tbins - 1) / dense_tile_tbins;
+    const unsigned int first = layer.geom->get_layer() * NSides * NSectors;
+    for (unsigned int index = first; index < first + NSides * NSectors; ++index)
+    {
+      m_dense_hitsets[index].npads = npads;
+      m_dense_hitsets[index].tiles.resize(ntiles);
+    }
   }
+}
 
-  // store phi bins and tbins upfront to avoid repetitive checks on the phi methods
-  const auto phibins = LayerGeom->get_phibins();
-  /* pass_data.nphibins = phibins; */
-
-  const auto tbins = LayerGeom->get_zbins();
+//_________________________________________________________
+PHG4TpcGeom *PHG4TpcPadPlaneReadout::find_layer(double rad_gem) const
+{
+  if (!(rad_gem > m_lookup_rmin && rad_gem < m_lookup_rmax))
+  {
+    return nullptr;
+  }
+  const auto bin = std::min(static_cast<std::size_t>((rad_gem - m_lookup_rmin) / layer_lookup_step), m_layer_lookup.size() - 1);
+  PHG4TpcGeom *geom = nullptr;
+  for (unsigned int ilayer = m_layer_lookup[bin].first; ilayer < m_layer_lookup[bin].second; ++ilayer)
+  {
+    const auto &layer = m_lookup_layers[ilayer];
+    if (rad_gem > layer.rad_low && rad_gem < layer.rad_high)
+    {
+      geom = layer.geom;
+    }
+  }
+  return geom;
+}
 
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::set_layer_geometry(PHG4TpcGeom *layergeom)
+{
+  if (layergeom == LayerGeom)
+  {
+    return;
+  }
+  LayerGeom = layergeom;
   sector_min_Phi = LayerGeom->get_sector_min_phi();
   sector_max_Phi = LayerGeom->get_sector_max_phi();
   phi_bin_width = LayerGeom->get_phistep();
+}
+
+//_________________________________________________________
+bool PHG4TpcPadPlaneReadout::amplify_electron(const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter)
+{
+  double phi = atan2(y_gem, x_gem);
+  if (phi > +M_PI)
+  {
+    phi -= 2 * M_PI;
+  }
+  if (phi < -M_PI)
+  {
+    phi += 2 * M_PI;
+  }
+
+  const double rad_gem = move_from_dead_area(get_r(x_gem, y_gem));
+
+  // Find which readout layer this electron ends up in
+  PHG4TpcGeom *layergeom = find_layer(rad_gem);
+  if (!layergeom || layergeom->get_layer() == 0)
+  {
+    return false;
+  }
+
+  // capture the layer where this electron hits the gem stack
+  set_layer_geometry(layergeom);
+  const unsigned int layernum = LayerGeom->get_layer();
+  if (Verbosity() > 1000)
+  {
+    std::cout << " g4hit id " << hiter->first << " rad_gem " << rad_gem
+              << " layer  " << hiter->second->get_layer() << " want to change to " << layernum << std::endl;
+  }
+  hiter->second->set_layer(layernum);  // have to set here, since the stepping action knows nothing about layers
 
   phi = check_phi(side, phi, rad_gem);
 
@@ -474,16 +720,24 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
     }
     if (this_region > -1)
     {
-      nelec = getSingleEGEMAmplification(flangau[side][this_region][sector]);
+      if (m_use_block_random && m_langau_cdf[side][this_region][sector].valid())
+      {
+        nelec = getSingleEGEMAmplification(m_langau_cdf[side][this_region][sector]);
+      }
+      else
+      {
+        nelec = getSingleEGEMAmplification(flangau[side][this_region][sector]);
+      }
     }
     else
     {
       nelec = getSingleEGEMAmplification();
     }
   }
+  m_nelec = nelec;
+  m_phi = phi;
 
   // std::cout<<"PHG4TpcPadPlaneReadout::MapToPadPlane gain_weight = "<<gain_weight<<std::endl;
-  /* pass_data.neff_electrons = nelec; */
 
   // Distribute the charge between the pads in phi
   //====================================
@@ -498,26 +752,20 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
               << std::endl;
   }
 
-  std::vector<int> pad_phibin;
-  std::vector<double> pad_phibin_share;
-
-  populate_zigzag_phibins(side, layernum, phi, sigmaT, pad_phibin, pad_phibin_share);
-  /* if (pad_phibin.size() == 0) { */
-  /* pass_data.neff_electrons = 0; */
-  /* } else { */
-  /* pass_data.fillPhiBins(pad_phibin); */
-  /* } */
+  m_pad_phibin.clear();
+  m_pad_phibin_share.clear();
+  populate_zigzag_phibins(side, layernum, phi, sigmaT, m_pad_phibin, m_pad_phibin_share);
 
   // Normalize the shares so they add up to 1
   double norm1 = 0.0;
-  for (unsigned int ipad = 0; ipad < pad_phibin.size(); ++ipad)
+  for (unsigned int ipad = 0; ipad < m_pad_phibin.size(); ++ipad)
   {
-    double pad_share = pad_phibin_share[ipad];
+    double pad_share = m_pad_phibin_share[ipad];
     norm1 += pad_share;
   }
-  for (unsigned int iphi = 0; iphi < pad_phibin.size(); ++iphi)
+  for (unsigned int iphi = 0; iphi < m_pad_phibin.size(); ++iphi)
   {
-    pad_phibin_share[iphi] /= norm1;
+    m_pad_phibin_share[iphi] /= norm1;
   }
 
   // Distribute the charge between the pads in t
@@ -528,39 +776,34 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
 		<< " with t_gem " << t_gem << " SAMPA peaking time  " << Ts << std::endl;
     }
 
-  std::vector<int> adc_tbin;
-  std::vector<double> adc_tbin_share;
-  sampaTimeDistribution(t_gem, adc_tbin, adc_tbin_share);
-
-  /* if (adc_tbin.size() == 0)  { */
-  /* pass_data.neff_electrons = 0; */
-  /* } else { */
-  /* pass_data.fillTimeBins(adc_tbin); */
-  /* } */
+  m_adc_tbin.clear();
+  m_adc_tbin_share.clear();
+  sampaTimeDistribution(t_gem, m_adc_tbin, m_adc_tbin_share);
 
   // Normalize the shares so that they add up to 1
   double tnorm = 0.0;
-  for (unsigned int it = 0; it < adc_tbin.size(); ++it)
+  for (unsigned int it = 0; it < m_adc_tbin.size(); ++it)
   {
-    double bin_share = adc_tbin_share[it];
+    double bin_share = m_adc_tbin_share[it];
     tnorm += bin_share;
   }
-  for (unsigned int it = 0; it < adc_tbin.size(); ++it)
+  for (unsigned int it = 0; it < m_adc_tbin.size(); ++it)
   {
-    adc_tbin_share[it] /= tnorm;
+    m_adc_tbin_share[it] /= tnorm;
   }
 
-  /*
-  if(layernum == print_layer)
-    {
-      std::cout << "t_gem " << t_gem << std::endl;
-      for (unsigned int it = 0; it < adc_tbin.size(); ++it)
-	{
-	  std::cout << " tbin " << adc_tbin[it] << " share " << adc_tbin_share[it] << std::endl;
-	}
-    }
-  */
-  
+  return true;
+}
+
+//_________________________________________________________
+template <class AddHit>
+void PHG4TpcPadPlaneReadout::distribute_charge(TpcClusterBuilder &tpc_truth_clusterer, const unsigned int side, const double t_gem, AddHit &&add_hit)
+{
+  // store phi bins and tbins upfront to avoid repetitive checks on the phi methods
+  const auto phibins = LayerGeom->get_phibins();
+  const auto tbins = LayerGeom->get_zbins();
+  const unsigned int layernum = LayerGeom->get_layer();
+
   // Fill HitSetContainer
   //===============
   // These are used to do a quick clustering for checking
@@ -568,18 +811,18 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
   double t_integral = 0.0;
   double weight = 0.0;
 
-  for (unsigned int ipad = 0; ipad < pad_phibin.size(); ++ipad)
+  for (unsigned int ipad = 0; ipad < m_pad_phibin.size(); ++ipad)
   {
-    int pad_num = pad_phibin[ipad];
-    double pad_share = pad_phibin_share[ipad];
+    int pad_num = m_pad_phibin[ipad];
+    double pad_share = m_pad_phibin_share[ipad];
 
-    for (unsigned int it = 0; it < adc_tbin.size(); ++it)
+    for (unsigned int it = 0; it < m_adc_tbin.size(); ++it)
     {
-      int tbin_num = adc_tbin[it];
-      double adc_bin_share = adc_tbin_share[it];
+      int tbin_num = m_adc_tbin[it];
+      double adc_bin_share = m_adc_tbin_share[it];
 
       // Divide electrons from avalanche between bins
-      float neffelectrons = nelec * (pad_share) * (adc_bin_share);
+      float neffelectrons = m_nelec * (pad_share) * (adc_bin_share);
       if (neffelectrons < neffelectrons_threshold)
       {
         continue;  // skip signals that will be below the noise suppression threshold
@@ -608,114 +851,111 @@ void PHG4TpcPadPlaneReadout::MapToPadPlane(
                   << " neffelectrons " << neffelectrons << " neffelectrons_threshold " << neffelectrons_threshold << std::endl;
       }
 
-      // new containers
-      //============
-      // We add the Tpc TrkrHitsets directly to the node using hitsetcontainer
-      // We need to create the TrkrHitSet if not already made - each TrkrHitSet should correspond to a Tpc readout module
       // The hitset key includes the layer, sector, side
-
       // The side is an input parameter
 
       // get the Tpc readout sector - there are 12 sectors with how many pads each?
       unsigned int pads_per_sector = phibins / 12;
       unsigned int sector = pad_num / pads_per_sector;
       TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layernum, sector, side);
-      // Use existing hitset or add new one if needed
-      TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
-      TrkrHitSetContainer::Iterator single_hitsetit = single_hitsetcontainer->findOrAddHitSet(hitsetkey);
-      TrkrDefs::hitkey hitkey;
-
-      if (m_maskDeadChannels)
-      {
-        hitkey = TpcDefs::genHitKey((unsigned int) pad_num, 0);
-        if (m_deadChannelMap.contains(hitsetkey) &&
-            std::find(m_deadChannelMap[hitsetkey].begin(), m_deadChannelMap[hitsetkey].end(), hitkey) != m_deadChannelMap[hitsetkey].end())
-        {
-          continue;
-        }
-      }
-      if (m_maskHotChannels)
-      {
-        hitkey = TpcDefs::genHitKey((unsigned int) pad_num, 0);
-        if (m_hotChannelMap.contains(hitsetkey) &&
-            std::find(m_hotChannelMap[hitsetkey].begin(), m_hotChannelMap[hitsetkey].end(), hitkey) != m_hotChannelMap[hitsetkey].end())
-        {
-          continue;
-        }
-      }
-      // generate the key for this hit, requires tbin and phibin
-      hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
-
-      // See if this hit already exists
-      TrkrHit *hit = nullptr;
-      hit = hitsetit->second->getHit(hitkey);
-      if (!hit)
-      {
-        // create a new one
-        hit = new TrkrHitv2();
-        hitsetit->second->addHitSpecificKey(hitkey, hit);
-      }
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      hit->addEnergy(neffelectrons);
 
-      tpc_truth_clusterer.addhitset(hitsetkey, hitkey, neffelectrons);
+      const bool masked = is_masked(m_deadChannelMap, m_maskDeadChannels, hitsetkey, pad_num) ||
+                          is_masked(m_hotChannelMap, m_maskHotChannels, hitsetkey, pad_num);
 
-      // repeat for the single_hitsetcontainer
-      // See if this hit already exists
-      TrkrHit *single_hit = nullptr;
-      single_hit = single_hitsetit->second->getHit(hitkey);
-      if (!single_hit)
-      {
-        // create a new one
-        single_hit = new TrkrHitv2();
-        single_hitsetit->second->addHitSpecificKey(hitkey, single_hit);
-      }
-      // Either way, add the energy to it  -- adc values will be added at digitization
-      single_hit->addEnergy(neffelectrons);
+      // generate the key for this hit, requires tbin and phibin
+      TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, (unsigned int) tbin_num);
 
-      /*
-      if (Verbosity() > 0)
+      // adc values will be added at digitization
+      add_hit(hitsetkey, hitkey, sector, pad_num, tbin_num, neffelectrons, masked);
+      if (!masked)
       {
-        assert(nthit);
-        nthit->Fill(layernum, pad_num, tbin_num, neffelectrons);
+        tpc_truth_clusterer.addhitset(hitsetkey, hitkey, neffelectrons);
       }
-      */
-
     }  // end of loop over adc T bins
   }  // end of loop over zigzag pads
-  /* pass_data.phi_integral = phi_integral; */
-  /* pass_data.time_integral = t_integral; */
-
-  /*
-  // Capture the input values at the gem stack and the quick clustering results, elecron-by-electron
-  if (Verbosity() > 0)
-  {
-    assert(ntpad);
-    ntpad->Fill(layernum, phi, phi_integral / weight, t_gem, t_integral / weight);
-  }
-  */
 
   if (Verbosity() > 100)
   {
     if (layernum == print_layer)
     {
       std::cout << " hit " << m_NHits << " quick centroid for this electron " << std::endl;
-      std::cout << "      phi centroid = " << phi_integral / weight << " phi in " << phi << " phi diff " << phi_integral / weight - phi << std::endl;
+      std::cout << "      phi centroid = " << phi_integral / weight << " phi in " << m_phi << " phi diff " << phi_integral / weight - m_phi << std::endl;
       std::cout << "      t centroid = " << t_integral / weight << " t in " << t_gem << " t diff " << t_integral / weight - t_gem << std::endl;
       // For a single track event, this captures the distribution of single electron centroids on the pad plane for layer print_layer.
       // The centroid of that should match the cluster centroid found by PHG4TpcClusterizer for layer print_layer, if everything is working
       //   - matches to < .01 cm for a few cases that I checked
-
-      /*
-      assert(nthit);
-      nthit->Fill(hit, layernum, phi, phi_integral / weight, t_gem, t_integral / weight, weight);
-      */
     }
   }
+}
 
-  m_NHits++;
-  /* return pass_data; */
+//_________________________________________________________
+bool PHG4TpcPadPlaneReadout::is_masked(hitMaskTpc &mask, bool use_mask, TrkrDefs::hitsetkey hitsetkey, int pad_num)
+{
+  if (!use_mask)
+  {
+    return false;
+  }
+  const TrkrDefs::hitkey hitkey = TpcDefs::genHitKey((unsigned int) pad_num, 0);
+  auto iter = mask.find(hitsetkey);
+  return iter != mask.end() && std::find(iter->second.begin(), iter->second.end(), hitkey) != iter->second.end();
 }
+
+//_________________________________________________________
+void PHG4TpcPadPlaneReadout::add_energy(TrkrHitSet *hitset, TrkrDefs::hitkey hitkey, float neffelectrons)
+{
+  // See if this hit already exists
+  TrkrHit *hit = hitset->getHit(hitkey);
+  if (!hit)
+  {
+    // create a new one
+    hit = new TrkrHitv2();
+    hitset->addHitSpecificKey(hitkey, hit);
+  }
+  // Either way, add the energy to it
+  hit->addEnergy(neffelectrons);
+}
+
+//_________________________________________________________
+bool PHG4TpcPadPlaneReadout::add_dense_energy(unsigned int sector, unsigned int side, int pad_num, int tbin_num, float neffelectrons, bool masked)
+{
+  const std::size_t index = (static_cast<std::size_t>(LayerGeom->get_layer()) * NSides + side) * NSectors + sector;
+  if (sector >= NSectors || index >= m_dense_hitsets.size())
+  {
+    return false;
+  }
+  auto &dense = m_dense_hitsets[index];
+  const int pad = pad_num - static_cast<int>(sector * dense.npads);
+  const unsigned int itile = tbin_num / dense_tile_tbins;
+  if (pad < 0 || pad >= static_cast<int>(dense.npads) || tbin_num < 0 || itile >= dense.tiles.size())
+  {
+    return false;
+  }
+
+  // the hitset exists even if all its channels are masked, as with the hitset containers
+  if (!dense.used)
+  {
+    dense.used = true;
+    m_dense_used.push_back(index);
+  }
+  if (masked)
+  {
+    return true;
+  }
+
+  auto &tile = dense.tiles[itile];
+  if (tile.empty())
+  {
+    tile.assign(dense.npads * dense_tile_tbins, 0);
+  }
+
+  // same rounding and saturation as TrkrHitv2::addEnergy, the value is adc+1 (0 for no hit)
+  auto &value = tile[pad * dense_tile_tbins + tbin_num % dense_tile_tbins];
+  const double adc = value == 0 ? 0 : value - 1;
+  const double ein = neffelectrons * TrkrDefs::EdepScaleFactor;
+  value = 1 + ((adc + ein > USHRT_MAX) ? USHRT_MAX : static_cast<unsigned int>(adc) + static_cast<unsigned short>(ein));
+  return true;
+}
+
 double PHG4TpcPadPlaneReadout::check_phi(const unsigned int side, const double phi, const double radius)
 {
   double new_phi = phi;
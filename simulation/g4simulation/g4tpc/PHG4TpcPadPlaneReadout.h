@@ -1,6 +1,7 @@
 #ifndef G4TPC_PHG4TPCPADPLANEREADOUT_H
 #define G4TPC_PHG4TPCPADPLANEREADOUT_H
 
+#include "PHG4TpcBlockRandom.h"
 #include "PHG4TpcPadPlane.h"
 #include "TpcClusterBuilder.h"
 
@@ -8,10 +9,15 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <trackbase/TrkrDefs.h>
+
 #include <array>
 #include <climits>
 #include <cmath>
+#include <cstdint>
+#include <span>
 #include <string>  // for string
+#include <utility>
 #include <vector>
 #include <map>
 
@@ -23,6 +29,7 @@ class PHG4TpcGeom;
 class TH2;
 class TF1;
 class TNtuple;
+class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrHitTruthAssoc;
 
@@ -43,11 +50,19 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   void SetUseLangauGEMGain(const int flagLangau) { m_useLangau = flagLangau; }
   void SetLangauParsFileName(const std::string &name) { m_tpc_langau_pars_file = name; }
 
+  void UseBlockRandom(bool flag) override { m_use_block_random = flag; }
+  void SetRandomStream(unsigned int event, PHG4HitDefs::keytype hitid) override { m_block_random.set_stream(event, hitid); }
+
   // otherwise warning of inconsistent overload since only one MapToPadPlane methow is overridden
   using PHG4TpcPadPlane::MapToPadPlane;
 
   void MapToPadPlane(TpcClusterBuilder &tpc_truth_clusterer, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
 
+  //! block of electrons, the charge is accumulated in dense pad x time bin buffers until FillHitSets
+  void MapToPadPlane(TpcClusterBuilder &tpc_truth_clusterer, TrkrHitSetContainer *single_hitsetcontainer, TrkrHitSetContainer *hitsetcontainer, TrkrHitTruthAssoc * /*hittruthassoc*/, std::span<const double> x_gem, std::span<const double> y_gem, std::span<const double> t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter, TNtuple * /*ntpad*/, TNtuple * /*nthit*/) override;
+
+  void FillHitSets(TrkrHitSetContainer *hitsetcontainer) override;
+
   void SetDefaultParameters() override;
   void UpdateInternalParameters() override;
  
@@ -77,6 +92,30 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   void makeChannelMask(hitMaskTpc& aMask, const std::string& dbName, const std::string& totalChannelsToMask);
 
+  //! gain and pad/time bin shares of one electron, false if it does not reach a readout layer
+  bool amplify_electron(const double x_gem, const double y_gem, const double t_gem, const unsigned int side, PHG4HitContainer::ConstIterator hiter);
+
+  //! split the charge of the last amplified electron between pads and time bins, add_hit stores each contribution
+  template <class AddHit>
+  void distribute_charge(TpcClusterBuilder &tpc_truth_clusterer, const unsigned int side, const double t_gem, AddHit &&add_hit);
+
+  double move_from_dead_area(double rad_gem) const;
+
+  //! radius to layer lookup table and dense buffers, made from the geometry at InitRun
+  void make_layer_lookup();
+
+  //! readout layer of an electron at the gem, nullptr if it falls between layers
+  PHG4TpcGeom *find_layer(double rad_gem) const;
+
+  //! set LayerGeom and the sector boundaries, only when the layer changes
+  void set_layer_geometry(PHG4TpcGeom *layergeom);
+
+  static bool is_masked(hitMaskTpc &mask, bool use_mask, TrkrDefs::hitsetkey hitsetkey, int pad_num);
+  static void add_energy(TrkrHitSet *hitset, TrkrDefs::hitkey hitkey, float neffelectrons);
+
+  //! add a contribution to the dense buffers, false if the bin is not covered
+  bool add_dense_energy(unsigned int sector, unsigned int side, int pad_num, int tbin_num, float neffelectrons, bool masked);
+
   PHG4TpcGeomContainer *GeomContainer = nullptr;
   PHG4TpcGeom *LayerGeom = nullptr;
 
@@ -114,10 +153,53 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
   std::array<std::vector<double>, NSides> sector_min_Phi;
   std::array<std::vector<double>, NSides> sector_max_Phi;
 
+  // last amplified electron
+  double m_nelec{0};
+  double m_phi{0};
+  std::vector<int> m_pad_phibin;
+  std::vector<double> m_pad_phibin_share;
+  std::vector<int> m_adc_tbin;
+  std::vector<double> m_adc_tbin_share;
+
+  // readout layers ordered as in the geometry container, with the candidate layers per radius bin
+  struct LookupLayer
+  {
+    PHG4TpcGeom *geom{nullptr};
+    double rad_low{0};
+    double rad_high{0};
+  };
+  std::vector<LookupLayer> m_lookup_layers;
+  std::vector<std::pair<unsigned int, unsigned int>> m_layer_lookup;
+  double m_lookup_rmin{0};
+  double m_lookup_rmax{0};
+
+  // charge of one hitset, pads x time bins in tiles of time bins allocated on first use.
+  // Values are adc+1, 0 marks bins without hit
+  static constexpr unsigned int dense_tile_tbins{64};
+  struct DenseHitSet
+  {
+    unsigned int npads{0};
+    bool used{false};
+    std::vector<std::vector<uint32_t>> tiles;
+  };
+  // index is (layer * NSides + side) * NSectors + sector
+  std::vector<DenseHitSet> m_dense_hitsets;
+  std::vector<unsigned int> m_dense_used;
+
+  // contributions of the current g4hit, for the single hitset container
+  struct SingleHit
+  {
+    TrkrDefs::hitsetkey hitsetkey{0};
+    TrkrDefs::hitkey hitkey{0};
+    float neffelectrons{0};
+  };
+  std::vector<SingleHit> m_single_hits;
+
   // return random distribution of number of electrons after amplification of GEM for each initial ionizing electron
   double getSingleEGEMAmplification();
   double getSingleEGEMAmplification(double weight);
   static double getSingleEGEMAmplification(TF1 *f);
+  double getSingleEGEMAmplification(const PHG4TpcBlockRandom::InverseCdf &cdf);
   bool m_usePolya {false};
 
   bool m_useLangau {false};
@@ -125,6 +207,10 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   gsl_rng *RandomGenerator {nullptr};
 
+  // counter based random numbers, reproducible per g4hit
+  bool m_use_block_random {false};
+  PHG4TpcBlockRandom m_block_random;
+
   std::array<TH2 *, 2> h_gain{nullptr};
 
   double m_module_gain_weight[2][3][12] {
@@ -137,6 +223,9 @@ class PHG4TpcPadPlaneReadout : public PHG4TpcPadPlane
 
   TF1 *flangau[2][3][12] {{{nullptr}}};
 
+  // tabulated inverse cumulative distributions of flangau, used with the block random numbers
+  PHG4TpcBlockRandom::InverseCdf m_langau_cdf[2][3][12];
+
   hitMaskTpc m_deadChannelMap;
   hitMaskTpc m_hotChannelMap; 
 